@@ -6,43 +6,118 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <filesystem>
 
 // local
+#include <Syncorder/gonfig/gonfig.h>
 #include <Syncorder/error/exception.h>
 #include <Syncorder/devices/common/broker_base.h>
+#include <Syncorder/devices/common/csv_writer.h>
+#include <Syncorder/devices/common/container.h>
 #include <Syncorder/devices/camera/model.h>
+#include <Syncorder/devices/camera/record.h>
+#include <Syncorder/devices/camera/buffer.cpp>
 
 
 /**
  * @class Broker
+ *
+ * gonfig.container writes CameraRecord rows to the "camera" channel of the
+ * shared session container instead of camera_data.csv.
+ *
+ * Every record carries the callback's host monotonic time and the MF
+ * timestamp aligned to that clock by clock_ (ClockAligner).
  */
 
-class CameraBroker : public TBBroker<CameraBufferData> {
+class CameraBroker : public TBBroker<CameraBufferData, CameraBuffer> {
 private:
-    std::ofstream csv_;
+    CsvWriter csv_;
+
+    // capture ticks -> host / wall ns, taken once per batch
+    TimestampMapping stamps_;
+
+    // container
+    std::shared_ptr<ContainerWriter> container_;
+    std::uint16_t channel_ = 0;
+    std::vector<CameraRecord> records_;
+    std::vector<std::int64_t> times_;
+    std::uint64_t container_bytes_ = 0;
+    std::uint64_t container_stall_ns_ = 0;
 
 public:
     CameraBroker() {
-        csv_.open("camera_data.csv");
-        csv_<< "system_time,media_foundation_timestamp\n";
+        clock_.configure(gonfig.clock_window_s, gonfig.clock_gate);
+
+        FileWriterOptions writer = makeWriterOptions(gonfig.writer, gonfig.writer_direct, gonfig.writer_block_kb, gonfig.writer_blocks, gonfig.segment_mb, gonfig.segment_seconds);
+
+        if (gonfig.container) {
+            container_ = ContainerWriter::shared(gonfig.output_path + "session.scap", writer, gonfig.container_chunk_kb * 1024, gonfig.container_compress);
+            if (!container_) throw CameraDeviceError("cannot open " + gonfig.output_path + "session.scap");
+            channel_ = container_->addChannel<CameraRecord>();
+            records_.reserve(BROKER_BATCH_SIZE);
+            times_.reserve(BROKER_BATCH_SIZE);
+            return;
+        }
+
+        std::string output = gonfig.output_path + "camera/";
+        std::filesystem::create_directories(output);
+
+        if (!csv_.open(output + "camera_data.csv", writer)) throw CameraDeviceError("cannot open " + output + "camera_data.csv");
+        csv_.text("system_time,media_foundation_timestamp,host_time_ns,aligned_time_ns\n");
+        csv_.flush();
     }
     ~CameraBroker() {}
 
 protected:
     void _process(const CameraBufferData& data) override {
-        _write(data);
+        _process_batch(&data, 1);
+    }
+
+    void _process_batch(const CameraBufferData* data, std::size_t count) override {
+        stamps_ = timestamps().mapping();
 
-        std::cout << "[CameraBroker] Processing timestamp\n";
+        if (container_) {
+            records_.clear();
+            times_.clear();
+            for (std::size_t i = 0; i < count; ++i) {
+                records_.push_back(_record(data[i]));
+                times_.push_back(stamps_.wallNs(data[i].capture_ticks_));
+            }
+            container_stall_ns_ += container_->writeRecords(channel_, times_.data(), records_.data(), count);
+            container_bytes_ += count * (sizeof(MessageHeader) + sizeof(CameraRecord));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) _write(_record(data[i]));
+            csv_.flush();
+        }
+
+        std::cout << "[CameraBroker] Processing " << count << " timestamp(s)\n";
+    }
+
+    std::uint64_t _written() override {
+        return container_ ? container_bytes_ : csv_.bytes();
+    }
+
+    std::uint64_t _stalled() override {
+        return container_ ? container_stall_ns_ : csv_.stallNs();
     }
 
 private:
-    void _write(const CameraBufferData& data) {
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            data.sys_time_.time_since_epoch()
-        ).count();
-       
-        csv_ 
-        << ms << ","
-        << data.mf_ts_ << "\n";
+    CameraRecord _record(const CameraBufferData& data) {
+        CameraRecord record;
+        record.system_time_ms = stamps_.wallNs(data.capture_ticks_) / 1000000;
+        record.media_foundation_timestamp = data.mf_ts_;
+
+        // 100 ns units -> host monotonic ns
+        record.host_time_ns = stamps_.hostNs(data.capture_ticks_);
+        record.aligned_time_ns = clock_.align(data.mf_ts_ * 100, record.host_time_ns);
+        return record;
+    }
+
+    void _write(const CameraRecord& record) {
+        csv_
+            .integer(record.system_time_ms).put(',')
+            .integer(record.media_foundation_timestamp).put(',')
+            .integer(record.host_time_ns).put(',')
+            .integer(record.aligned_time_ns).put('\n');
     }
 };
\ No newline at end of file
@@ -26,16 +26,4 @@ constexpr std::size_t CAMERA_RING_BUFFER_SIZE = 1024;
 class CameraBuffer 
 :
     public BBuffer<CameraBufferData, CAMERA_RING_BUFFER_SIZE> 
-{
-public:
-    static void* dequeue(void* instance) {
-        auto* buffer = static_cast<CameraBuffer*>(instance);        
-        auto result = buffer->_dequeue();
-        if (!result.has_value()) return nullptr;
-
-        return new CameraBufferData(std::move(result.value()));
-    }
-    
-protected:
-    void onOverflow() noexcept override { std::cout << "[CameraBuffer Warning] Buffer overflow\n"; }
-};
\ No newline at end of file
+{};
\ No newline at end of file
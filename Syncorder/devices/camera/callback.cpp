@@ -71,14 +71,18 @@ public:
 
 public:
     HRESULT STDMETHODCALLTYPE OnReadSample(HRESULT hr, DWORD, DWORD, LONGLONG timestamp, IMFSample* sample) override {
+        std::int64_t entry_ns = traceNow();
+
         // flag
         if (!first_frame_received_.load()) first_frame_received_.store(true);
 
         // data
         if (buffer_ && sample) {
             CameraBufferData data = _map(sample, timestamp);
+            data.traceCallback(entry_ns);
 
             auto* cam_buffer = static_cast<CameraBuffer*>(buffer_);
+            data.traceEnqueue();
             cam_buffer->enqueue(std::move(data));
         }
         
@@ -95,7 +99,7 @@ private:
     CameraBufferData _map(IMFSample* sample, LONGLONG ts) {
         return CameraBufferData(
             ComPtr<IMFSample>(sample),
-            std::chrono::system_clock::now(),
+            timestamps().now(),
             ts
         );
     }
@@ -1,6 +1,8 @@
 // local
+#include <Syncorder/gonfig/gonfig.h>
 #include <Syncorder/error/exception.h>
 #include <Syncorder/devices/common/manager_base.h>
+#include <Syncorder/devices/common/executor.h>
 #include <Syncorder/devices/camera/device.cpp>
 #include <Syncorder/devices/camera/callback.cpp>
 #include <Syncorder/devices/camera/buffer.cpp>
@@ -31,16 +33,23 @@ public:
         }
 
 public:
-    bool setup() override {
+    bool setup(const CancelToken& token) override {
         // device
         device_->pre_setup(callback_->getIUnknown());
         device_->setup();
+        if (token.cancelled()) return false;
         
         // callback
         callback_->setup(device_->getReader(), static_cast<void*>(buffer_.get()));
 
+        // buffer
+        buffer_->setOverflowPolicy(parseOverflowPolicy(gonfig.overflow_policy), gonfig.output_path + "camera/overflow.spill");
+        buffer_->setBlockTimeout(std::chrono::microseconds(gonfig.overflow_block_us));
+
         // broker
-        broker_->setup(buffer_.get(), reinterpret_cast<void*>(&CameraBuffer::dequeue));
+        broker_->setup(buffer_.get());
+        broker_->setTrace(&TraceRegistry::instance().stream(__name__()));
+        if (gonfig.broker_workers > 0) broker_->setExecutor(&BrokerExecutor::shared());
 
         // flag
         is_setup_.store(true);
@@ -49,8 +58,9 @@ public:
         return true;
     }
     
-    bool warmup() override {
+    bool warmup(const CancelToken& token) override {
         device_->warmup();
+        if (token.cancelled()) return false;
         callback_->warmup();
 
         // flag
@@ -59,9 +69,10 @@ public:
         return true;
     }
     
-    bool start() override {
+    bool start(const CancelToken& token) override {
+        if (token.cancelled()) return false;
         broker_->start();
-        buffer_->start();
+        started_ticks_.store(buffer_->start(start_barrier_));
 
         // flag
         is_running_.store(true);
@@ -69,8 +80,12 @@ public:
         return true;
     }
 
-    bool stop() override { return true; }
-    bool cleanup() override { return true; }
+    bool stop(const CancelToken&) override { return true; }
+    bool cleanup(const CancelToken&) override { return true; }
+
+    StreamMetrics metrics() const override {
+        return collectMetrics(__name__(), *buffer_, *broker_);
+    }
 
     std::string __name__() const override {
         return "Camera";
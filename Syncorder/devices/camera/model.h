@@ -5,18 +5,22 @@
 #include <wrl/client.h>
 #include <mfobjects.h>
 
+// local
+#include <Syncorder/devices/common/trace.h>
+#include <Syncorder/devices/common/timestamp.h>
+
 using namespace Microsoft::WRL;
 
 /**
  * @struct
  */
 
-struct CameraBufferData {
+struct CameraBufferData : TraceSlot {
     // sample
     ComPtr<IMFSample> sample_;
     
     // time
-    std::chrono::system_clock::time_point sys_time_;
+    std::int64_t capture_ticks_ = 0;    // timestamps().now() in the callback; host / wall time in the broker
     LONGLONG mf_ts_;
     
     // metadata
@@ -27,13 +31,13 @@ public:
     CameraBufferData() {}
     CameraBufferData(
         ComPtr<IMFSample> sample,
-        std::chrono::system_clock::time_point sys_time,
+        std::int64_t capture_ticks,
         LONGLONG mf_ts,
         DWORD stream_index = 0,
         DWORD flags = 0
     ) {
         sample_ = std::move(sample);
-        sys_time_ = sys_time;
+        capture_ticks_ = capture_ticks;
         mf_ts_ = mf_ts;
     }
 };
\ No newline at end of file
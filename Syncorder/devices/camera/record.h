@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// local
+#include <Syncorder/devices/common/record_log.h>
+
+
+/**
+ * @struct CameraRecord - packed per-sample row of camera_data.csv (schema v2)
+ *
+ * v2: host monotonic arrival time and the MF timestamp aligned to that clock
+ *     (ClockAligner) appended.
+ */
+
+#pragma pack(push, 1)
+
+struct CameraRecord {
+    static constexpr std::uint16_t VERSION = 2;
+    static constexpr const char* STREAM = "camera";
+
+    std::int64_t system_time_ms;
+    std::int64_t media_foundation_timestamp;    // 100 ns units
+    std::int64_t host_time_ns;                  // host monotonic clock at the callback
+    std::int64_t aligned_time_ns;               // media_foundation_timestamp on the host monotonic clock
+
+    static std::vector<RecordField> schema() {
+        return {
+            recordField("system_time_ms", FieldType::I64, offsetof(CameraRecord, system_time_ms)),
+            recordField("media_foundation_timestamp", FieldType::I64, offsetof(CameraRecord, media_foundation_timestamp)),
+            recordField("host_time_ns", FieldType::I64, offsetof(CameraRecord, host_time_ns)),
+            recordField("aligned_time_ns", FieldType::I64, offsetof(CameraRecord, aligned_time_ns)),
+        };
+    }
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(CameraRecord) == 32, "CameraRecord v2 layout is part of the file format");
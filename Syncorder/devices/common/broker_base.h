@@ -2,6 +2,30 @@
 
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+
+// local
+#include <Syncorder/devices/common/eventcount.h>
+#include <Syncorder/devices/common/trace.h>
+#include <Syncorder/devices/common/clock_align.h>
+
+
+class BBroker;
+
+/**
+ * @class Base Executor - runs brokers on shared workers instead of one thread each
+ */
+
+class BExecutor {
+public:
+    virtual ~BExecutor() = default;
+
+    virtual void attach(BBroker* broker) = 0;
+    virtual void detach(BBroker* broker) = 0;
+};
 
 
 /**
@@ -9,36 +33,70 @@
  */
 
 class BBroker {
+    friend class BrokerExecutor;
+
 protected:
-    // buffer
-    void* buffer_;
-    void* dequeue_;
+    // wakeup
+    EventCount* signal_;
+
+    // executor
+    BExecutor* executor_;
+    std::atomic<bool> scheduled_;
+
+    // wait
+    WaitPolicy wait_policy_;
 
     // flag
     std::atomic<bool> running_;
-    std::atomic<int> processed_count_;
+
+    // metrics (single writer, relaxed)
+    std::atomic<std::uint64_t> processed_count_;
+    std::atomic<std::uint64_t> bytes_written_;
+    std::atomic<std::uint64_t> writer_stall_ns_;   // blocked on the file writer
+    std::atomic<std::uint64_t> process_ns_;        // whole _process_batch
+
+    // device clock -> host clock, fed by the derived broker as it writes
+    ClockAligner clock_;
 
     std::thread processing_thread_;
 
 public:
     BBroker() 
     : 
+        signal_(nullptr),
+        executor_(nullptr),
+        scheduled_(false),
         running_(false), 
-        processed_count_(0) 
+        processed_count_(0),
+        bytes_written_(0),
+        writer_stall_ns_(0),
+        process_ns_(0)
     {}
     
     virtual ~BBroker() { stop(); }
 
 public:
-    void setup(void* buffer, void* dequeue) {
-        buffer_ = buffer;
-        dequeue_ = dequeue;
+    void setWaitPolicy(const WaitPolicy& policy) {
+        wait_policy_ = policy;
+    }
+
+    /**
+     * route this broker through a shared executor; call before start()
+     */
+    void setExecutor(BExecutor* executor) {
+        executor_ = executor;
     }
 
     void start() {
         // flag
         running_ = true;
 
+        // executor
+        if (executor_) {
+            executor_->attach(this);
+            return;
+        }
+
         // thread
         processing_thread_ = std::thread(&BBroker::_loop, this);
     }
@@ -47,42 +105,166 @@ public:
         // flag
         running_ = false;
 
+        // executor: returns once no worker is inside _drain()
+        if (executor_) {
+            executor_->detach(this);
+            return;
+        }
+
+        // wakeup
+        if (signal_) signal_->notify();
+
         // thread
         if (processing_thread_.joinable()) processing_thread_.join();
     }
 
+    EventCount* signal() const noexcept {
+        return signal_;
+    }
+
+    std::uint64_t processed() const noexcept { return processed_count_.load(std::memory_order_relaxed); }
+    std::uint64_t bytesWritten() const noexcept { return bytes_written_.load(std::memory_order_relaxed); }
+    std::uint64_t writerStallNs() const noexcept { return writer_stall_ns_.load(std::memory_order_relaxed); }
+    std::uint64_t processNs() const noexcept { return process_ns_.load(std::memory_order_relaxed); }
+    const ClockAligner& clock() const noexcept { return clock_; }
+
 protected:
-    virtual void _broker() = 0;
+    virtual void _loop() = 0;
 
-private:
-    void _loop() {
-        while (running_) _broker();
+    /**
+     * process at most one batch without blocking; returns samples processed
+     */
+    virtual std::size_t _drain() = 0;
+
+    /**
+     * spin -> yield -> park until ready() holds, the producer signals or the
+     * park timeout expires. Without a signal it falls back to a timed sleep.
+     */
+    template<typename Ready>
+    void _await(Ready ready) {
+        for (std::uint32_t i = 0; i < wait_policy_.spin_count; ++i) {
+            if (ready()) return;
+            cpuRelax();
+        }
+
+        for (std::uint32_t i = 0; i < wait_policy_.yield_count; ++i) {
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+
+        if (!signal_) {
+            if (!ready()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return;
+        }
+
+        std::uint32_t key = signal_->prepareWait();
+        if (ready() || !running_) {
+            signal_->cancelWait();
+            return;
+        }
+        signal_->wait(key, wait_policy_.park_timeout);
     }
 };
 
-template<typename DataType>
+constexpr std::size_t BROKER_BATCH_SIZE = 64;
+
+/**
+ * @class Typed Broker
+ *
+ * Drains BufferType::dequeue_n straight into a reusable batch: no per-sample
+ * allocation, no function pointer, one virtual call per batch.
+ */
+
+template<typename DataType, typename BufferType>
 class TBBroker : public BBroker {
+private:
+    BufferType* buffer_;
+
+    // batch
+    std::vector<DataType> batch_;
+
+    // trace
+    StreamTrace* trace_;
+
+public:
+    explicit TBBroker(std::size_t batch_size = BROKER_BATCH_SIZE)
+    :
+        buffer_(nullptr),
+        batch_(batch_size),
+        trace_(nullptr)
+    {}
+
+public:
+    void setup(BufferType* buffer) {
+        buffer_ = buffer;
+        signal_ = buffer ? &buffer->signal() : nullptr;
+    }
+
+    void setTrace(StreamTrace* trace) {
+        trace_ = trace;
+    }
+
 protected:
-    void _broker() override {
-        if (!buffer_ || !dequeue_) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            return;
-        }
+    void _loop() final {
+        while (running_) _broker();
+    }
 
-        typedef void* (*DequeueFunc)(void*);
-        auto dequeue_func = reinterpret_cast<DequeueFunc>(dequeue_);
-        void* raw_data = dequeue_func(buffer_);
-        
-        if (raw_data != nullptr) {
-            processed_count_++;
-            
-            std::unique_ptr<DataType> data(static_cast<DataType*>(raw_data));
-            _process(*data);
-        } else {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    std::size_t _drain() final {
+        if (!buffer_) return 0;
+
+        std::size_t count = buffer_->dequeue_n(batch_.data(), batch_.size());
+        if (count != 0) {
+            auto process_start = std::chrono::steady_clock::now();
+
+            std::int64_t dequeue_ns = traceNow();
+            _process_batch(batch_.data(), count);
+
+            // metrics
+            auto process = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - process_start).count();
+            process_ns_.store(process_ns_.load(std::memory_order_relaxed) + static_cast<std::uint64_t>(process), std::memory_order_relaxed);
+            processed_count_.store(processed_count_.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+            bytes_written_.store(_written(), std::memory_order_relaxed);
+            writer_stall_ns_.store(_stalled(), std::memory_order_relaxed);
+
+            if constexpr (TRACE_ENABLED) {
+                if (trace_) trace_->record(batch_.data(), count, dequeue_ns, traceNow());
+            }
+
+            // release frames / samples held by the scratch batch
+            if constexpr (!std::is_trivially_destructible_v<DataType>) {
+                for (std::size_t i = 0; i < count; ++i) batch_[i] = DataType();
+            }
         }
+        return count;
     }
 
-protected:
     virtual void _process(const DataType& data) = 0;
+
+    virtual void _process_batch(const DataType* data, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) _process(data[i]);
+    }
+
+    /**
+     * total bytes the broker has written so far (metrics only)
+     */
+    virtual std::uint64_t _written() {
+        return 0;
+    }
+
+    /**
+     * total ns the broker has been blocked on its file writers (metrics only)
+     */
+    virtual std::uint64_t _stalled() {
+        return 0;
+    }
+
+private:
+    void _broker() {
+        if (!buffer_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return;
+        }
+
+        _await([&] { return _drain() != 0; });
+    }
 };
\ No newline at end of file
@@ -3,70 +3,311 @@
 #include <chrono>
 #include <array>
 #include <atomic>
+#include <thread>
+#include <memory>
+#include <string>
+#include <cstdint>
 #include <optional>
+#include <algorithm>
 #include <iostream>
+#include <type_traits>
 
+// local
+#include <Syncorder/devices/common/eventcount.h>
+#include <Syncorder/devices/common/spill.h>
+#include <Syncorder/devices/common/start_barrier.h>
+
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+
+/**
+ * @enum OverflowPolicy - what enqueue() does when the ring is full
+ */
+
+enum class OverflowPolicy {
+    RejectNewest,       // drop the incoming sample
+    OverwriteOldest,    // evict the oldest unread sample
+    Block,              // wait for space up to block_timeout, then reject
+    Spill,              // append to a disk-backed SpillSegment (trivially copyable T only)
+};
+
+inline OverflowPolicy parseOverflowPolicy(const std::string& name) {
+    if (name == "overwrite") return OverflowPolicy::OverwriteOldest;
+    if (name == "block") return OverflowPolicy::Block;
+    if (name == "spill") return OverflowPolicy::Spill;
+    return OverflowPolicy::RejectNewest;
+}
+
+
+/**
+ * @class Base Buffer - SPSC ring
+ *
+ * Consumer, producer and shared state each sit on their own cache line.
+ * Each side keeps a local copy of the opposite index and only reloads the
+ * shared atomic when the copy says the ring is full / empty.
+ *
+ * OverwriteOldest: the consumer claims [head, head + n) by CAS before moving
+ * out and frees it through released_; the producer may evict one slot by CAS
+ * on head only when no claim is in flight (head == released_).
+ */
 
 template <typename T, std::size_t N>
 class BBuffer {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "BBuffer capacity must be a power of two");
+
 protected:
-    std::atomic<std::size_t> m_head;
-    std::array<T, N> m_buff;
-    std::atomic<std::size_t> m_tail;
+    static constexpr std::size_t MASK = N - 1;
+    static constexpr bool SPILLABLE = std::is_trivially_copyable_v<T>;
+
+    // consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+    std::size_t m_tail_cached;
+    std::atomic<std::size_t> released_;
 
+    // producer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+    std::size_t m_head_cached;
     std::atomic<bool> gate_{true};
 
+    // overflow
+    OverflowPolicy policy_ = OverflowPolicy::RejectNewest;
+    std::chrono::microseconds block_timeout_{2000};
+    std::unique_ptr<SpillSegment<T>> spill_;
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> overwritten_{0};
+    std::atomic<std::uint64_t> spilled_{0};
+
+    // wakeup
+    alignas(CACHE_LINE_SIZE) EventCount signal_;
+
+    alignas(CACHE_LINE_SIZE) std::array<T, N> m_buff;
+
 public:
-    constexpr BBuffer() noexcept
-    : 
-        m_head(0), 
+    BBuffer() noexcept
+    :
+        m_head(0),
+        m_tail_cached(0),
+        released_(0),
         m_tail(0),
+        m_head_cached(0),
         gate_(true)
     {}
     virtual ~BBuffer() = default;
 
 public:
+    /**
+     * configure before start(); Spill falls back to RejectNewest for types
+     * that cannot be spilled or when the segment cannot be opened.
+     */
+    bool setOverflowPolicy(OverflowPolicy policy, const std::string& spill_path = "") {
+        policy_ = policy;
+        spill_.reset();
+
+        if (policy != OverflowPolicy::Spill) return true;
+
+        if constexpr (SPILLABLE) {
+            auto spill = std::make_unique<SpillSegment<T>>();
+            if (!spill_path.empty() && spill->open(spill_path)) {
+                spill_ = std::move(spill);
+                return true;
+            }
+        }
+
+        policy_ = OverflowPolicy::RejectNewest;
+        return false;
+    }
+
+    void setBlockTimeout(std::chrono::microseconds timeout) {
+        block_timeout_ = timeout;
+    }
+
     bool enqueue(T val) noexcept {
         // gate
         if (gate_.load(std::memory_order_acquire)) return false;
 
+        // spill keeps FIFO: stay on disk until the consumer has caught up
+        if constexpr (SPILLABLE) {
+            if (spill_ && spill_->pending()) return _spill(val);
+        }
+
         // run
         std::size_t current_tail = m_tail.load(std::memory_order_relaxed);
-        if (current_tail - m_head.load(std::memory_order_acquire) < N) {
-            m_buff[current_tail % N] = std::move(val);
-            m_tail.store(current_tail + 1, std::memory_order_release);
-            return true;
+        if (current_tail - m_head_cached >= N) {
+            m_head_cached = _freed();
+            if (current_tail - m_head_cached >= N) {
+                switch (policy_) {
+                case OverflowPolicy::OverwriteOldest:
+                    if (!_evict(current_tail)) return _reject();
+                    break;
+                case OverflowPolicy::Block:
+                    if (!_block(current_tail)) return _reject();
+                    break;
+                case OverflowPolicy::Spill:
+                    return _spill(val);
+                default:
+                    return _reject();
+                }
+            }
         }
-        
-        onOverflow();
-        return false;
+
+        m_buff[current_tail & MASK] = std::move(val);
+        m_tail.store(current_tail + 1, std::memory_order_release);
+        signal_.notify();
+        return true;
     }
-    
+
     std::optional<T> _dequeue() noexcept {
-        std::size_t current_tail = m_tail.load(std::memory_order_acquire);
-        std::size_t current_head = m_head.load(std::memory_order_relaxed);
-        
-        if (current_head != current_tail) {
-            auto value = std::move(m_buff[current_head % N]);
-            m_head.store(current_head + 1, std::memory_order_release);
-            return std::optional<T>(std::move(value));
+        T value;
+        if (dequeue_n(&value, 1) == 0) return std::nullopt;
+        return std::optional<T>(std::move(value));
+    }
+
+    /**
+     * move up to max elements into out with a single head publish
+     */
+    std::size_t dequeue_n(T* out, std::size_t max) noexcept {
+        std::size_t count = _dequeue_ring(out, max);
+
+        if constexpr (SPILLABLE) {
+            if (count == 0 && spill_ && spill_->readable()) {
+                // ring must be empty before the first spilled record is read
+                count = _dequeue_ring(out, max);
+                if (count == 0) count = spill_->pop_n(out, max);
+            }
         }
-        
-        return std::nullopt;
+
+        return count;
     }
 
-    void start() {
+    /**
+     * producer side: hand spilled records still batched in the segment to the
+     * consumer (they otherwise go out with the next spilled push)
+     */
+    void flushSpill() noexcept {
+        if constexpr (SPILLABLE) {
+            if (spill_) spill_->flush();
+        }
+    }
+
+    /**
+     * open the gate, at the barrier's instant when one is given; returns the
+     * capture tick it opened at
+     */
+    std::int64_t start(const StartBarrier* barrier = nullptr) {
+        if (barrier) barrier->wait();
         gate_.store(false, std::memory_order_release);
+        return timestamps().now();
     }
 
     void stop() {
         gate_.store(true, std::memory_order_release);
     }
-    
+
+    EventCount& signal() noexcept {
+        return signal_;
+    }
+
     std::size_t size() const noexcept {
-        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        std::size_t current_head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - current_head;
     }
 
-protected:
-    virtual void onOverflow() noexcept = 0;
-};
\ No newline at end of file
+    static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    // counters (lock-free, any thread)
+    std::uint64_t enqueued() const noexcept { return m_tail.load(std::memory_order_relaxed) + spilled(); }
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t overwritten() const noexcept { return overwritten_.load(std::memory_order_relaxed); }
+    std::uint64_t spilled() const noexcept { return spilled_.load(std::memory_order_relaxed); }
+
+private:
+    std::size_t _freed() const noexcept {
+        return policy_ == OverflowPolicy::OverwriteOldest
+            ? released_.load(std::memory_order_acquire)
+            : m_head.load(std::memory_order_acquire);
+    }
+
+    std::size_t _dequeue_ring(T* out, std::size_t max) noexcept {
+        const bool overwrite = policy_ == OverflowPolicy::OverwriteOldest;
+
+        std::size_t current_head = m_head.load(overwrite ? std::memory_order_acquire : std::memory_order_relaxed);
+        if (current_head > m_tail_cached || m_tail_cached - current_head < max) {
+            m_tail_cached = m_tail.load(std::memory_order_acquire);
+        }
+
+        std::size_t count = std::min(m_tail_cached - current_head, max);
+
+        // claim against producer eviction
+        if (overwrite) {
+            while (count != 0 && !m_head.compare_exchange_weak(current_head, current_head + count, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                if (current_head > m_tail_cached) m_tail_cached = m_tail.load(std::memory_order_acquire);
+                count = std::min(m_tail_cached - current_head, max);
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = std::move(m_buff[(current_head + i) & MASK]);
+        }
+
+        if (count) {
+            if (overwrite) released_.fetch_add(count, std::memory_order_release);
+            else m_head.store(current_head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    bool _reject() noexcept {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool _evict(std::size_t current_tail) noexcept {
+        // a claim in flight frees its slots shortly; spin briefly, then give up
+        for (int attempt = 0; attempt < 1024; ++attempt) {
+            std::size_t head = m_head.load(std::memory_order_acquire);
+            std::size_t released = released_.load(std::memory_order_acquire);
+
+            if (current_tail - released < N) {
+                m_head_cached = released;
+                return true;
+            }
+
+            if (head == released && m_head.compare_exchange_strong(head, head + 1, std::memory_order_acq_rel)) {
+                m_head_cached = released_.fetch_add(1, std::memory_order_acq_rel) + 1;
+                overwritten_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            cpuRelax();
+        }
+        return false;
+    }
+
+    bool _block(std::size_t current_tail) noexcept {
+        auto deadline = std::chrono::steady_clock::now() + block_timeout_;
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+
+            m_head_cached = _freed();
+            if (current_tail - m_head_cached < N) return true;
+            if (gate_.load(std::memory_order_acquire)) return false;
+        }
+        return false;
+    }
+
+    bool _spill(const T& val) noexcept {
+        if constexpr (SPILLABLE) {
+            if (spill_ && spill_->push(val)) {
+                spilled_.fetch_add(1, std::memory_order_relaxed);
+                signal_.notify();
+                return true;
+            }
+        }
+        return _reject();
+    }
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cmath>
+#include <atomic>
+#include <cstdint>
+
+
+/**
+ * @class ClockAligner - online device clock -> host clock mapping of one stream
+ *
+ * Every sample pairs the device's own timestamp with the host time its
+ * callback ran (TimestampMapping::hostNs of the callback's capture stamp).
+ * Arrival = device time + offset + drift * elapsed + latency, so the aligner
+ * fits
+ *
+ *   host - device = offset + drift * (device - device_0)
+ *
+ * by recursive least squares with exponential forgetting: the fit keeps the
+ * last window_s seconds of samples (forgetting per sample is exp(-dt/window),
+ * so it does not depend on the stream rate), tracks drift as it wanders with
+ * temperature, and costs a handful of flops per sample. The state is kept
+ * relative to the newest sample (offset = value at the newest device time),
+ * so the 2x2 covariance stays well conditioned over hours.
+ *
+ * Once locked, samples more than gate sigmas off the fit (scheduler hiccup,
+ * USB burst) are not fitted. A run of rejects, or one sample a second or more
+ * off, means the device clock jumped (reset, re-sync); the aligner then
+ * restarts from that sample.
+ *
+ * align() is called by the broker thread only; offset / drift / jitter are
+ * published as relaxed atomics for metrics.
+ */
+
+class ClockAligner {
+private:
+    // config
+    double window_s_ = 10.0;
+    double gate_ = 4.0;
+
+    static constexpr std::uint64_t LOCK_SAMPLES = 32;
+    static constexpr std::uint64_t MAX_REJECTS = 64;
+    static constexpr double JITTER_FLOOR_NS = 100000.0;   // never gate tighter than 100 us
+    static constexpr double JUMP_NS = 1e9;
+
+    // origin
+    bool started_ = false;
+    std::int64_t device_0_ = 0;
+    std::int64_t host_0_ = 0;
+    std::int64_t device_last_ = 0;
+
+    // fit at device_last_: offset (ns), drift (ns per s), covariance
+    double offset_ = 0.0;
+    double drift_ = 0.0;
+    double p00_ = 0.0, p01_ = 0.0, p11_ = 0.0;
+    double variance_ = 0.0;         // forgetting-weighted residual variance
+
+    std::uint64_t fitted_ = 0;
+    std::uint64_t rejected_run_ = 0;
+
+    // metrics (single writer, relaxed)
+    std::atomic<double> offset_ms_{0.0};
+    std::atomic<double> drift_ppm_{0.0};
+    std::atomic<double> jitter_us_{0.0};
+    std::atomic<std::uint64_t> rejected_{0};
+    std::atomic<std::uint64_t> resets_{0};
+
+public:
+    ClockAligner() = default;
+    ClockAligner(const ClockAligner&) = delete;
+    ClockAligner& operator=(const ClockAligner&) = delete;
+
+    /**
+     * before the first sample
+     */
+    void configure(double window_s, double gate) {
+        window_s_ = window_s > 0.0 ? window_s : 10.0;
+        gate_ = gate > 0.0 ? gate : 4.0;
+    }
+
+    /**
+     * fit one (device, host) pair and return the sample's aligned host time
+     */
+    std::int64_t align(std::int64_t device_ns, std::int64_t host_ns) {
+        update(device_ns, host_ns);
+        return toHost(device_ns);
+    }
+
+    void update(std::int64_t device_ns, std::int64_t host_ns) {
+        if (!started_) {
+            _restart(device_ns, host_ns);
+            return;
+        }
+
+        // move the fit to this sample: offset' = offset + drift * dt, P' = T P T^T
+        double dt = (device_ns - device_last_) * 1e-9;
+        offset_ += drift_ * dt;
+        p00_ += 2.0 * dt * p01_ + dt * dt * p11_;
+        p01_ += dt * p11_;
+        device_last_ = device_ns;
+
+        double lambda = std::exp(-std::fabs(dt) / window_s_);
+        double y = static_cast<double>((host_ns - host_0_) - (device_ns - device_0_));
+        double residual = y - offset_;
+
+        if (std::fabs(residual) >= JUMP_NS) {
+            resets_.fetch_add(1, std::memory_order_relaxed);
+            _restart(device_ns, host_ns);
+            return;
+        }
+
+        // outlier: not fitted once locked
+        if (fitted_ >= LOCK_SAMPLES && std::fabs(residual) > gate_ * std::sqrt(variance_) + JITTER_FLOOR_NS) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            if (++rejected_run_ >= MAX_REJECTS) {
+                resets_.fetch_add(1, std::memory_order_relaxed);
+                _restart(device_ns, host_ns);
+            }
+            return;
+        }
+        rejected_run_ = 0;
+
+        // RLS step, observation vector (1, 0) at the newest sample
+        double denom = lambda + p00_;
+        double k0 = p00_ / denom;
+        double k1 = p01_ / denom;
+        offset_ += k0 * residual;
+        drift_ += k1 * residual;
+
+        double q00 = p00_ - k0 * p00_;
+        double q01 = p01_ - k0 * p01_;
+        double q11 = p11_ - k1 * p01_;
+        p00_ = q00 / lambda;
+        p01_ = q01 / lambda;
+        p11_ = q11 / lambda;
+
+        variance_ = fitted_ == 0 ? residual * residual : lambda * variance_ + (1.0 - lambda) * residual * residual;
+        ++fitted_;
+
+        _publish();
+    }
+
+    /**
+     * device time -> host monotonic ns under the current fit
+     */
+    std::int64_t toHost(std::int64_t device_ns) const noexcept {
+        if (!started_) return device_ns;
+        double dt = (device_ns - device_last_) * 1e-9;
+        double offset = offset_ + drift_ * dt;
+        return host_0_ + (device_ns - device_0_) + static_cast<std::int64_t>(std::llround(offset));
+    }
+
+public:
+    bool locked() const noexcept { return fitted_ >= LOCK_SAMPLES; }
+
+    // host - device at the newest sample, relative to the first pair
+    double offsetMs() const noexcept { return offset_ms_.load(std::memory_order_relaxed); }
+    // device clock rate vs host: > 0 runs fast
+    double driftPpm() const noexcept { return drift_ppm_.load(std::memory_order_relaxed); }
+    // residual RMS of the fitted samples: arrival jitter around the fit
+    double jitterUs() const noexcept { return jitter_us_.load(std::memory_order_relaxed); }
+
+    std::uint64_t rejected() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+    std::uint64_t resets() const noexcept { return resets_.load(std::memory_order_relaxed); }
+
+private:
+    void _restart(std::int64_t device_ns, std::int64_t host_ns) {
+        started_ = true;
+        device_0_ = device_ns;
+        host_0_ = host_ns;
+        device_last_ = device_ns;
+
+        // 10 ms offset, 100 ppm drift a priori
+        offset_ = 0.0;
+        drift_ = 0.0;
+        p00_ = 1e7 * 1e7;
+        p01_ = 0.0;
+        p11_ = 1e5 * 1e5;
+        variance_ = 0.0;
+
+        fitted_ = 0;
+        rejected_run_ = 0;
+        _publish();
+    }
+
+    void _publish() {
+        offset_ms_.store(offset_ / 1e6, std::memory_order_relaxed);
+        drift_ppm_.store(-drift_ / 1e3, std::memory_order_relaxed);
+        jitter_us_.store(std::sqrt(variance_) / 1e3, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,555 @@
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <type_traits>
+
+// local
+#include <Syncorder/devices/common/lz4.h>
+#include <Syncorder/devices/common/record_log.h>
+#include <Syncorder/devices/common/file_writer.h>
+
+
+/**
+ * Chunked container - every stream of a session in one file (MCAP-style)
+ *
+ * [ ContainerHeader ]
+ * [ CHANNEL | ChannelInfo + RecordField x field_count ]        once per channel
+ * [ CHUNK   | ChunkHeader + messages (LZ4 block or raw) ]      ...
+ * [ CHANNEL ... ][ CHUNK_INDEX | ChunkIndexEntry x n ]         summary, on close
+ * [ ContainerFooter ]                                          last 32 bytes
+ *
+ * Every record is [ ContainerRecord { op, length } | payload ]. A chunk holds
+ * interleaved [ MessageHeader | payload ] messages of any channel, in arrival
+ * order; time is the wall-clock ns of the sample's capture stamp
+ * (TimestampMapping::wallNs), the same time base for every channel. The
+ * summary repeats all channels and lists chunks sorted by start_time, so a
+ * reader finds the first chunk that can hold time t with one binary search.
+ */
+
+constexpr char CONTAINER_MAGIC[8] = {'S', 'Y', 'N', 'C', 'C', 'A', 'P', '\0'};
+constexpr std::uint16_t CONTAINER_FORMAT = 1;
+constexpr std::size_t CONTAINER_CHUNK_BYTES = 1 << 20;
+
+enum class ContainerOp : std::uint8_t {
+    CHANNEL = 1,
+    CHUNK = 2,
+    CHUNK_INDEX = 3,
+};
+
+enum class ChunkCompression : std::uint8_t {
+    NONE = 0,
+    LZ4 = 1,
+};
+
+#pragma pack(push, 1)
+
+struct ContainerHeader {
+    char magic[8];
+    std::uint16_t format;               // CONTAINER_FORMAT
+    std::uint8_t reserved[6];
+};
+
+struct ContainerRecord {
+    ContainerOp op;
+    std::uint64_t length;               // payload bytes that follow
+};
+
+struct ChannelInfo {
+    std::uint16_t id;
+    std::uint16_t schema_version;
+    std::uint32_t record_size;          // 0 = variable-size messages
+    std::uint32_t field_count;
+    char stream[32];
+};
+
+struct ChunkHeader {
+    std::int64_t start_time;
+    std::int64_t end_time;
+    std::uint64_t uncompressed_size;
+    std::uint32_t message_count;
+    ChunkCompression compression;
+    std::uint8_t reserved[3];
+};
+
+struct MessageHeader {
+    std::uint16_t channel;
+    std::int64_t time;
+    std::uint32_t size;
+};
+
+struct ChunkIndexEntry {
+    std::int64_t start_time;
+    std::int64_t end_time;
+    std::uint64_t offset;               // of the CHUNK record
+    std::uint64_t length;               // whole record, prefix included
+    std::uint32_t message_count;
+    std::uint32_t reserved;
+};
+
+struct ContainerFooter {
+    std::uint64_t summary_offset;
+    std::uint64_t chunk_count;
+    std::uint64_t reserved;
+    char magic[8];
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(ContainerHeader) == 16, "ContainerHeader layout is part of the file format");
+static_assert(sizeof(ContainerRecord) == 9, "ContainerRecord layout is part of the file format");
+static_assert(sizeof(ChannelInfo) == 44, "ChannelInfo layout is part of the file format");
+static_assert(sizeof(ChunkHeader) == 32, "ChunkHeader layout is part of the file format");
+static_assert(sizeof(MessageHeader) == 14, "MessageHeader layout is part of the file format");
+static_assert(sizeof(ChunkIndexEntry) == 40, "ChunkIndexEntry layout is part of the file format");
+static_assert(sizeof(ContainerFooter) == 32, "ContainerFooter layout is part of the file format");
+
+
+/**
+ * @class ContainerWriter - one session file shared by every broker
+ *
+ * Brokers append under a short chunk lock (one lock per batch); the broker
+ * that fills a chunk swaps it out, compresses it on its own thread and only
+ * then takes the file lock to append it, so compression never blocks the
+ * other streams. Use shared() to get the session instance; the file is
+ * finalised when the last owner lets go.
+ *
+ * write() / writeRecords() return the ns that call was blocked on the file
+ * (waiting for the file lock plus the sink's stall); the caller adds it to
+ * its own stream's writer stall, as the file is shared.
+ */
+
+class ContainerWriter {
+private:
+    std::size_t chunk_bytes_ = CONTAINER_CHUNK_BYTES;
+    bool compress_ = true;
+
+    // open chunk
+    std::mutex chunk_mutex_;
+    std::vector<char> chunk_;
+    ChunkHeader chunk_header_ = {};
+
+    // file
+    std::mutex file_mutex_;
+    std::unique_ptr<BFileSink> sink_;
+    std::uint64_t offset_ = 0;
+    std::vector<std::vector<char>> channels_;
+    std::vector<ChunkIndexEntry> index_;
+
+    // metric
+    std::atomic<std::uint64_t> raw_bytes_{0};
+    std::atomic<std::uint64_t> stored_bytes_{0};
+
+public:
+    ContainerWriter() = default;
+    ContainerWriter(const ContainerWriter&) = delete;
+    ContainerWriter& operator=(const ContainerWriter&) = delete;
+
+    ~ContainerWriter() { close(); }
+
+public:
+    /**
+     * the session container; the first caller opens it, later callers share it
+     * (their path / options are ignored while it is open)
+     */
+    static std::shared_ptr<ContainerWriter> shared(const std::string& path, const FileWriterOptions& options, std::size_t chunk_bytes, bool compress) {
+        static std::mutex mutex;
+        static std::weak_ptr<ContainerWriter> instance;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto existing = instance.lock()) return existing;
+
+        auto writer = std::make_shared<ContainerWriter>();
+        if (!writer->open(path, options, chunk_bytes, compress)) return nullptr;
+
+        instance = writer;
+        return writer;
+    }
+
+    bool open(const std::string& path, const FileWriterOptions& options = {}, std::size_t chunk_bytes = CONTAINER_CHUNK_BYTES, bool compress = true) {
+        close();
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+
+        if (options.backend == WriterBackend::PWRITE || options.backend == WriterBackend::URING) {
+            auto async = std::make_unique<AsyncFileWriter>();
+            if (!async->open(path, options)) return false;
+            sink_ = std::move(async);
+        } else {
+            auto stdio = std::make_unique<StdioFileSink>();
+            if (!stdio->open(path)) return false;
+            sink_ = std::move(stdio);
+        }
+
+        chunk_bytes_ = chunk_bytes ? chunk_bytes : CONTAINER_CHUNK_BYTES;
+        compress_ = compress;
+        chunk_.clear();
+        chunk_.reserve(chunk_bytes_ + chunk_bytes_ / 8);
+        _resetChunk();
+
+        offset_ = 0;
+        channels_.clear();
+        index_.clear();
+
+        ContainerHeader header = {};
+        std::memcpy(header.magic, CONTAINER_MAGIC, sizeof(header.magic));
+        header.format = CONTAINER_FORMAT;
+        _put(&header, sizeof(header));
+        return true;
+    }
+
+    void close() {
+        if (!sink_) return;
+
+        std::vector<char> last;
+        ChunkHeader header;
+        {
+            std::lock_guard<std::mutex> lock(chunk_mutex_);
+            header = _takeChunk(last);
+        }
+        if (header.message_count > 0) _flushChunk(last, header);
+
+        std::lock_guard<std::mutex> lock(file_mutex_);
+
+        // summary
+        ContainerFooter footer = {};
+        footer.summary_offset = offset_;
+        footer.chunk_count = index_.size();
+        std::memcpy(footer.magic, CONTAINER_MAGIC, sizeof(footer.magic));
+
+        for (const auto& channel : channels_) _record(ContainerOp::CHANNEL, channel.data(), channel.size(), nullptr, 0);
+
+        std::sort(index_.begin(), index_.end(), [](const ChunkIndexEntry& a, const ChunkIndexEntry& b) { return a.start_time < b.start_time; });
+        _record(ContainerOp::CHUNK_INDEX, index_.data(), index_.size() * sizeof(ChunkIndexEntry), nullptr, 0);
+
+        _put(&footer, sizeof(footer));
+
+        sink_->close();
+        sink_.reset();
+    }
+
+    /**
+     * register a stream; returns the channel id to pass to write()
+     */
+    std::uint16_t addChannel(const char* stream, std::uint16_t schema_version, std::uint32_t record_size, const std::vector<RecordField>& fields) {
+        std::lock_guard<std::mutex> lock(file_mutex_);
+
+        ChannelInfo info = {};
+        info.id = static_cast<std::uint16_t>(channels_.size());
+        info.schema_version = schema_version;
+        info.record_size = record_size;
+        info.field_count = static_cast<std::uint32_t>(fields.size());
+        std::strncpy(info.stream, stream, sizeof(info.stream) - 1);
+
+        std::vector<char> payload(sizeof(info) + fields.size() * sizeof(RecordField));
+        std::memcpy(payload.data(), &info, sizeof(info));
+        if (!fields.empty()) std::memcpy(payload.data() + sizeof(info), fields.data(), fields.size() * sizeof(RecordField));
+
+        _record(ContainerOp::CHANNEL, payload.data(), payload.size(), nullptr, 0);
+        channels_.push_back(std::move(payload));
+        return info.id;
+    }
+
+    template<typename Record>
+    std::uint16_t addChannel() {
+        return addChannel(Record::STREAM, Record::VERSION, static_cast<std::uint32_t>(sizeof(Record)), Record::schema());
+    }
+
+    std::uint64_t write(std::uint16_t channel, std::int64_t time, const void* data, std::uint32_t size) {
+        std::vector<char> full;
+        ChunkHeader header;
+        {
+            std::lock_guard<std::mutex> lock(chunk_mutex_);
+            _append(channel, time, data, size);
+            if (chunk_.size() < chunk_bytes_) return 0;
+            header = _takeChunk(full);
+        }
+        return _flushChunk(full, header);
+    }
+
+    template<typename Record>
+    std::uint64_t writeRecords(std::uint16_t channel, const std::int64_t* times, const Record* records, std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<Record>, "container records must be trivially copyable");
+
+        std::vector<char> full;
+        ChunkHeader header;
+        {
+            std::lock_guard<std::mutex> lock(chunk_mutex_);
+            for (std::size_t i = 0; i < count; ++i) _append(channel, times[i], &records[i], static_cast<std::uint32_t>(sizeof(Record)));
+            if (chunk_.size() < chunk_bytes_) return 0;
+            header = _takeChunk(full);
+        }
+        return _flushChunk(full, header);
+    }
+
+    // message bytes before / after compression, for the ratio
+    std::uint64_t rawBytes() const noexcept {
+        return raw_bytes_.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t storedBytes() const noexcept {
+        return stored_bytes_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void _resetChunk() {
+        chunk_header_ = {};
+        chunk_header_.start_time = INT64_MAX;
+        chunk_header_.end_time = INT64_MIN;
+    }
+
+    // chunk_mutex_ held
+    void _append(std::uint16_t channel, std::int64_t time, const void* data, std::uint32_t size) {
+        MessageHeader message = {channel, time, size};
+        const char* bytes = static_cast<const char*>(data);
+
+        chunk_.insert(chunk_.end(), reinterpret_cast<const char*>(&message), reinterpret_cast<const char*>(&message) + sizeof(message));
+        chunk_.insert(chunk_.end(), bytes, bytes + size);
+
+        if (time < chunk_header_.start_time) chunk_header_.start_time = time;
+        if (time > chunk_header_.end_time) chunk_header_.end_time = time;
+        ++chunk_header_.message_count;
+    }
+
+    // chunk_mutex_ held
+    ChunkHeader _takeChunk(std::vector<char>& out) {
+        ChunkHeader header = chunk_header_;
+        out.swap(chunk_);
+
+        chunk_.clear();
+        chunk_.reserve(chunk_bytes_ + chunk_bytes_ / 8);
+        _resetChunk();
+        return header;
+    }
+
+    // returns the ns spent blocked on the file
+    std::uint64_t _flushChunk(const std::vector<char>& data, ChunkHeader header) {
+        static thread_local std::vector<char> compressed;
+
+        const char* payload = data.data();
+        std::size_t size = data.size();
+
+        header.uncompressed_size = data.size();
+        header.compression = ChunkCompression::NONE;
+
+        if (compress_) {
+            compressed.resize(lz4Bound(data.size()));
+            std::size_t packed = lz4Compress(data.data(), data.size(), compressed.data(), compressed.size());
+            if (packed > 0 && packed < data.size()) {
+                payload = compressed.data();
+                size = packed;
+                header.compression = ChunkCompression::LZ4;
+            }
+        }
+
+        raw_bytes_.fetch_add(data.size(), std::memory_order_relaxed);
+        stored_bytes_.fetch_add(size, std::memory_order_relaxed);
+
+        auto wait_start = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        if (!sink_) return 0;
+
+        std::uint64_t waited = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wait_start).count());
+        std::uint64_t sink_stall = sink_->stallNs();
+
+        ChunkIndexEntry entry = {};
+        entry.start_time = header.start_time;
+        entry.end_time = header.end_time;
+        entry.offset = offset_;
+        entry.length = sizeof(ContainerRecord) + sizeof(ChunkHeader) + size;
+        entry.message_count = header.message_count;
+
+        _record(ContainerOp::CHUNK, &header, sizeof(header), payload, size);
+        index_.push_back(entry);
+        return waited + (sink_->stallNs() - sink_stall);
+    }
+
+    // file_mutex_ held
+    void _record(ContainerOp op, const void* head, std::size_t head_size, const void* body, std::size_t body_size) {
+        ContainerRecord record = {op, head_size + body_size};
+        _put(&record, sizeof(record));
+        _put(head, head_size);
+        _put(body, body_size);
+    }
+
+    void _put(const void* data, std::size_t size) {
+        if (size == 0) return;
+        sink_->write(data, size);
+        offset_ += size;
+    }
+};
+
+
+/**
+ * @class ContainerReader - loads the summary and reads chunks by time
+ */
+
+struct ContainerChannel {
+    ChannelInfo info;
+    std::vector<RecordField> fields;
+};
+
+class ContainerReader {
+private:
+    std::FILE* file_ = nullptr;
+    std::vector<ContainerChannel> channels_;
+    std::vector<ChunkIndexEntry> index_;
+    std::vector<std::int64_t> max_end_;         // running max of end_time over index_
+    std::vector<char> compressed_;
+
+public:
+    ContainerReader() = default;
+    ContainerReader(const ContainerReader&) = delete;
+    ContainerReader& operator=(const ContainerReader&) = delete;
+
+    ~ContainerReader() { close(); }
+
+public:
+    /**
+     * returns an empty string on success, otherwise why the file was rejected
+     */
+    std::string open(const std::string& path) {
+        close();
+
+        std::error_code ec;
+        std::uint64_t file_size = std::filesystem::file_size(path, ec);
+        if (ec) return "cannot open " + path;
+
+        file_ = std::fopen(path.c_str(), "rb");
+        if (!file_) return "cannot open " + path;
+
+        ContainerHeader header;
+        if (std::fread(&header, sizeof(header), 1, file_) != 1) return "truncated header";
+        if (std::memcmp(header.magic, CONTAINER_MAGIC, sizeof(header.magic)) != 0) return "not a container";
+        if (header.format != CONTAINER_FORMAT) return "unsupported format " + std::to_string(header.format);
+
+        ContainerFooter footer;
+        if (file_size < sizeof(header) + sizeof(footer)) return "missing footer (recording not closed?)";
+        fileSeek(file_, static_cast<std::int64_t>(file_size - sizeof(footer)));
+        if (std::fread(&footer, sizeof(footer), 1, file_) != 1) return "truncated footer";
+        if (std::memcmp(footer.magic, CONTAINER_MAGIC, sizeof(footer.magic)) != 0) return "missing footer (recording not closed?)";
+
+        // summary
+        std::uint64_t position = footer.summary_offset;
+        std::uint64_t summary_end = file_size - sizeof(footer);
+        while (position + sizeof(ContainerRecord) <= summary_end) {
+            ContainerRecord record;
+            fileSeek(file_, static_cast<std::int64_t>(position));
+            if (std::fread(&record, sizeof(record), 1, file_) != 1) return "truncated summary";
+            if (position + sizeof(record) + record.length > summary_end) return "corrupt summary";
+
+            std::vector<char> payload(static_cast<std::size_t>(record.length));
+            if (!payload.empty() && std::fread(payload.data(), 1, payload.size(), file_) != payload.size()) return "truncated summary";
+
+            if (record.op == ContainerOp::CHANNEL) {
+                if (payload.size() < sizeof(ChannelInfo)) return "corrupt channel";
+
+                ContainerChannel channel;
+                std::memcpy(&channel.info, payload.data(), sizeof(ChannelInfo));
+                if (payload.size() != sizeof(ChannelInfo) + channel.info.field_count * sizeof(RecordField)) return "corrupt channel";
+
+                channel.fields.resize(channel.info.field_count);
+                if (!channel.fields.empty()) std::memcpy(channel.fields.data(), payload.data() + sizeof(ChannelInfo), channel.fields.size() * sizeof(RecordField));
+                channels_.push_back(std::move(channel));
+            } else if (record.op == ContainerOp::CHUNK_INDEX) {
+                index_.resize(payload.size() / sizeof(ChunkIndexEntry));
+                if (!index_.empty()) std::memcpy(index_.data(), payload.data(), index_.size() * sizeof(ChunkIndexEntry));
+            }
+
+            position += sizeof(record) + record.length;
+        }
+        if (index_.size() != footer.chunk_count) return "chunk index mismatch";
+
+        std::int64_t running = INT64_MIN;
+        for (const auto& entry : index_) {
+            running = entry.end_time > running ? entry.end_time : running;
+            max_end_.push_back(running);
+        }
+        return "";
+    }
+
+    void close() {
+        if (file_) std::fclose(file_);
+        file_ = nullptr;
+        channels_.clear();
+        index_.clear();
+        max_end_.clear();
+    }
+
+    const std::vector<ContainerChannel>& channels() const noexcept {
+        return channels_;
+    }
+
+    const std::vector<ChunkIndexEntry>& chunks() const noexcept {
+        return index_;
+    }
+
+    /**
+     * first chunk that may hold a message at or after time (O(log n));
+     * chunks().size() if none
+     */
+    std::size_t seek(std::int64_t time) const {
+        return static_cast<std::size_t>(std::lower_bound(max_end_.begin(), max_end_.end(), time) - max_end_.begin());
+    }
+
+    /**
+     * decompressed messages of chunk i into out
+     */
+    bool readChunk(std::size_t i, std::vector<char>& out) {
+        if (!file_ || i >= index_.size()) return false;
+        const ChunkIndexEntry& entry = index_[i];
+
+        ContainerRecord record;
+        ChunkHeader header;
+        fileSeek(file_, static_cast<std::int64_t>(entry.offset));
+        if (std::fread(&record, sizeof(record), 1, file_) != 1 || record.op != ContainerOp::CHUNK) return false;
+        if (record.length < sizeof(header) || std::fread(&header, sizeof(header), 1, file_) != 1) return false;
+
+        std::size_t stored = static_cast<std::size_t>(record.length - sizeof(header));
+        out.resize(static_cast<std::size_t>(header.uncompressed_size));
+
+        if (header.compression == ChunkCompression::NONE) {
+            return stored == out.size() && (stored == 0 || std::fread(out.data(), 1, stored, file_) == stored);
+        }
+
+        compressed_.resize(stored);
+        if (stored > 0 && std::fread(compressed_.data(), 1, stored, file_) != stored) return false;
+        return lz4Decompress(compressed_.data(), stored, out.data(), out.size()) == static_cast<long long>(out.size());
+    }
+
+    /**
+     * fn(const MessageHeader&, const char* payload) for every message with
+     * from <= time <= to, chunk by chunk (arrival order within a chunk)
+     */
+    template<typename Fn>
+    bool forEachMessage(std::int64_t from, std::int64_t to, Fn fn) {
+        std::vector<char> chunk;
+
+        for (std::size_t i = seek(from); i < index_.size() && index_[i].start_time <= to; ++i) {
+            if (index_[i].end_time < from) continue;
+            if (!readChunk(i, chunk)) return false;
+
+            std::size_t position = 0;
+            while (position + sizeof(MessageHeader) <= chunk.size()) {
+                MessageHeader message;
+                std::memcpy(&message, chunk.data() + position, sizeof(message));
+                position += sizeof(message);
+                if (position + message.size > chunk.size()) return false;
+
+                if (message.time >= from && message.time <= to) fn(message, chunk.data() + position);
+                position += message.size;
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <filesystem>
+#include <type_traits>
+
+// local
+#include <Syncorder/devices/common/file_writer.h>
+#include <Syncorder/devices/common/segment_writer.h>
+
+
+/**
+ * @class CsvWriter - to_chars row formatter over a large buffered FILE*
+ *
+ * Rows are formatted with std::to_chars into a thread_local scratch block and
+ * handed to the file with one fwrite per flush(); the FILE* itself buffers
+ * CSV_FILE_BUFFER bytes, so the disk sees large sequential writes.
+ *
+ * Output matches std::ofstream defaults byte for byte:
+ *   floating()       - operator<< default (%g, precision 6)
+ *   fixed(v, p)      - std::fixed << std::setprecision(p)
+ *   integers / bool  - decimal, bool as 0 / 1
+ * The file is opened in text mode like std::ofstream, so line endings match too.
+ *
+ * With a non-INLINE FileWriterOptions backend the blocks go to a BFileSink
+ * instead of the FILE* - an AsyncFileWriter, or a SegmentWriter that repeats
+ * the header line in every segment; '\n' is then expanded to "\r\n" on
+ * Windows by hand to keep the text-mode output.
+ *
+ * open() creates missing parent directories in every mode. Rows written
+ * while no file is open are dropped, so callers must check its result.
+ *
+ * stallNs() is the writer stall: time the broker spent blocked on the disk,
+ * inside fwrite for INLINE or waiting on the sink otherwise.
+ *
+ * Contract: call flush() on the thread that wrote the rows before it moves on
+ * (brokers flush at the end of every batch), since the scratch is per thread.
+ */
+
+constexpr std::size_t CSV_SCRATCH_SIZE = 64 * 1024;
+constexpr std::size_t CSV_FILE_BUFFER = 1 << 20;
+constexpr std::size_t CSV_MAX_FIELD = 64;
+
+class CsvWriter {
+private:
+    struct Scratch {
+        char data[CSV_SCRATCH_SIZE];
+        std::size_t size = 0;
+    };
+
+    std::FILE* file_ = nullptr;
+    std::vector<char> io_buffer_;
+    std::unique_ptr<BFileSink> sink_;
+    std::uint64_t bytes_ = 0;
+    std::atomic<std::uint64_t> stall_ns_{0};      // INLINE: time inside fwrite
+
+    static Scratch& _scratch() {
+        static thread_local Scratch scratch;
+        return scratch;
+    }
+
+public:
+    CsvWriter() = default;
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+
+    ~CsvWriter() { close(); }
+
+public:
+    bool open(const std::string& path, const FileWriterOptions& options = {}) {
+        close();
+        bytes_ = 0;
+        stall_ns_.store(0, std::memory_order_relaxed);
+
+        if (options.backend == WriterBackend::SEGMENT) {
+            auto segments = std::make_unique<SegmentWriter>();
+            if (!segments->open(path, options, 1)) return false;
+            sink_ = std::move(segments);
+            return true;
+        }
+        if (options.backend != WriterBackend::INLINE) {
+            auto async = std::make_unique<AsyncFileWriter>();
+            if (!async->open(path, options)) return false;
+            sink_ = std::move(async);
+            return true;
+        }
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+
+        file_ = std::fopen(path.c_str(), "w");
+        if (!file_) return false;
+
+        io_buffer_.resize(CSV_FILE_BUFFER);
+        std::setvbuf(file_, io_buffer_.data(), _IOFBF, io_buffer_.size());
+        return true;
+    }
+
+    void close() {
+        if (!is_open()) return;
+
+        flush();
+        if (sink_) sink_->close();
+        sink_.reset();
+
+        if (file_) std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    bool is_open() const noexcept {
+        return file_ != nullptr || sink_ != nullptr;
+    }
+
+    /**
+     * bytes handed to the file so far (before text-mode newline translation)
+     */
+    std::uint64_t bytes() const noexcept {
+        return bytes_;
+    }
+
+    std::uint64_t stallNs() const noexcept {
+        return sink_ ? sink_->stallNs() : stall_ns_.load(std::memory_order_relaxed);
+    }
+
+public:
+    CsvWriter& text(const char* value) {
+        std::size_t length = std::strlen(value);
+        if (length > CSV_SCRATCH_SIZE) {
+            flush();
+            _emit(value, length);
+            return *this;
+        }
+
+        Scratch& scratch = _reserve(length);
+        std::memcpy(scratch.data + scratch.size, value, length);
+        scratch.size += length;
+        return *this;
+    }
+
+    CsvWriter& put(char c) {
+        Scratch& scratch = _reserve(1);
+        scratch.data[scratch.size++] = c;
+        return *this;
+    }
+
+    template<typename Integer>
+    CsvWriter& integer(Integer value) {
+        static_assert(std::is_integral_v<Integer> || std::is_enum_v<Integer>, "integer() needs an integral or enum value");
+
+        if constexpr (std::is_same_v<Integer, bool>) {
+            return put(value ? '1' : '0');
+        } else if constexpr (std::is_enum_v<Integer>) {
+            return integer(static_cast<std::underlying_type_t<Integer>>(value));
+        } else if constexpr (sizeof(Integer) == 1) {
+            return integer(static_cast<int>(value));
+        } else {
+            Scratch& scratch = _reserve(CSV_MAX_FIELD);
+            auto result = std::to_chars(scratch.data + scratch.size, scratch.data + CSV_SCRATCH_SIZE, value);
+            scratch.size = static_cast<std::size_t>(result.ptr - scratch.data);
+            return *this;
+        }
+    }
+
+    CsvWriter& floating(double value) {
+        Scratch& scratch = _reserve(CSV_MAX_FIELD);
+        auto result = std::to_chars(scratch.data + scratch.size, scratch.data + CSV_SCRATCH_SIZE, value, std::chars_format::general, 6);
+        scratch.size = static_cast<std::size_t>(result.ptr - scratch.data);
+        return *this;
+    }
+
+    CsvWriter& fixed(double value, int precision) {
+        // fixed notation of a huge double can exceed CSV_MAX_FIELD; fall back to the whole block
+        Scratch& scratch = _reserve(CSV_MAX_FIELD);
+        auto result = std::to_chars(scratch.data + scratch.size, scratch.data + CSV_SCRATCH_SIZE, value, std::chars_format::fixed, precision);
+        if (result.ec != std::errc()) {
+            flush();
+            result = std::to_chars(scratch.data, scratch.data + CSV_SCRATCH_SIZE, value, std::chars_format::fixed, precision);
+        }
+        scratch.size = static_cast<std::size_t>(result.ptr - scratch.data);
+        return *this;
+    }
+
+    /**
+     * hand the formatted block to the file
+     */
+    void flush() {
+        Scratch& scratch = _scratch();
+        if (scratch.size == 0) return;
+
+        _emit(scratch.data, scratch.size);
+        scratch.size = 0;
+    }
+
+private:
+    void _emit(const char* data, std::size_t size) {
+        bytes_ += size;
+
+        if (file_) {
+            auto start = std::chrono::steady_clock::now();
+            std::fwrite(data, 1, size, file_);
+            addStall(stall_ns_, start);
+            return;
+        }
+        if (!sink_) return;
+
+#if defined(_WIN32)
+        const char* end = data + size;
+        while (data < end) {
+            const char* newline = static_cast<const char*>(std::memchr(data, '\n', end - data));
+            if (!newline) {
+                sink_->write(data, end - data);
+                break;
+            }
+            sink_->write(data, newline - data);
+            sink_->write("\r\n", 2);
+            data = newline + 1;
+        }
+#else
+        sink_->write(data, size);
+#endif
+    }
+
+    Scratch& _reserve(std::size_t length) {
+        Scratch& scratch = _scratch();
+        if (scratch.size + length > CSV_SCRATCH_SIZE) flush();
+        return scratch;
+    }
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <condition_variable>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+
+/**
+ * @helper: cpu relax - pause hint inside spin loops
+ */
+
+inline void cpuRelax() noexcept {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+
+/**
+ * @struct WaitPolicy - consumer spin-then-park tuning
+ *
+ * spin_count pause iterations, then yield_count yields, then park on the
+ * EventCount until the producer signals or park_timeout expires.
+ */
+
+struct WaitPolicy {
+    std::uint32_t spin_count = 128;
+    std::uint32_t yield_count = 16;
+    std::chrono::milliseconds park_timeout{100};
+};
+
+
+/**
+ * @class EventCount - producer-signalled wait primitive
+ *
+ * Consumer: key = prepareWait(); re-check condition; wait(key) or cancelWait().
+ * Producer: publish data; notify().
+ * notify() only touches the mutex when a consumer is actually parked.
+ * forward() chains a second EventCount (e.g. a shared executor) to every notify.
+ */
+
+class EventCount {
+private:
+    std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint32_t> waiters_{0};
+    std::atomic<EventCount*> forward_{nullptr};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+public:
+    EventCount() = default;
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+public:
+    std::uint32_t prepareWait() noexcept {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        return epoch_.load(std::memory_order_seq_cst);
+    }
+
+    void cancelWait() noexcept {
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    template<typename Rep, typename Period>
+    void wait(std::uint32_t key, const std::chrono::duration<Rep, Period>& timeout) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, timeout, [&] {
+                return epoch_.load(std::memory_order_acquire) != key;
+            });
+        }
+        waiters_.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void forward(EventCount* target) noexcept {
+        forward_.store(target, std::memory_order_release);
+    }
+
+    void notify() noexcept {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (EventCount* target = forward_.load(std::memory_order_acquire)) target->notify();
+        if (waiters_.load(std::memory_order_seq_cst) == 0) return;
+
+        // pair with the waiter's predicate check
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        cv_.notify_all();
+    }
+};
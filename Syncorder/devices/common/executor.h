@@ -0,0 +1,178 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <shared_mutex>
+
+// local
+#include <Syncorder/gonfig/gonfig.h>
+#include <Syncorder/devices/common/eventcount.h>
+#include <Syncorder/devices/common/broker_base.h>
+
+
+/**
+ * @class BrokerExecutor - shared worker pool for brokers
+ *
+ * Every attached broker's buffer signal is forwarded to one executor
+ * EventCount, so workers park until any buffer has data. Each broker has a
+ * home worker; a worker drains its home brokers first and steals from the
+ * others only when its own are empty. A broker is drained by at most one
+ * worker at a time (scheduled_ flag), which keeps per-broker FIFO order.
+ *
+ * The entry lock is held only to claim a broker (scheduled_), never across
+ * _drain(): a drain does the broker's file writes, and a shared hold that long
+ * would keep detach() out for as long as input keeps arriving.
+ *
+ * shared() is the session pool every manager attaches to; it is sized once
+ * from gonfig.broker_workers, so no broker's construction order decides it.
+ */
+
+class BrokerExecutor : public BExecutor {
+private:
+    struct Entry {
+        BBroker* broker;
+        std::size_t home;
+    };
+
+    std::vector<Entry> entries_;
+    std::size_t next_home_ = 0;
+    std::shared_mutex mutex_;
+
+    // worker
+    std::size_t worker_count_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{false};
+
+    // wakeup
+    EventCount signal_;
+    WaitPolicy wait_policy_;
+
+public:
+    explicit BrokerExecutor(std::size_t worker_count)
+    :
+        worker_count_(std::max<std::size_t>(1, worker_count))
+    {}
+
+    ~BrokerExecutor() override { shutdown(); }
+
+    static BrokerExecutor& shared() {
+        static BrokerExecutor executor(static_cast<std::size_t>(std::max(1, gonfig.broker_workers)));
+        return executor;
+    }
+
+public:
+    void setWaitPolicy(const WaitPolicy& policy) {
+        wait_policy_ = policy;
+    }
+
+    void attach(BBroker* broker) override {
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            for (auto& entry : entries_) if (entry.broker == broker) return;
+
+            entries_.push_back({broker, next_home_++ % worker_count_});
+            if (broker->signal_) broker->signal_->forward(&signal_);
+
+            // workers
+            if (!running_.exchange(true)) {
+                for (std::size_t i = 0; i < worker_count_; ++i) {
+                    workers_.emplace_back(&BrokerExecutor::_work, this, i);
+                }
+            }
+        }
+        signal_.notify();
+    }
+
+    void detach(BBroker* broker) override {
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            if (broker->signal_) broker->signal_->forward(nullptr);
+
+            entries_.erase(
+                std::remove_if(entries_.begin(), entries_.end(), [&](const Entry& entry) { return entry.broker == broker; }),
+                entries_.end()
+            );
+        }
+
+        // claims are made under the lock from entries_: only one made before the erase can still be draining
+        while (broker->scheduled_.load(std::memory_order_acquire)) std::this_thread::yield();
+    }
+
+    void shutdown() {
+        if (!running_.exchange(false)) return;
+
+        signal_.notify();
+        for (auto& worker : workers_) {
+            if (worker.joinable()) worker.join();
+        }
+        workers_.clear();
+    }
+
+    std::size_t workerCount() const noexcept {
+        return worker_count_;
+    }
+
+private:
+    void _work(std::size_t index) {
+        while (running_.load(std::memory_order_acquire)) {
+            if (_scan(index)) continue;
+
+            // spin -> park
+            bool found = false;
+            for (std::uint32_t i = 0; i < wait_policy_.spin_count && !found; ++i) {
+                found = _scan(index) != 0;
+                cpuRelax();
+            }
+            if (found) continue;
+
+            std::uint32_t key = signal_.prepareWait();
+            if (_scan(index) || !running_.load(std::memory_order_acquire)) {
+                signal_.cancelWait();
+                continue;
+            }
+            signal_.wait(key, wait_policy_.park_timeout);
+        }
+    }
+
+    std::size_t _scan(std::size_t index) {
+        // home
+        std::size_t processed = 0;
+        std::size_t cursor = 0;
+        while (BBroker* broker = _claim(index, false, cursor)) processed += _run(*broker);
+        if (processed) return processed;
+
+        // steal
+        cursor = 0;
+        while (BBroker* broker = _claim(index, true, cursor)) processed += _run(*broker);
+        return processed;
+    }
+
+    /**
+     * next free broker from cursor on (home or stolen) with scheduled_ set;
+     * entries may change between calls, which at worst skips a broker until
+     * the next scan
+     */
+    BBroker* _claim(std::size_t index, bool steal, std::size_t& cursor) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+
+        while (cursor < entries_.size()) {
+            const Entry& entry = entries_[cursor++];
+            if ((entry.home != index) != steal) continue;
+
+            bool expected = false;
+            if (entry.broker->scheduled_.compare_exchange_strong(expected, true, std::memory_order_acquire)) return entry.broker;
+        }
+        return nullptr;
+    }
+
+    // claimed by _claim(); runs without the entry lock
+    std::size_t _run(BBroker& broker) {
+        std::size_t processed = broker.running_.load() ? broker._drain() : 0;
+
+        broker.scheduled_.store(false, std::memory_order_release);
+        return processed;
+    }
+};
\ No newline at end of file
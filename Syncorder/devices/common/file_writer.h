@@ -0,0 +1,809 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <condition_variable>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+    #include <malloc.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define SYNCORDER_IO_URING 1
+        #include <linux/io_uring.h>
+        #include <sys/mman.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+
+/**
+ * Asynchronous file writer - brokers fill aligned blocks, a writer thread
+ * hands them to the backend, so a storage stall never stops a broker from
+ * draining its ring (it only waits once every block is in flight).
+ *
+ *   INLINE  - no writer thread; callers keep their buffered FILE* path
+ *   PWRITE  - positional writes (pwrite / WriteFile + OVERLAPPED offset)
+ *   URING   - io_uring with up to FILE_WRITER_QUEUE_DEPTH writes in flight
+ *             (Linux only; falls back to PWRITE if the ring cannot be set up)
+ *   SEGMENT - preallocated, memory-mapped segment files (segment_writer.h)
+ *
+ * direct = O_DIRECT / FILE_FLAG_NO_BUFFERING. Blocks and offsets are kept
+ * FILE_WRITER_ALIGNMENT aligned; the last block is zero padded and the file is
+ * truncated back to its logical size on close.
+ */
+
+constexpr std::size_t FILE_WRITER_ALIGNMENT = 4096;
+constexpr std::size_t FILE_WRITER_BLOCK_SIZE = 1 << 20;
+constexpr std::size_t FILE_WRITER_BLOCKS = 4;
+constexpr unsigned FILE_WRITER_QUEUE_DEPTH = 8;
+constexpr std::uint64_t FILE_WRITER_SEGMENT_BYTES = 256ull << 20;
+
+enum class WriterBackend {
+    INLINE,
+    PWRITE,
+    URING,
+    SEGMENT,
+};
+
+inline WriterBackend parseWriterBackend(const std::string& name) {
+    if (name == "pwrite") return WriterBackend::PWRITE;
+    if (name == "uring") return WriterBackend::URING;
+    if (name == "segment") return WriterBackend::SEGMENT;
+    return WriterBackend::INLINE;
+}
+
+struct FileWriterOptions {
+    WriterBackend backend = WriterBackend::INLINE;
+    bool direct = false;
+    std::size_t block_size = FILE_WRITER_BLOCK_SIZE;
+    std::size_t blocks = FILE_WRITER_BLOCKS;
+
+    // SEGMENT: rotate at segment_bytes, or after segment_seconds (0 = size only)
+    std::uint64_t segment_bytes = FILE_WRITER_SEGMENT_BYTES;
+    int segment_seconds = 0;
+};
+
+inline FileWriterOptions makeWriterOptions(const std::string& backend, bool direct, int block_kb, int blocks, int segment_mb = 0, int segment_seconds = 0) {
+    FileWriterOptions options;
+    options.backend = parseWriterBackend(backend);
+    options.direct = direct;
+    if (block_kb > 0) options.block_size = static_cast<std::size_t>(block_kb) * 1024;
+    if (blocks > 0) options.blocks = static_cast<std::size_t>(blocks);
+    if (segment_mb > 0) options.segment_bytes = static_cast<std::uint64_t>(segment_mb) << 20;
+    if (segment_seconds > 0) options.segment_seconds = segment_seconds;
+    return options;
+}
+
+
+/**
+ * add the time since start to a stall counter
+ */
+inline void addStall(std::atomic<std::uint64_t>& counter, std::chrono::steady_clock::time_point start) noexcept {
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    counter.fetch_add(static_cast<std::uint64_t>(elapsed), std::memory_order_relaxed);
+}
+
+
+/**
+ * @class BFileSink - append-only byte stream a formatter can write into
+ */
+
+class BFileSink {
+public:
+    virtual ~BFileSink() = default;
+
+public:
+    virtual void write(const void* data, std::size_t size) = 0;
+    virtual void close() = 0;
+
+    /**
+     * ns the producer spent blocked in write() on the disk side (any thread)
+     */
+    virtual std::uint64_t stallNs() const noexcept { return 0; }
+};
+
+
+/**
+ * @class StdioFileSink - INLINE: a FILE* with a large stdio buffer
+ *
+ * The write is synchronous, so its stall is the time spent inside fwrite.
+ */
+
+class StdioFileSink : public BFileSink {
+private:
+    std::FILE* file_ = nullptr;
+    std::vector<char> io_buffer_;
+    std::atomic<std::uint64_t> stall_ns_{0};
+
+public:
+    ~StdioFileSink() override { close(); }
+
+public:
+    bool open(const std::string& path) {
+        close();
+
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) return false;
+
+        io_buffer_.resize(FILE_WRITER_BLOCK_SIZE);
+        std::setvbuf(file_, io_buffer_.data(), _IOFBF, io_buffer_.size());
+        return true;
+    }
+
+    void write(const void* data, std::size_t size) override {
+        if (!file_) return;
+
+        auto start = std::chrono::steady_clock::now();
+        std::fwrite(data, 1, size, file_);
+        addStall(stall_ns_, start);
+    }
+
+    std::uint64_t stallNs() const noexcept override {
+        return stall_ns_.load(std::memory_order_relaxed);
+    }
+
+    void close() override {
+        if (file_) std::fclose(file_);
+        file_ = nullptr;
+    }
+};
+
+inline void* alignedAlloc(std::size_t size) {
+#if defined(_WIN32)
+    return _aligned_malloc(size, FILE_WRITER_ALIGNMENT);
+#else
+    void* memory = nullptr;
+    return posix_memalign(&memory, FILE_WRITER_ALIGNMENT, size) == 0 ? memory : nullptr;
+#endif
+}
+
+inline void alignedFree(void* memory) {
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+inline std::size_t alignUp(std::size_t size) {
+    return (size + FILE_WRITER_ALIGNMENT - 1) & ~(FILE_WRITER_ALIGNMENT - 1);
+}
+
+
+/**
+ * @struct WriteBlock - one aligned buffer and where it goes in the file
+ */
+
+struct WriteBlock {
+    char* data = nullptr;
+    std::size_t capacity = 0;
+    std::size_t size = 0;               // bytes to write (padded in direct mode)
+    std::uint64_t offset = 0;
+    std::size_t done = 0;               // bytes already written (short writes)
+    int error = 0;
+    bool patch = false;                 // rewrite of an earlier region, written synchronously
+};
+
+
+/**
+ * @class FileHandle - positional I/O on a raw descriptor / HANDLE
+ */
+
+class FileHandle {
+private:
+#if defined(_WIN32)
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+#else
+    int fd_ = -1;
+#endif
+
+public:
+    FileHandle() = default;
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+
+    ~FileHandle() { close(); }
+
+public:
+    bool open(const std::string& path, bool direct) {
+        close();
+#if defined(_WIN32)
+        DWORD flags = FILE_ATTRIBUTE_NORMAL | (direct ? FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH : 0);
+        handle_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, flags, nullptr);
+        return handle_ != INVALID_HANDLE_VALUE;
+#else
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    #if defined(O_DIRECT)
+        if (direct) flags |= O_DIRECT;
+    #endif
+        fd_ = ::open(path.c_str(), flags, 0644);
+        return fd_ >= 0;
+#endif
+    }
+
+    void close() {
+#if defined(_WIN32)
+        if (handle_ != INVALID_HANDLE_VALUE) CloseHandle(handle_);
+        handle_ = INVALID_HANDLE_VALUE;
+#else
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+#endif
+    }
+
+    /**
+     * write everything or return the error code (0 on success)
+     */
+    int writeAt(std::uint64_t offset, const char* data, std::size_t size) {
+        while (size > 0) {
+#if defined(_WIN32)
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+            DWORD chunk = size > (1u << 30) ? (1u << 30) : static_cast<DWORD>(size);
+            DWORD written = 0;
+            if (!WriteFile(handle_, data, chunk, &written, &overlapped)) return static_cast<int>(GetLastError());
+#else
+            ssize_t written = ::pwrite(fd_, data, size, static_cast<off_t>(offset));
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return errno;
+            }
+#endif
+            data += written;
+            offset += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return 0;
+    }
+
+    bool truncate(std::uint64_t size) {
+#if defined(_WIN32)
+        LARGE_INTEGER position;
+        position.QuadPart = static_cast<LONGLONG>(size);
+        return SetFilePointerEx(handle_, position, nullptr, FILE_BEGIN) && SetEndOfFile(handle_);
+#else
+        return ::ftruncate(fd_, static_cast<off_t>(size)) == 0;
+#endif
+    }
+
+#if !defined(_WIN32)
+    int fd() const noexcept { return fd_; }
+#endif
+};
+
+
+/**
+ * @class BFileBackend - submits blocks and reports them back once written
+ */
+
+class BFileBackend {
+protected:
+    FileHandle file_;
+
+public:
+    virtual ~BFileBackend() = default;
+
+public:
+    virtual bool open(const std::string& path, bool direct) {
+        return file_.open(path, direct);
+    }
+
+    virtual void close() {
+        file_.close();
+    }
+
+    bool truncate(std::uint64_t size) {
+        return file_.truncate(size);
+    }
+
+    int writeAt(std::uint64_t offset, const char* data, std::size_t size) {
+        return file_.writeAt(offset, data, size);
+    }
+
+    // queue a write of block->data[done, size) at block->offset + done
+    virtual void submit(WriteBlock* block) = 0;
+    // a block whose write finished (or failed, see block->error); nullptr if none yet
+    virtual WriteBlock* reap(bool wait) = 0;
+
+    virtual unsigned depth() const noexcept = 0;
+    virtual const char* name() const noexcept = 0;
+};
+
+
+/**
+ * @class PwriteBackend - portable, one synchronous positional write per block
+ */
+
+class PwriteBackend : public BFileBackend {
+private:
+    std::deque<WriteBlock*> completed_;
+
+public:
+    void submit(WriteBlock* block) override {
+        block->error = file_.writeAt(block->offset + block->done, block->data + block->done, block->size - block->done);
+        if (block->error == 0) block->done = block->size;
+        completed_.push_back(block);
+    }
+
+    WriteBlock* reap(bool) override {
+        if (completed_.empty()) return nullptr;
+
+        WriteBlock* block = completed_.front();
+        completed_.pop_front();
+        return block;
+    }
+
+    unsigned depth() const noexcept override { return 1; }
+    const char* name() const noexcept override { return "pwrite"; }
+};
+
+
+#if defined(SYNCORDER_IO_URING)
+
+/**
+ * @class UringBackend - io_uring through the raw syscalls (no liburing)
+ *
+ * Only the writer thread touches the rings, so the SQ tail / CQ head need no
+ * locking, just release / acquire against the kernel side.
+ */
+
+class UringBackend : public BFileBackend {
+private:
+    int ring_ = -1;
+    unsigned entries_ = 0;
+
+    // submission queue
+    void* sq_map_ = nullptr;
+    std::size_t sq_map_size_ = 0;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_mask_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+
+    // completion queue
+    void* cq_map_ = nullptr;
+    std::size_t cq_map_size_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_mask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+
+public:
+    ~UringBackend() override { close(); }
+
+public:
+    bool open(const std::string& path, bool direct) override {
+        if (!_setup(FILE_WRITER_QUEUE_DEPTH)) return false;
+        return BFileBackend::open(path, direct);
+    }
+
+    void close() override {
+        BFileBackend::close();
+
+        if (sqes_) munmap(sqes_, sqes_size_);
+        if (cq_map_ && cq_map_ != sq_map_) munmap(cq_map_, cq_map_size_);
+        if (sq_map_) munmap(sq_map_, sq_map_size_);
+        if (ring_ >= 0) ::close(ring_);
+
+        sqes_ = nullptr;
+        sq_map_ = cq_map_ = nullptr;
+        ring_ = -1;
+    }
+
+    void submit(WriteBlock* block) override {
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & *sq_mask_;
+
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = file_.fd();
+        sqe->addr = reinterpret_cast<std::uint64_t>(block->data + block->done);
+        sqe->len = static_cast<std::uint32_t>(block->size - block->done);
+        sqe->off = block->offset + block->done;
+        sqe->user_data = reinterpret_cast<std::uint64_t>(block);
+
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+        while (_enter(1, 0, 0) < 0 && errno == EINTR) {}
+    }
+
+    WriteBlock* reap(bool wait) override {
+        for (;;) {
+            unsigned head = *cq_head_;
+            if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                if (!wait) return nullptr;
+                if (_enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) return nullptr;
+                continue;
+            }
+
+            io_uring_cqe* cqe = &cqes_[head & *cq_mask_];
+            WriteBlock* block = reinterpret_cast<WriteBlock*>(cqe->user_data);
+            int result = cqe->res;
+            __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+
+            if (result == -EINTR || result == -EAGAIN) {
+                submit(block);
+                continue;
+            }
+            if (result < 0) {
+                block->error = -result;
+                return block;
+            }
+
+            block->done += static_cast<std::size_t>(result);
+            if (block->done < block->size && result > 0) {
+                submit(block);      // short write, queue the remainder
+                continue;
+            }
+            if (block->done < block->size) block->error = EIO;
+            return block;
+        }
+    }
+
+    unsigned depth() const noexcept override { return entries_; }
+    const char* name() const noexcept override { return "uring"; }
+
+private:
+    int _enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, ring_, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    bool _setup(unsigned entries) {
+        io_uring_params params = {};
+        ring_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (ring_ < 0) return false;
+
+        entries_ = params.sq_entries;
+        sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) sq_map_size_ = cq_map_size_ = (sq_map_size_ > cq_map_size_ ? sq_map_size_ : cq_map_size_);
+
+        sq_map_ = mmap(nullptr, sq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQ_RING);
+        if (sq_map_ == MAP_FAILED) { sq_map_ = nullptr; close(); return false; }
+
+        cq_map_ = single ? sq_map_ : mmap(nullptr, cq_map_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_CQ_RING);
+        if (cq_map_ == MAP_FAILED) { cq_map_ = nullptr; close(); return false; }
+
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) { close(); return false; }
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+        char* sq = static_cast<char*>(sq_map_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(cq_map_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        return true;
+    }
+};
+
+#endif
+
+
+/**
+ * @class AsyncFileWriter - double (n-)buffered append stream over a backend
+ *
+ * write() copies into the current block and hands it to the writer thread
+ * when full; the caller only waits when all blocks are still in flight
+ * (counted in stallNs). patch() rewrites an earlier region (e.g. a header
+ * page) after everything handed off before it has landed. Single producer.
+ */
+
+class AsyncFileWriter : public BFileSink {
+private:
+    FileWriterOptions options_;
+    std::unique_ptr<BFileBackend> backend_;
+
+    std::vector<WriteBlock> blocks_;
+    WriteBlock* current_ = nullptr;
+    std::uint64_t offset_ = 0;          // file offset of current_
+
+    // handoff
+    std::mutex mutex_;
+    std::condition_variable filled_cv_;
+    std::condition_variable free_cv_;
+    std::deque<WriteBlock*> filled_;
+    std::vector<WriteBlock*> free_;
+    bool stopping_ = false;
+
+    // writer thread
+    std::thread thread_;
+    unsigned in_flight_ = 0;
+
+    // metric
+    std::atomic<std::uint64_t> stall_ns_{0};
+    std::atomic<int> error_{0};
+
+public:
+    AsyncFileWriter() = default;
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    ~AsyncFileWriter() override { close(); }
+
+public:
+    bool open(const std::string& path, const FileWriterOptions& options) {
+        close();
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+
+        options_ = options;
+        options_.block_size = alignUp(options_.block_size ? options_.block_size : FILE_WRITER_BLOCK_SIZE);
+        if (options_.blocks < 2) options_.blocks = 2;
+
+        backend_ = _backend(path);
+        if (!backend_) return false;
+
+        blocks_.resize(options_.blocks);
+        for (auto& block : blocks_) {
+            block.data = static_cast<char*>(alignedAlloc(options_.block_size));
+            if (!block.data) { close(); return false; }
+            block.capacity = options_.block_size;
+        }
+
+        free_.clear();
+        for (std::size_t i = 1; i < blocks_.size(); ++i) free_.push_back(&blocks_[i]);
+        current_ = &blocks_[0];
+        current_->size = 0;
+
+        offset_ = 0;
+        stopping_ = false;
+        in_flight_ = 0;
+        stall_ns_.store(0, std::memory_order_relaxed);
+        error_.store(0, std::memory_order_relaxed);
+
+        thread_ = std::thread(&AsyncFileWriter::_loop, this);
+        return true;
+    }
+
+    void close() override {
+        if (thread_.joinable()) {
+            std::uint64_t logical = offset_ + current_->size;
+            if (current_->size > 0) _handoff(false);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            filled_cv_.notify_one();
+            thread_.join();
+
+            // drop the direct-mode padding
+            if (!backend_->truncate(logical)) _fail(EIO);
+            offset_ = logical;
+        }
+
+        if (backend_) backend_->close();
+        backend_.reset();
+
+        for (auto& block : blocks_) alignedFree(block.data);
+        blocks_.clear();
+        free_.clear();
+        filled_.clear();
+        current_ = nullptr;
+    }
+
+    bool is_open() const noexcept {
+        return backend_ != nullptr;
+    }
+
+    void write(const void* data, std::size_t size) override {
+        const char* bytes = static_cast<const char*>(data);
+
+        while (size > 0) {
+            std::size_t room = current_->capacity - current_->size;
+            std::size_t chunk = size < room ? size : room;
+
+            std::memcpy(current_->data + current_->size, bytes, chunk);
+            current_->size += chunk;
+            bytes += chunk;
+            size -= chunk;
+
+            if (current_->size == current_->capacity) _handoff(true);
+        }
+    }
+
+    /**
+     * overwrite [offset, offset + size) once every earlier write has landed;
+     * in direct mode offset and size must be FILE_WRITER_ALIGNMENT aligned
+     */
+    void patch(std::uint64_t offset, const void* data, std::size_t size) {
+        // the part still sitting in current_ is simply overwritten there
+        std::uint64_t begin = offset > offset_ ? offset : offset_;
+        std::uint64_t end = offset + size < offset_ + current_->size ? offset + size : offset_ + current_->size;
+        if (begin < end) {
+            std::memcpy(current_->data + (begin - offset_), static_cast<const char*>(data) + (begin - offset), end - begin);
+        }
+        if (offset >= offset_) return;
+
+        WriteBlock* block = new WriteBlock();
+        block->data = static_cast<char*>(alignedAlloc(alignUp(size)));
+        if (!block->data) { delete block; _fail(ENOMEM); return; }
+
+        std::memcpy(block->data, data, size);
+        block->capacity = alignUp(size);
+        block->size = size;
+        block->offset = offset;
+        block->patch = true;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            filled_.push_back(block);
+        }
+        filled_cv_.notify_one();
+    }
+
+    // logical stream size, including data not yet on disk
+    std::uint64_t bytes() const noexcept {
+        return offset_ + (current_ ? current_->size : 0);
+    }
+
+    std::uint64_t stallNs() const noexcept override {
+        return stall_ns_.load(std::memory_order_relaxed);
+    }
+
+    int error() const noexcept {
+        return error_.load(std::memory_order_relaxed);
+    }
+
+    const char* backend() const noexcept {
+        return backend_ ? backend_->name() : "closed";
+    }
+
+private:
+    std::unique_ptr<BFileBackend> _backend(const std::string& path) {
+#if defined(SYNCORDER_IO_URING)
+        if (options_.backend == WriterBackend::URING) {
+            auto uring = std::make_unique<UringBackend>();
+            if (uring->open(path, options_.direct)) return uring;
+        }
+#endif
+        auto fallback = std::make_unique<PwriteBackend>();
+        if (fallback->open(path, options_.direct)) return fallback;
+        return nullptr;
+    }
+
+    /**
+     * producer: queue current_ and take a free block (waits only if none)
+     */
+    void _handoff(bool take) {
+        WriteBlock* block = current_;
+        block->offset = offset_;
+        block->done = 0;
+        block->error = 0;
+        offset_ += block->size;
+
+        // direct I/O writes whole sectors; close() truncates the padding
+        if (options_.direct && block->size % FILE_WRITER_ALIGNMENT != 0) {
+            std::size_t padded = alignUp(block->size);
+            std::memset(block->data + block->size, 0, padded - block->size);
+            block->size = padded;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        filled_.push_back(block);
+        filled_cv_.notify_one();
+
+        if (!take) return;
+
+        if (free_.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            free_cv_.wait(lock, [&] { return !free_.empty(); });
+            addStall(stall_ns_, start);
+        }
+
+        current_ = free_.back();
+        free_.pop_back();
+        current_->size = 0;
+    }
+
+    /**
+     * writer thread: submit filled blocks in order, recycle completed ones
+     */
+    void _loop() {
+        std::deque<WriteBlock*> jobs;
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (in_flight_ == 0) filled_cv_.wait(lock, [&] { return !filled_.empty() || stopping_; });
+                jobs.swap(filled_);
+                if (jobs.empty() && stopping_ && in_flight_ == 0) return;
+            }
+
+            for (WriteBlock* block : jobs) {
+                if (block->patch) {
+                    while (in_flight_ > 0) _complete(backend_->reap(true));
+                    int error = backend_->writeAt(block->offset, block->data, block->size);
+                    if (error) _fail(error);
+                    alignedFree(block->data);
+                    delete block;
+                    continue;
+                }
+
+                while (in_flight_ >= backend_->depth()) _complete(backend_->reap(true));
+                backend_->submit(block);
+                ++in_flight_;
+            }
+            jobs.clear();
+
+            while (WriteBlock* block = backend_->reap(false)) _complete(block);
+            if (in_flight_ > 0) {
+                bool idle;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    idle = filled_.empty();
+                }
+                if (idle) _complete(backend_->reap(true));
+            }
+        }
+    }
+
+    void _complete(WriteBlock* block) {
+        if (!block) {
+            // the ring itself failed; give every block back so the producer never hangs
+            _fail(EIO);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_.clear();
+                for (auto& owned : blocks_) {
+                    bool queued = std::find(filled_.begin(), filled_.end(), &owned) != filled_.end();
+                    if (&owned != current_ && !queued) free_.push_back(&owned);
+                }
+            }
+            free_cv_.notify_one();
+            in_flight_ = 0;
+            return;
+        }
+        if (block->error) _fail(block->error);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(block);
+        }
+        free_cv_.notify_one();
+        --in_flight_;
+    }
+
+    void _fail(int error) {
+        int expected = 0;
+        error_.compare_exchange_strong(expected, error, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <filesystem>
+
+// local
+#include <Syncorder/devices/common/histogram.h>
+#include <Syncorder/devices/common/csv_writer.h>
+
+
+/**
+ * Online gaze <-> frame join
+ *
+ * TobiiBroker pushes gaze samples and RealsenseBroker pushes frames, both
+ * stamped with their ClockAligner time (host monotonic ns), so the two
+ * streams share one timeline. For every frame the joiner emits the gaze
+ * sample just before it, the one just after it and the gaze interpolated to
+ * the frame time: what used to be an offline join of the two CSVs.
+ *
+ * Watermark: the gaze stream arrives in time order, so a frame at time t is
+ * final once
+ *   - gaze has reached t (its "after" sample is in), or
+ *   - frames have reached t + tolerance (gaze is late; stop waiting for it), or
+ *   - capacity frames are pending.
+ * Tolerance is how long a frame waits for gaze behind it: set it above the
+ * Tobii broker's batching delay. Gaze arriving behind an emitted frame is
+ * counted as late and only kept as a "before" for later frames. Gaze older
+ * than the last sample before the oldest pending frame is dropped, so memory
+ * stays at about tolerance worth of each stream and never above capacity
+ * entries per side.
+ *
+ * A side farther than tolerance from the frame is still reported but not used
+ * for the interpolated gaze. Both brokers call in from their own threads; a
+ * push is one short lock per batch, and emitted rows are written and flushed
+ * under it.
+ */
+
+/**
+ * @struct GazeSample - binocular gaze point on the display area (0..1)
+ */
+
+constexpr std::uint8_t GAZE_LEFT = 1 << 0;
+constexpr std::uint8_t GAZE_RIGHT = 1 << 1;
+
+struct GazeSample {
+    std::int64_t time_ns = 0;       // aligned host ns
+    float left_x = 0.0f;
+    float left_y = 0.0f;
+    float right_x = 0.0f;
+    float right_y = 0.0f;
+    std::uint8_t valid = 0;         // GAZE_LEFT | GAZE_RIGHT
+};
+
+/**
+ * @struct GazeFrame - one emitted join row
+ */
+
+constexpr std::uint8_t JOIN_BEFORE = 1 << 0;    // gaze_before present
+constexpr std::uint8_t JOIN_AFTER = 1 << 1;     // gaze_after present
+constexpr std::uint8_t JOIN_FORCED = 1 << 2;    // emitted on wait / capacity, gaze had not passed the frame
+constexpr std::uint8_t JOIN_LATE = 1 << 3;      // frame arrived behind an emitted frame
+
+struct GazeJoinFrame {
+    std::uint64_t frame_number = 0;
+    std::int64_t time_ns = 0;       // aligned host ns
+};
+
+struct GazeFrame {
+    GazeJoinFrame frame;
+    GazeSample before;
+    GazeSample after;
+    GazeSample gaze;                // interpolated to frame.time_ns
+    std::uint8_t flags = 0;
+};
+
+
+/**
+ * @helper: interpolation
+ */
+
+inline GazeSample interpolateGaze(const GazeSample* before, const GazeSample* after, std::int64_t time_ns) {
+    GazeSample gaze;
+    gaze.time_ns = time_ns;
+
+    if (!before && !after) return gaze;
+    if (!before || !after) {
+        gaze = before ? *before : *after;
+        gaze.time_ns = time_ns;
+        return gaze;
+    }
+
+    std::int64_t span = after->time_ns - before->time_ns;
+    float w = span > 0 ? static_cast<float>(static_cast<double>(time_ns - before->time_ns) / span) : 0.0f;
+    const GazeSample& nearest = w < 0.5f ? *before : *after;
+
+    // per eye: lerp when both sides saw it, else the side that did
+    auto eye = [&](std::uint8_t bit, float GazeSample::*x, float GazeSample::*y) {
+        bool b = before->valid & bit;
+        bool a = after->valid & bit;
+        if (b && a) {
+            gaze.*x = before->*x + (after->*x - before->*x) * w;
+            gaze.*y = before->*y + (after->*y - before->*y) * w;
+        }
+        else if (b || a) {
+            const GazeSample& side = b ? *before : *after;
+            gaze.*x = side.*x;
+            gaze.*y = side.*y;
+        }
+        else {
+            gaze.*x = nearest.*x;
+            gaze.*y = nearest.*y;
+        }
+        if (b || a) gaze.valid |= bit;
+    };
+    eye(GAZE_LEFT, &GazeSample::left_x, &GazeSample::left_y);
+    eye(GAZE_RIGHT, &GazeSample::right_x, &GazeSample::right_y);
+    return gaze;
+}
+
+
+/**
+ * @class GazeJoiner - watermark join of gaze samples onto frames (see above)
+ */
+
+class GazeJoiner {
+public:
+    using Handler = std::function<void(const GazeFrame&)>;
+
+private:
+    std::int64_t tolerance_ns_;
+    std::size_t capacity_;
+    Handler handler_;
+
+    std::mutex mutex_;
+    std::deque<GazeSample> gaze_;               // sorted by time
+    std::deque<GazeJoinFrame> frames_;          // pending, sorted by time
+    std::int64_t newest_gaze_ = std::numeric_limits<std::int64_t>::min();
+    std::int64_t newest_frame_ = std::numeric_limits<std::int64_t>::min();
+    std::int64_t emitted_until_ = std::numeric_limits<std::int64_t>::min();
+
+    CsvWriter csv_;
+
+    // metric
+    std::uint64_t emitted_ = 0;
+    std::uint64_t forced_ = 0;
+    std::uint64_t late_gaze_ = 0;
+    std::uint64_t late_frames_ = 0;
+    std::uint64_t dropped_gaze_ = 0;
+    std::size_t max_frames_ = 0;
+    std::size_t max_gaze_ = 0;
+    LatencyHistogram delay_;                    // stream head - frame time at emission
+
+public:
+    GazeJoiner(std::int64_t tolerance_ns, std::size_t capacity, Handler handler = nullptr)
+    :
+        tolerance_ns_(tolerance_ns > 0 ? tolerance_ns : 0),
+        capacity_(capacity > 0 ? capacity : 1),
+        handler_(std::move(handler))
+    {}
+
+    GazeJoiner(const GazeJoiner&) = delete;
+    GazeJoiner& operator=(const GazeJoiner&) = delete;
+
+    ~GazeJoiner() { close(); }
+
+    /**
+     * session instance shared by TobiiBroker and RealsenseBroker, writing
+     * path; drained and closed when the last broker lets go
+     */
+    static std::shared_ptr<GazeJoiner> shared(const std::string& path, const FileWriterOptions& options, std::int64_t tolerance_ns, std::size_t capacity) {
+        static std::mutex mutex;
+        static std::weak_ptr<GazeJoiner> instance;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto existing = instance.lock()) return existing;
+
+        auto joiner = std::make_shared<GazeJoiner>(tolerance_ns, capacity);
+        if (!joiner->open(path, options)) return nullptr;
+
+        instance = joiner;
+        return joiner;
+    }
+
+public:
+    /**
+     * rows to a CSV as well as the handler
+     */
+    bool open(const std::string& path, const FileWriterOptions& options = {}) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+        if (!csv_.open(path, options)) return false;
+
+        csv_.text("FrameNumber,FrameTime,Flags");
+        for (const char* side : {"Before", "After", "Gaze"}) {
+            for (const char* field : {"Time", "LeftX", "LeftY", "RightX", "RightY", "Valid"}) csv_.put(',').text(side).text(field);
+        }
+        csv_.put('\n');
+        csv_.flush();
+        return true;
+    }
+
+    void pushGaze(const GazeSample* samples, std::size_t count) {
+        if (!count) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const GazeSample& sample = samples[i];
+            if (sample.time_ns <= emitted_until_) ++late_gaze_;
+
+            if (gaze_.empty() || sample.time_ns >= gaze_.back().time_ns) gaze_.push_back(sample);
+            else gaze_.insert(std::upper_bound(gaze_.begin(), gaze_.end(), sample.time_ns, _gazeBefore), sample);
+            newest_gaze_ = std::max(newest_gaze_, sample.time_ns);
+        }
+        _advance();
+    }
+
+    void pushFrames(const GazeJoinFrame* frames, std::size_t count) {
+        if (!count) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const GazeJoinFrame& frame = frames[i];
+
+            // behind the watermark: join now with what is left
+            if (frame.time_ns < emitted_until_) {
+                ++late_frames_;
+                _emit(frame, JOIN_LATE);
+                continue;
+            }
+
+            if (frames_.empty() || frame.time_ns >= frames_.back().time_ns) frames_.push_back(frame);
+            else frames_.insert(std::upper_bound(frames_.begin(), frames_.end(), frame.time_ns, _frameBefore), frame);
+            newest_frame_ = std::max(newest_frame_, frame.time_ns);
+        }
+        _advance();
+    }
+
+    /**
+     * emit every pending frame with the gaze at hand and close the CSV
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!frames_.empty()) {
+            _emit(frames_.front(), _gazePassed(frames_.front()) ? 0 : JOIN_FORCED);
+            frames_.pop_front();
+        }
+        if (csv_.is_open()) {
+            csv_.close();
+            _report();
+        }
+    }
+
+public:
+    std::uint64_t emitted() { std::lock_guard<std::mutex> lock(mutex_); return emitted_; }
+    std::uint64_t forced() { std::lock_guard<std::mutex> lock(mutex_); return forced_; }
+    std::uint64_t lateGaze() { std::lock_guard<std::mutex> lock(mutex_); return late_gaze_; }
+    std::uint64_t lateFrames() { std::lock_guard<std::mutex> lock(mutex_); return late_frames_; }
+    std::uint64_t droppedGaze() { std::lock_guard<std::mutex> lock(mutex_); return dropped_gaze_; }
+    std::size_t maxPendingFrames() { std::lock_guard<std::mutex> lock(mutex_); return max_frames_; }
+    std::size_t maxHeldGaze() { std::lock_guard<std::mutex> lock(mutex_); return max_gaze_; }
+    const LatencyHistogram& delay() const noexcept { return delay_; }
+
+private:
+    static bool _gazeBefore(std::int64_t time_ns, const GazeSample& sample) { return time_ns < sample.time_ns; }
+    static bool _frameBefore(std::int64_t time_ns, const GazeJoinFrame& frame) { return time_ns < frame.time_ns; }
+
+    bool _gazePassed(const GazeJoinFrame& frame) const noexcept {
+        return newest_gaze_ != std::numeric_limits<std::int64_t>::min() && newest_gaze_ >= frame.time_ns;
+    }
+
+    /**
+     * emit what the watermark allows, then trim gaze no frame can use
+     */
+    void _advance() {
+        max_frames_ = std::max(max_frames_, frames_.size());
+        max_gaze_ = std::max(max_gaze_, gaze_.size());
+
+        while (!frames_.empty()) {
+            const GazeJoinFrame& frame = frames_.front();
+            bool gaze_passed = _gazePassed(frame);
+            bool waited = newest_frame_ - tolerance_ns_ >= frame.time_ns;
+            bool full = frames_.size() > capacity_;
+            if (!gaze_passed && !waited && !full) break;
+
+            _emit(frame, gaze_passed ? 0 : JOIN_FORCED);
+            frames_.pop_front();
+        }
+
+        // keep the last sample at or before the next frame (its "before") and everything after it;
+        // with no frame pending, the next one is expected no further back than tolerance
+        std::int64_t horizon = !frames_.empty() ? frames_.front().time_ns
+                             : gaze_.empty() ? emitted_until_ : std::max(emitted_until_, newest_gaze_ - tolerance_ns_);
+        while (gaze_.size() >= 2 && gaze_[1].time_ns <= horizon) gaze_.pop_front();
+        while (gaze_.size() > capacity_) {
+            gaze_.pop_front();
+            ++dropped_gaze_;
+        }
+
+        if (csv_.is_open()) csv_.flush();
+    }
+
+    void _emit(const GazeJoinFrame& frame, std::uint8_t flags) {
+        GazeFrame row;
+        row.frame = frame;
+
+        auto next = std::lower_bound(gaze_.begin(), gaze_.end(), frame.time_ns, [](const GazeSample& sample, std::int64_t time_ns) { return sample.time_ns < time_ns; });
+        const GazeSample* before = next != gaze_.begin() ? &*(next - 1) : nullptr;
+        const GazeSample* after = next != gaze_.end() ? &*next : nullptr;
+
+        if (before) { row.before = *before; flags |= JOIN_BEFORE; }
+        if (after) { row.after = *after; flags |= JOIN_AFTER; }
+        row.flags = flags;
+
+        // a side farther than tolerance is reported, not interpolated from
+        if (before && frame.time_ns - before->time_ns > tolerance_ns_) before = nullptr;
+        if (after && after->time_ns - frame.time_ns > tolerance_ns_) after = nullptr;
+        row.gaze = interpolateGaze(before, after, frame.time_ns);
+
+        ++emitted_;
+        if (flags & JOIN_FORCED) ++forced_;
+        emitted_until_ = std::max(emitted_until_, frame.time_ns);
+        delay_.record(std::max(newest_frame_, newest_gaze_) - frame.time_ns);
+
+        if (csv_.is_open()) _write(row);
+        if (handler_) handler_(row);
+    }
+
+    void _write(const GazeFrame& row) {
+        csv_
+            .integer(row.frame.frame_number).put(',')
+            .integer(row.frame.time_ns).put(',')
+            .integer(row.flags);
+        for (const GazeSample* side : {&row.before, &row.after, &row.gaze}) {
+            csv_
+                .put(',').integer(side->time_ns)
+                .put(',').floating(side->left_x)
+                .put(',').floating(side->left_y)
+                .put(',').floating(side->right_x)
+                .put(',').floating(side->right_y)
+                .put(',').integer(side->valid);
+        }
+        csv_.put('\n');
+    }
+
+    void _report() const {
+        std::cout << "[GazeJoin] " << emitted_ << " frames joined, " << forced_ << " without later gaze, "
+                  << late_gaze_ << " late gaze, " << late_frames_ << " late frames, " << dropped_gaze_ << " gaze dropped, "
+                  << "pending max " << max_frames_ << " frames / " << max_gaze_ << " gaze\n";
+        std::cout << "[GazeJoin] emit delay p50 " << delay_.percentile(50) / 1e6 << " ms, p99 " << delay_.percentile(99) / 1e6 << " ms\n";
+    }
+};
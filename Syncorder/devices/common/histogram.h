@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <cstdint>
+
+
+/**
+ * @class LatencyHistogram - log-linear (HDR-style) histogram of nanoseconds
+ *
+ * Every power of two is split into 2^SUB_BITS linear sub-buckets, so any
+ * recorded value is reported within 1 / 2^SUB_BITS (12.5%) of its true value
+ * over the full int64 range. record() is a handful of relaxed atomics and may
+ * be called from any thread; readers see a consistent-enough snapshot.
+ */
+
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 3;
+    static constexpr std::size_t SUB_COUNT = std::size_t(1) << SUB_BITS;
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets_;
+
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> min_{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> max_{0};
+
+public:
+    LatencyHistogram() noexcept { reset(); }
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+public:
+    void record(std::int64_t value_ns) noexcept {
+        std::uint64_t value = value_ns > 0 ? static_cast<std::uint64_t>(value_ns) : 0;
+
+        buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+
+        std::uint64_t current = min_.load(std::memory_order_relaxed);
+        while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+
+        current = max_.load(std::memory_order_relaxed);
+        while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+
+    void reset() noexcept {
+        for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count() const noexcept { return count_.load(std::memory_order_relaxed); }
+    std::uint64_t min() const noexcept { return count() ? min_.load(std::memory_order_relaxed) : 0; }
+    std::uint64_t max() const noexcept { return max_.load(std::memory_order_relaxed); }
+
+    double mean() const noexcept {
+        std::uint64_t n = count();
+        return n ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / n : 0.0;
+    }
+
+    /**
+     * upper bound of the bucket holding the p-th percentile (p in [0, 100]),
+     * clamped to the recorded max
+     */
+    std::uint64_t percentile(double p) const noexcept {
+        std::uint64_t n = count();
+        if (n == 0) return 0;
+
+        auto rank = static_cast<std::uint64_t>(p / 100.0 * static_cast<double>(n) + 0.5);
+        if (rank == 0) rank = 1;
+        if (rank > n) rank = n;
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                std::uint64_t upper = bucketUpper(i);
+                return upper < max() ? upper : max();
+            }
+        }
+        return max();
+    }
+
+    /**
+     * fn(lower_ns, upper_ns, count) for every non-empty bucket, ascending
+     */
+    template<typename Fn>
+    void forEachBucket(Fn fn) const {
+        for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+            std::uint64_t n = buckets_[i].load(std::memory_order_relaxed);
+            if (n) fn(bucketLower(i), bucketUpper(i), n);
+        }
+    }
+
+public:
+    static std::size_t bucketIndex(std::uint64_t value) noexcept {
+        if (value < SUB_COUNT) return static_cast<std::size_t>(value);
+
+        unsigned exponent = 63;
+        while (!(value >> exponent)) --exponent;
+
+        std::size_t sub = static_cast<std::size_t>(value >> (exponent - SUB_BITS)) & (SUB_COUNT - 1);
+        return (exponent - SUB_BITS + 1) * SUB_COUNT + sub;
+    }
+
+    static std::uint64_t bucketLower(std::size_t index) noexcept {
+        if (index < SUB_COUNT) return index;
+
+        unsigned exponent = static_cast<unsigned>(index / SUB_COUNT) + SUB_BITS - 1;
+        std::uint64_t sub = index % SUB_COUNT;
+        return (std::uint64_t(1) << exponent) + (sub << (exponent - SUB_BITS));
+    }
+
+    static std::uint64_t bucketUpper(std::size_t index) noexcept {
+        if (index < SUB_COUNT) return index;
+
+        unsigned exponent = static_cast<unsigned>(index / SUB_COUNT) + SUB_BITS - 1;
+        return bucketLower(index) + (std::uint64_t(1) << (exponent - SUB_BITS)) - 1;
+    }
+};
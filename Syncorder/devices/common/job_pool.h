@@ -0,0 +1,162 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+// local
+#include <Syncorder/devices/common/buffer_base.h>
+#include <Syncorder/devices/common/histogram.h>
+
+
+/**
+ * @class JobPool - bounded job queue drained by a fixed set of workers
+ *
+ * For work too heavy for the broker thread (image encoding): the broker
+ * submits, workers run handler(job) in parallel. The queue holds at most
+ * capacity jobs; when it is full submit() follows the buffers' OverflowPolicy:
+ *   RejectNewest     - drop the submitted job
+ *   OverwriteOldest  - drop the oldest queued job, queue the new one
+ *   Block            - wait up to block_timeout for a slot, then drop
+ * (Spill has no meaning here and behaves as RejectNewest.) Dropped jobs are
+ * destroyed on the submitting thread, outside the lock; Job must be default
+ * constructible and movable.
+ *
+ * Queue depth and handler time (job_time, ns) are tracked for reporting;
+ * shutdown() runs every job still queued before joining.
+ */
+
+template<typename Job>
+class JobPool {
+private:
+    std::deque<Job> queue_;
+    std::size_t capacity_;
+    OverflowPolicy policy_;
+    std::chrono::microseconds block_timeout_;
+    std::function<void(Job&)> handler_;
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::vector<std::thread> workers_;
+    bool stopping_ = false;
+
+    // stats
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> completed_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::size_t> depth_{0};
+    std::atomic<std::size_t> max_depth_{0};
+    LatencyHistogram job_time_;
+
+public:
+    JobPool(std::size_t workers, std::size_t capacity, OverflowPolicy policy, std::chrono::microseconds block_timeout, std::function<void(Job&)> handler)
+    :
+        capacity_(std::max<std::size_t>(1, capacity)),
+        policy_(policy),
+        block_timeout_(block_timeout),
+        handler_(std::move(handler))
+    {
+        workers = std::max<std::size_t>(1, workers);
+        for (std::size_t i = 0; i < workers; ++i) workers_.emplace_back(&JobPool::_work, this);
+    }
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    ~JobPool() { shutdown(); }
+
+public:
+    /**
+     * queue a job; false when the job was dropped instead
+     */
+    bool submit(Job job) {
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+        std::optional<Job> evicted;   // outlives the lock, so it is destroyed unlocked
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= capacity_ && !stopping_) {
+            if (policy_ == OverflowPolicy::Block) {
+                not_full_.wait_for(lock, block_timeout_, [&] { return queue_.size() < capacity_ || stopping_; });
+            } else if (policy_ == OverflowPolicy::OverwriteOldest) {
+                evicted.emplace(std::move(queue_.front()));
+                queue_.pop_front();
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (queue_.size() >= capacity_ || stopping_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        queue_.push_back(std::move(job));
+        _trackDepth(queue_.size());
+        lock.unlock();
+
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * finish the queued jobs, then stop the workers
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_ && workers_.empty()) return;
+            stopping_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+
+        for (auto& worker : workers_) if (worker.joinable()) worker.join();
+        workers_.clear();
+    }
+
+public:
+    std::size_t depth() const noexcept { return depth_.load(std::memory_order_relaxed); }
+    std::size_t maxDepth() const noexcept { return max_depth_.load(std::memory_order_relaxed); }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    std::uint64_t submitted() const noexcept { return submitted_.load(std::memory_order_relaxed); }
+    std::uint64_t completed() const noexcept { return completed_.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    const LatencyHistogram& jobTime() const noexcept { return job_time_; }
+
+private:
+    void _trackDepth(std::size_t depth) {
+        depth_.store(depth, std::memory_order_relaxed);
+        if (depth > max_depth_.load(std::memory_order_relaxed)) max_depth_.store(depth, std::memory_order_relaxed);
+    }
+
+    void _work() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait(lock, [&] { return !queue_.empty() || stopping_; });
+                if (queue_.empty()) return;      // stopping and drained
+
+                job = std::move(queue_.front());
+                queue_.pop_front();
+                depth_.store(queue_.size(), std::memory_order_relaxed);
+            }
+            not_full_.notify_one();
+
+            auto start = std::chrono::steady_clock::now();
+            handler_(job);
+            job_time_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            completed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
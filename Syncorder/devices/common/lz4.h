@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+/**
+ * LZ4 block format codec - greedy single-pass compressor + bounds-checked decoder
+ *
+ * Output is a plain LZ4 block (no frame header), so any LZ4 implementation
+ * (lz4.block.decompress, LZ4_decompress_safe) can read it back. Tuned for
+ * speed over ratio: one hash probe per position with skip acceleration on
+ * incompressible input, which is what a recording path can afford.
+ */
+
+constexpr int LZ4_HASH_LOG = 14;
+constexpr std::size_t LZ4_MIN_MATCH = 4;
+constexpr std::size_t LZ4_LAST_LITERALS = 5;     // a block always ends with >= 5 literals
+constexpr std::size_t LZ4_MFLIMIT = 12;          // no match may start in the last 12 bytes
+constexpr std::size_t LZ4_MAX_DISTANCE = 65535;
+
+inline std::size_t lz4Bound(std::size_t size) {
+    return size + size / 255 + 16;
+}
+
+inline std::uint32_t _lz4Read32(const std::uint8_t* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t _lz4Hash(std::uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_LOG);
+}
+
+inline std::uint8_t* _lz4Length(std::uint8_t* op, std::size_t length) {
+    for (; length >= 255; length -= 255) *op++ = 255;
+    *op++ = static_cast<std::uint8_t>(length);
+    return op;
+}
+
+inline std::uint8_t* _lz4Literals(std::uint8_t* op, const std::uint8_t* anchor, std::size_t literal, std::uint8_t match_nibble) {
+    std::uint8_t* token = op++;
+    *token = static_cast<std::uint8_t>(((literal >= 15 ? 15 : literal) << 4) | match_nibble);
+    if (literal >= 15) op = _lz4Length(op, literal - 15);
+
+    if (literal) std::memcpy(op, anchor, literal);
+    return op + literal;
+}
+
+/**
+ * compress size bytes into destination (capacity >= lz4Bound(size));
+ * returns the compressed size, 0 if capacity is too small
+ */
+inline std::size_t lz4Compress(const void* source, std::size_t size, void* destination, std::size_t capacity) {
+    if (capacity < lz4Bound(size)) return 0;
+
+    const std::uint8_t* src = static_cast<const std::uint8_t*>(source);
+    const std::uint8_t* ip = src;
+    const std::uint8_t* anchor = src;
+    const std::uint8_t* end = src + size;
+    std::uint8_t* dst = static_cast<std::uint8_t*>(destination);
+    std::uint8_t* op = dst;
+
+    if (size > LZ4_MFLIMIT) {
+        static thread_local std::uint32_t table[1 << LZ4_HASH_LOG];
+        std::memset(table, 0, sizeof(table));
+
+        const std::uint8_t* match_limit = end - LZ4_LAST_LITERALS;
+        const std::uint8_t* ip_limit = end - LZ4_MFLIMIT;
+        unsigned misses = 0;
+
+        while (ip <= ip_limit) {
+            std::uint32_t sequence = _lz4Read32(ip);
+            std::uint32_t hash = _lz4Hash(sequence);
+            const std::uint8_t* ref = src + table[hash];
+            table[hash] = static_cast<std::uint32_t>(ip - src);
+
+            if (ref >= ip || static_cast<std::size_t>(ip - ref) > LZ4_MAX_DISTANCE || _lz4Read32(ref) != sequence) {
+                ip += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            // extend backwards into pending literals, then forwards
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) { --ip; --ref; }
+
+            const std::uint8_t* mp = ip + LZ4_MIN_MATCH;
+            const std::uint8_t* rp = ref + LZ4_MIN_MATCH;
+            while (mp < match_limit && *mp == *rp) { ++mp; ++rp; }
+
+            std::size_t literal = static_cast<std::size_t>(ip - anchor);
+            std::size_t match = static_cast<std::size_t>(mp - ip) - LZ4_MIN_MATCH;
+            std::size_t offset = static_cast<std::size_t>(ip - ref);
+
+            op = _lz4Literals(op, anchor, literal, static_cast<std::uint8_t>(match >= 15 ? 15 : match));
+            *op++ = static_cast<std::uint8_t>(offset & 0xff);
+            *op++ = static_cast<std::uint8_t>(offset >> 8);
+            if (match >= 15) op = _lz4Length(op, match - 15);
+
+            ip = mp;
+            anchor = ip;
+        }
+    }
+
+    op = _lz4Literals(op, anchor, static_cast<std::size_t>(end - anchor), 0);
+    return static_cast<std::size_t>(op - dst);
+}
+
+/**
+ * decompress into destination; returns the decompressed size, or -1 if the
+ * block is malformed or would overrun capacity
+ */
+inline long long lz4Decompress(const void* source, std::size_t size, void* destination, std::size_t capacity) {
+    const std::uint8_t* ip = static_cast<const std::uint8_t*>(source);
+    const std::uint8_t* iend = ip + size;
+    std::uint8_t* dst = static_cast<std::uint8_t*>(destination);
+    std::uint8_t* op = dst;
+    std::uint8_t* oend = dst + capacity;
+
+    auto length = [&](std::size_t& value) {
+        std::uint8_t byte;
+        do {
+            if (ip >= iend) return false;
+            byte = *ip++;
+            value += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+
+        std::size_t literal = token >> 4;
+        if (literal == 15 && !length(literal)) return -1;
+        if (literal > static_cast<std::size_t>(iend - ip) || literal > static_cast<std::size_t>(oend - op)) return -1;
+
+        if (literal) std::memcpy(op, ip, literal);
+        op += literal;
+        ip += literal;
+        if (ip == iend) break;      // last sequence carries literals only
+
+        if (iend - ip < 2) return -1;
+        std::size_t offset = ip[0] | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - dst)) return -1;
+
+        std::size_t match = token & 15;
+        if (match == 15 && !length(match)) return -1;
+        match += LZ4_MIN_MATCH;
+        if (match > static_cast<std::size_t>(oend - op)) return -1;
+
+        const std::uint8_t* ref = op - offset;
+        if (offset >= match) {
+            std::memcpy(op, ref, match);
+        } else {
+            for (std::size_t i = 0; i < match; ++i) op[i] = ref[i];     // overlapping run
+        }
+        op += match;
+    }
+
+    return static_cast<long long>(op - dst);
+}
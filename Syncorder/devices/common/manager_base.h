@@ -1,10 +1,21 @@
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <cstdint>
+
+// local
+#include <Syncorder/devices/common/metrics.h>
+#include <Syncorder/devices/common/start_barrier.h>
+#include <Syncorder/devices/common/stage_pool.h>
 
 
 /**
  * @class Base Manager
+ *
+ * Stage calls run on the orchestrator's StagePool and get a CancelToken with
+ * this manager's deadline: check token.cancelled() between steps and return
+ * false once it is, so a cancelled stage frees its worker.
  */
 
 class BManager {
@@ -12,14 +23,32 @@ public:
     virtual ~BManager() = default;
 
 public:
-    virtual bool setup() = 0;
-    virtual bool warmup() = 0;
-    virtual bool start() = 0;
-    virtual bool stop() = 0;
-    virtual bool cleanup() = 0;
+    virtual bool setup(const CancelToken& token) = 0;
+    virtual bool warmup(const CancelToken& token) = 0;
+    virtual bool start(const CancelToken& token) = 0;
+    virtual bool stop(const CancelToken& token) = 0;
+    virtual bool cleanup(const CancelToken& token) = 0;
 
     virtual std::string __name__() const = 0;
 
+    /**
+     * lock-free snapshot of the manager's stream; safe while recording
+     */
+    virtual StreamMetrics metrics() const {
+        StreamMetrics metrics;
+        metrics.name = __name__();
+        return metrics;
+    }
+
+    /**
+     * set before start(): the buffer gate opens at the barrier's instant
+     * instead of as soon as start() runs
+     */
+    void setStartBarrier(const StartBarrier* barrier) { start_barrier_ = barrier; }
+
+    // capture tick the buffer gate opened at (0 before start)
+    std::int64_t startedTicks() const { return started_ticks_.load(); }
+
     virtual bool __is_setup__() const { return is_setup_.load(); }
     virtual bool __is_warmup__() const { return is_warmup_.load(); }
     virtual bool __is_running__() const { return is_running_.load(); }
@@ -28,4 +57,7 @@ protected:
     std::atomic<bool> is_setup_{false};
     std::atomic<bool> is_warmup_{false};
     std::atomic<bool> is_running_{false};
+
+    const StartBarrier* start_barrier_ = nullptr;
+    std::atomic<std::int64_t> started_ticks_{0};
 };
\ No newline at end of file
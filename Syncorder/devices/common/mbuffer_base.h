@@ -0,0 +1,196 @@
+#pragma once
+
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <algorithm>
+
+// local
+#include <Syncorder/devices/common/eventcount.h>
+#include <Syncorder/devices/common/buffer_base.h>
+
+
+/**
+ * @class Multi-producer Buffer - MPSC ring
+ *
+ * Same consumer interface as BBuffer (dequeue_n / signal / size / start /
+ * stop), so TBBroker<DataType, MBuffer<...>> works unchanged. Producers claim
+ * a slot by CAS on tail and publish it through the slot's sequence number;
+ * the single consumer hands the slot back by advancing the sequence by N.
+ *
+ * Overflow: RejectNewest and Block. OverwriteOldest and Spill would need the
+ * consumer's head to be contended and fall back to RejectNewest.
+ */
+
+template <typename T, std::size_t N>
+class MBuffer {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "MBuffer capacity must be a power of two");
+
+protected:
+    static constexpr std::size_t MASK = N - 1;
+
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+
+    // consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+
+    // producers
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+
+    // shared, read-mostly
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> gate_{true};
+    OverflowPolicy policy_ = OverflowPolicy::RejectNewest;
+    std::chrono::microseconds block_timeout_{2000};
+
+    std::atomic<std::uint64_t> dropped_{0};
+
+    // wakeup
+    alignas(CACHE_LINE_SIZE) EventCount signal_;
+
+    std::unique_ptr<Slot[]> m_slots;
+
+public:
+    MBuffer()
+    :
+        m_head(0),
+        m_tail(0),
+        gate_(true),
+        m_slots(new Slot[N])
+    {
+        for (std::size_t i = 0; i < N; ++i) m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+    virtual ~MBuffer() = default;
+
+public:
+    bool setOverflowPolicy(OverflowPolicy policy, const std::string& = "") {
+        bool supported = policy == OverflowPolicy::RejectNewest || policy == OverflowPolicy::Block;
+        policy_ = supported ? policy : OverflowPolicy::RejectNewest;
+        return supported;
+    }
+
+    void setBlockTimeout(std::chrono::microseconds timeout) {
+        block_timeout_ = timeout;
+    }
+
+    bool enqueue(T val) noexcept {
+        // gate
+        if (gate_.load(std::memory_order_acquire)) return false;
+
+        // claim
+        Slot* slot = _claim();
+        if (!slot && policy_ == OverflowPolicy::Block) slot = _block();
+        if (!slot) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // publish
+        std::size_t pos = slot->seq.load(std::memory_order_relaxed);
+        slot->value = std::move(val);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        signal_.notify();
+        return true;
+    }
+
+    std::optional<T> _dequeue() noexcept {
+        T value;
+        if (dequeue_n(&value, 1) == 0) return std::nullopt;
+        return std::optional<T>(std::move(value));
+    }
+
+    /**
+     * move up to max published elements into out; stops at the first slot a
+     * producer has claimed but not yet published, so order is preserved
+     */
+    std::size_t dequeue_n(T* out, std::size_t max) noexcept {
+        std::size_t current_head = m_head.load(std::memory_order_relaxed);
+
+        std::size_t count = 0;
+        while (count < max) {
+            Slot& slot = m_slots[(current_head + count) & MASK];
+            if (slot.seq.load(std::memory_order_acquire) != current_head + count + 1) break;
+
+            out[count] = std::move(slot.value);
+            slot.seq.store(current_head + count + N, std::memory_order_release);
+            ++count;
+        }
+
+        if (count) m_head.store(current_head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * open the gate, at the barrier's instant when one is given; returns the
+     * capture tick it opened at
+     */
+    std::int64_t start(const StartBarrier* barrier = nullptr) {
+        if (barrier) barrier->wait();
+        gate_.store(false, std::memory_order_release);
+        return timestamps().now();
+    }
+
+    void stop() {
+        gate_.store(true, std::memory_order_release);
+    }
+
+    EventCount& signal() noexcept {
+        return signal_;
+    }
+
+    std::size_t size() const noexcept {
+        std::size_t current_head = m_head.load(std::memory_order_acquire);
+        std::size_t current_tail = m_tail.load(std::memory_order_acquire);
+        return current_tail > current_head ? current_tail - current_head : 0;
+    }
+
+    static constexpr std::size_t capacity() noexcept {
+        return N;
+    }
+
+    // counters (lock-free, any thread)
+    std::uint64_t enqueued() const noexcept { return m_tail.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t overwritten() const noexcept { return 0; }
+    std::uint64_t spilled() const noexcept { return 0; }
+
+private:
+    /**
+     * returns the claimed slot with seq still == pos, or nullptr when full
+     */
+    Slot* _claim() noexcept {
+        std::size_t pos = m_tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            Slot& slot = m_slots[pos & MASK];
+            std::size_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return &slot;
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Slot* _block() noexcept {
+        auto deadline = std::chrono::steady_clock::now() + block_timeout_;
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+
+            if (Slot* slot = _claim()) return slot;
+            if (gate_.load(std::memory_order_acquire)) return nullptr;
+        }
+        return nullptr;
+    }
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <filesystem>
+#include <condition_variable>
+
+
+/**
+ * @struct StreamMetrics - point-in-time snapshot of one stream
+ *
+ * Every field is read from relaxed atomics owned by the buffer / broker, so a
+ * snapshot never blocks the capture path and may be taken from any thread.
+ */
+
+struct StreamMetrics {
+    std::string name;
+
+    // buffer
+    std::uint64_t samples_in = 0;       // accepted by enqueue (ring + spill)
+    std::uint64_t dropped = 0;
+    std::uint64_t overwritten = 0;
+    std::uint64_t spilled = 0;
+    std::uint64_t occupancy = 0;        // size() at snapshot time
+    std::uint64_t capacity = 0;
+
+    // broker
+    std::uint64_t samples_out = 0;
+    std::uint64_t bytes_written = 0;
+    std::uint64_t stall_ns = 0;         // writer stall: blocked on the file writer
+    std::uint64_t process_ns = 0;       // time spent inside _process_batch
+
+    // clock alignment (ClockAligner)
+    double clock_offset_ms = 0.0;
+    double clock_drift_ppm = 0.0;
+    double clock_jitter_us = 0.0;
+
+    static const char* csvHeader() {
+        return "time_ms,stream,samples_in,samples_out,dropped,overwritten,spilled,occupancy,capacity,bytes_written,stall_ms,process_ms,"
+               "clock_offset_ms,clock_drift_ppm,clock_jitter_us\n";
+    }
+
+    void csvRow(std::ostream& os, std::int64_t time_ms) const {
+        os << time_ms << ","
+           << name << ","
+           << samples_in << ","
+           << samples_out << ","
+           << dropped << ","
+           << overwritten << ","
+           << spilled << ","
+           << occupancy << ","
+           << capacity << ","
+           << bytes_written << ","
+           << stall_ns / 1000000.0 << ","
+           << process_ns / 1000000.0 << ","
+           << clock_offset_ms << ","
+           << clock_drift_ppm << ","
+           << clock_jitter_us << "\n";
+    }
+};
+
+
+/**
+ * @helper: collect - snapshot any BBuffer / MBuffer + broker pair
+ */
+
+template<typename BufferType, typename BrokerType>
+StreamMetrics collectMetrics(const std::string& name, const BufferType& buffer, const BrokerType& broker) {
+    StreamMetrics metrics;
+    metrics.name = name;
+
+    metrics.samples_in = buffer.enqueued();
+    metrics.dropped = buffer.dropped();
+    metrics.overwritten = buffer.overwritten();
+    metrics.spilled = buffer.spilled();
+    metrics.occupancy = buffer.size();
+    metrics.capacity = buffer.capacity();
+
+    metrics.samples_out = broker.processed();
+    metrics.bytes_written = broker.bytesWritten();
+    metrics.stall_ns = broker.writerStallNs();
+    metrics.process_ns = broker.processNs();
+
+    metrics.clock_offset_ms = broker.clock().offsetMs();
+    metrics.clock_drift_ppm = broker.clock().driftPpm();
+    metrics.clock_jitter_us = broker.clock().jitterUs();
+
+    return metrics;
+}
+
+
+/**
+ * @class MetricsRecorder - appends a snapshot of every stream to a CSV file
+ * at a fixed interval, plus one final row set on stop()
+ */
+
+class MetricsRecorder {
+private:
+    std::function<std::vector<StreamMetrics>()> snapshot_;
+    std::ofstream csv_;
+
+    std::chrono::milliseconds interval_{1000};
+    std::chrono::steady_clock::time_point origin_;
+
+    // thread
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_ = false;
+
+public:
+    ~MetricsRecorder() { stop(); }
+
+public:
+    bool start(const std::string& path, std::chrono::milliseconds interval, std::function<std::vector<StreamMetrics>()> snapshot) {
+        stop();
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+
+        csv_.open(path);
+        if (!csv_.is_open()) return false;
+        csv_ << StreamMetrics::csvHeader();
+
+        snapshot_ = std::move(snapshot);
+        interval_ = interval;
+        origin_ = std::chrono::steady_clock::now();
+
+        running_ = true;
+        thread_ = std::thread(&MetricsRecorder::_loop, this);
+        return true;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) return;
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) thread_.join();
+
+        _record();
+        csv_.close();
+    }
+
+private:
+    void _loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!cv_.wait_for(lock, interval_, [&] { return !running_; })) {
+            lock.unlock();
+            _record();
+            lock.lock();
+        }
+    }
+
+    void _record() {
+        auto time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - origin_).count();
+
+        for (const auto& metrics : snapshot_()) metrics.csvRow(csv_, time_ms);
+        csv_.flush();
+    }
+};
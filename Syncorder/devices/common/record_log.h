@@ -0,0 +1,460 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <type_traits>
+
+#if defined(_WIN32)
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// local
+#include <Syncorder/devices/common/file_writer.h>
+
+
+/**
+ * Binary record log - fixed-width packed records behind a self-describing header
+ *
+ * [ RecordLogHeader | RecordField x field_count | zero pad ]  (RECORD_LOG_HEADER_SIZE bytes)
+ * [ record 0 ][ record 1 ] ...                                 (record_size bytes each)
+ *
+ * All integers are little-endian. The header is one page so the record array
+ * starts page-aligned and can be memory-mapped as Record[record_count]. The
+ * file is preallocated in RECORD_LOG_GROW_BYTES steps and truncated to the
+ * exact size on close; record_count is checkpointed on every grow and close.
+ * With an AsyncFileWriter backend the header page is re-patched at the same
+ * RECORD_LOG_GROW_BYTES cadence instead (no preallocation).
+ */
+
+constexpr char RECORD_LOG_MAGIC[8] = {'S', 'Y', 'N', 'C', 'R', 'E', 'C', '\0'};
+constexpr std::uint16_t RECORD_LOG_FORMAT = 1;
+constexpr std::uint32_t RECORD_LOG_HEADER_SIZE = 4096;
+constexpr std::uint64_t RECORD_LOG_GROW_BYTES = 64ull << 20;
+
+enum class FieldType : std::uint8_t {
+    I64 = 1,
+    I32 = 2,
+    F32 = 3,
+    BOOL = 4,
+    F64 = 5,
+    U16 = 6,
+    U64 = 7,
+    U8 = 8,
+};
+
+#pragma pack(push, 1)
+
+struct RecordField {
+    char name[40];
+    FieldType type;
+    std::uint8_t reserved[3];
+    std::uint32_t offset;
+};
+
+struct RecordLogHeader {
+    char magic[8];
+    std::uint16_t format;               // RECORD_LOG_FORMAT
+    std::uint16_t schema_version;       // Record::VERSION
+    std::uint32_t header_size;
+    std::uint32_t record_size;
+    std::uint32_t field_count;
+    std::uint64_t record_count;
+    char stream[32];
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(RecordField) == 48, "RecordField layout is part of the file format");
+static_assert(sizeof(RecordLogHeader) == 64, "RecordLogHeader layout is part of the file format");
+
+// 64-bit file offsets (long is 32-bit on Windows)
+inline std::int64_t fileTell(std::FILE* file) {
+#if defined(_WIN32)
+    return _ftelli64(file);
+#else
+    return static_cast<std::int64_t>(ftello(file));
+#endif
+}
+
+inline int fileSeek(std::FILE* file, std::int64_t offset) {
+#if defined(_WIN32)
+    return _fseeki64(file, offset, SEEK_SET);
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+/**
+ * extend a flushed file to size with real blocks (posix_fallocate /
+ * SetEndOfFile); only filesystems without fallocate fall back to a sparse
+ * ftruncate. The stdio position is left where it was.
+ */
+inline bool fileAllocate(std::FILE* file, std::uint64_t size) {
+#if defined(_WIN32)
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+    if (handle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER zero = {};
+    LARGE_INTEGER position;
+    if (!SetFilePointerEx(handle, zero, &position, FILE_CURRENT)) return false;
+
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(size);
+    bool allocated = SetFilePointerEx(handle, end, nullptr, FILE_BEGIN) && SetEndOfFile(handle);
+
+    SetFilePointerEx(handle, position, nullptr, FILE_BEGIN);
+    return allocated;
+#else
+    int fd = fileno(file);
+    int rc = posix_fallocate(fd, 0, static_cast<off_t>(size));
+    if (rc == 0) return true;
+    if (rc != EOPNOTSUPP && rc != EINVAL) return false;
+    return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+}
+
+inline RecordField recordField(const char* name, FieldType type, std::size_t offset) {
+    RecordField field = {};
+    std::strncpy(field.name, name, sizeof(field.name) - 1);
+    field.type = type;
+    field.offset = static_cast<std::uint32_t>(offset);
+    return field;
+}
+
+inline std::size_t fieldSize(FieldType type) {
+    switch (type) {
+        case FieldType::I64:
+        case FieldType::F64:
+        case FieldType::U64:  return 8;
+        case FieldType::I32:
+        case FieldType::F32:  return 4;
+        case FieldType::U16:  return 2;
+        case FieldType::BOOL:
+        case FieldType::U8:   return 1;
+    }
+    return 0;
+}
+
+
+/**
+ * @class RecordLog - appends Record structs to a preallocated file
+ *
+ * Record must be trivially copyable and provide:
+ *   static constexpr std::uint16_t VERSION;
+ *   static constexpr const char* STREAM;
+ *   static std::vector<RecordField> schema();
+ *
+ * stallNs() is the writer stall: time append_n() spent blocked on the disk
+ * (fwrite and preallocation, or the async writer's wait for a free block).
+ */
+
+template<typename Record>
+class RecordLog {
+    static_assert(std::is_trivially_copyable_v<Record>, "RecordLog needs a trivially copyable record");
+
+private:
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::vector<char> io_buffer_;
+    std::unique_ptr<AsyncFileWriter> async_;
+    std::vector<char> header_;
+
+    std::uint64_t count_ = 0;
+    std::uint64_t capacity_ = 0;
+    std::atomic<std::uint64_t> stall_ns_{0};      // INLINE: time inside fwrite / _grow
+
+public:
+    RecordLog() = default;
+    RecordLog(const RecordLog&) = delete;
+    RecordLog& operator=(const RecordLog&) = delete;
+
+    ~RecordLog() { close(); }
+
+public:
+    bool open(const std::string& path, const FileWriterOptions& options = {}) {
+        close();
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+
+        path_ = path;
+        count_ = 0;
+        capacity_ = 0;
+        stall_ns_.store(0, std::memory_order_relaxed);
+
+        // SEGMENT applies to text streams; a record log is one file with one header
+        if (options.backend != WriterBackend::INLINE && options.backend != WriterBackend::SEGMENT) {
+            async_ = std::make_unique<AsyncFileWriter>();
+            if (!async_->open(path, options) || !_buildHeader()) {
+                async_.reset();
+                return false;
+            }
+            async_->write(header_.data(), header_.size());
+            return true;
+        }
+
+        file_ = std::fopen(path.c_str(), "w+b");
+        if (!file_) return false;
+
+        io_buffer_.resize(1 << 20);
+        std::setvbuf(file_, io_buffer_.data(), _IOFBF, io_buffer_.size());
+
+        return _buildHeader() && std::fwrite(header_.data(), 1, header_.size(), file_) == header_.size() && _grow();
+    }
+
+    bool append(const Record& record) noexcept {
+        return append_n(&record, 1);
+    }
+
+    bool append_n(const Record* records, std::size_t count) noexcept {
+        if (async_) {
+            async_->write(records, count * sizeof(Record));
+            count_ += count;
+
+            if (count_ >= capacity_) {
+                capacity_ = count_ + RECORD_LOG_GROW_BYTES / sizeof(Record);
+                _checkpoint();
+            }
+            return async_->error() == 0;
+        }
+        if (!file_) return false;
+
+        auto start = std::chrono::steady_clock::now();
+        while (count_ + count > capacity_) {
+            if (!_grow()) return false;
+        }
+
+        std::size_t written = std::fwrite(records, sizeof(Record), count, file_);
+        addStall(stall_ns_, start);
+
+        count_ += written;
+        return written == count;
+    }
+
+    void close() {
+        if (async_) {
+            _checkpoint();
+            async_->close();
+            async_.reset();
+            path_.clear();
+            return;
+        }
+        if (!file_) return;
+
+        _checkpoint();
+        std::fclose(file_);
+        file_ = nullptr;
+
+        // drop the unused preallocated tail
+        std::error_code ec;
+        std::filesystem::resize_file(path_, RECORD_LOG_HEADER_SIZE + count_ * sizeof(Record), ec);
+        path_.clear();
+    }
+
+    std::uint64_t count() const noexcept {
+        return count_;
+    }
+
+    std::uint64_t bytes() const noexcept {
+        return RECORD_LOG_HEADER_SIZE + count_ * sizeof(Record);
+    }
+
+    std::uint64_t stallNs() const noexcept {
+        return async_ ? async_->stallNs() : stall_ns_.load(std::memory_order_relaxed);
+    }
+
+private:
+    bool _buildHeader() {
+        std::vector<RecordField> fields = Record::schema();
+        if (sizeof(RecordLogHeader) + fields.size() * sizeof(RecordField) > RECORD_LOG_HEADER_SIZE) return false;
+
+        RecordLogHeader header = {};
+        std::memcpy(header.magic, RECORD_LOG_MAGIC, sizeof(header.magic));
+        header.format = RECORD_LOG_FORMAT;
+        header.schema_version = Record::VERSION;
+        header.header_size = RECORD_LOG_HEADER_SIZE;
+        header.record_size = static_cast<std::uint32_t>(sizeof(Record));
+        header.field_count = static_cast<std::uint32_t>(fields.size());
+        header.record_count = 0;
+        std::strncpy(header.stream, Record::STREAM, sizeof(header.stream) - 1);
+
+        header_.assign(RECORD_LOG_HEADER_SIZE, 0);
+        std::memcpy(header_.data(), &header, sizeof(header));
+        if (!fields.empty()) std::memcpy(header_.data() + sizeof(header), fields.data(), fields.size() * sizeof(RecordField));
+
+        return true;
+    }
+
+    /**
+     * allocate the next RECORD_LOG_GROW_BYTES of records up front (fileAllocate)
+     * so appends do not allocate file-system blocks one flush at a time
+     */
+    bool _grow() {
+        std::uint64_t step = RECORD_LOG_GROW_BYTES / sizeof(Record);
+        if (step == 0) step = 1;
+
+        _checkpoint();
+        if (!fileAllocate(file_, RECORD_LOG_HEADER_SIZE + (capacity_ + step) * sizeof(Record))) return false;
+
+        capacity_ += step;
+        return true;
+    }
+
+    void _checkpoint() {
+        if (async_) {
+            // whole page, so the patch stays valid under direct I/O
+            std::memcpy(header_.data() + offsetof(RecordLogHeader, record_count), &count_, sizeof(count_));
+            async_->patch(0, header_.data(), header_.size());
+            return;
+        }
+
+        std::fflush(file_);
+
+        std::int64_t position = fileTell(file_);
+        fileSeek(file_, static_cast<std::int64_t>(offsetof(RecordLogHeader, record_count)));
+        std::fwrite(&count_, sizeof(count_), 1, file_);
+        fileSeek(file_, position);
+    }
+};
+
+
+/**
+ * @class RecordLogReader - validates the header and streams records back
+ *
+ * Files written with an older Record::VERSION are decoded through their own
+ * field table: each field of the current schema is copied from the file field
+ * with the same name and type, and fields the old version did not have read
+ * as 0. Newer versions are rejected.
+ */
+
+template<typename Record>
+class RecordLogReader {
+private:
+    struct FieldCopy {
+        std::uint32_t from;
+        std::uint32_t to;
+        std::uint32_t size;
+    };
+
+    std::FILE* file_ = nullptr;
+    RecordLogHeader header_ = {};
+    std::vector<RecordField> fields_;
+    std::vector<FieldCopy> copies_;     // empty when the file is the current version
+    std::vector<char> raw_;
+    std::uint64_t read_ = 0;
+
+public:
+    RecordLogReader() = default;
+    RecordLogReader(const RecordLogReader&) = delete;
+    RecordLogReader& operator=(const RecordLogReader&) = delete;
+
+    ~RecordLogReader() { close(); }
+
+public:
+    /**
+     * returns an empty string on success, otherwise why the file was rejected
+     */
+    std::string open(const std::string& path) {
+        close();
+
+        file_ = std::fopen(path.c_str(), "rb");
+        if (!file_) return "cannot open " + path;
+
+        if (std::fread(&header_, sizeof(header_), 1, file_) != 1) return "truncated header";
+        if (std::memcmp(header_.magic, RECORD_LOG_MAGIC, sizeof(header_.magic)) != 0) return "not a record log";
+        if (header_.format != RECORD_LOG_FORMAT) return "unsupported format " + std::to_string(header_.format);
+        if (header_.schema_version > Record::VERSION) return "unsupported schema version " + std::to_string(header_.schema_version);
+        if (std::strncmp(header_.stream, Record::STREAM, sizeof(header_.stream)) != 0) return "stream mismatch";
+        if (sizeof(RecordLogHeader) + std::uint64_t(header_.field_count) * sizeof(RecordField) > header_.header_size) return "truncated field table";
+
+        fields_.resize(header_.field_count);
+        if (!fields_.empty() && std::fread(fields_.data(), sizeof(RecordField), fields_.size(), file_) != fields_.size()) return "truncated field table";
+
+        if (header_.schema_version == Record::VERSION) {
+            if (header_.record_size != sizeof(Record)) return "record size mismatch";
+        } else {
+            std::string error = _mapFields();
+            if (!error.empty()) return error;
+        }
+
+        fileSeek(file_, header_.header_size);
+        read_ = 0;
+        return "";
+    }
+
+    void close() {
+        if (file_) std::fclose(file_);
+        file_ = nullptr;
+        fields_.clear();
+        copies_.clear();
+    }
+
+    const RecordLogHeader& header() const noexcept {
+        return header_;
+    }
+
+    /**
+     * the field table as written in the file
+     */
+    const std::vector<RecordField>& fields() const noexcept {
+        return fields_;
+    }
+
+    std::size_t read_n(Record* out, std::size_t max) {
+        if (!file_) return 0;
+
+        std::uint64_t remaining = header_.record_count - read_;
+        std::size_t count = static_cast<std::size_t>(remaining < max ? remaining : max);
+        if (count == 0) return 0;
+
+        if (copies_.empty()) {
+            count = std::fread(out, sizeof(Record), count, file_);
+            read_ += count;
+            return count;
+        }
+
+        raw_.resize(count * header_.record_size);
+        count = std::fread(raw_.data(), header_.record_size, count, file_);
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* from = raw_.data() + i * header_.record_size;
+            char* to = reinterpret_cast<char*>(out + i);
+
+            std::memset(to, 0, sizeof(Record));
+            for (const auto& copy : copies_) std::memcpy(to + copy.to, from + copy.from, copy.size);
+        }
+        read_ += count;
+        return count;
+    }
+
+private:
+    /**
+     * match the file's fields to the current schema by name and type
+     */
+    std::string _mapFields() {
+        for (const auto& field : Record::schema()) {
+            for (const auto& old : fields_) {
+                if (std::strncmp(old.name, field.name, sizeof(old.name)) != 0) continue;
+                if (old.type != field.type) return std::string("field ") + field.name + " changed type";
+
+                std::uint32_t size = static_cast<std::uint32_t>(fieldSize(field.type));
+                if (old.offset + size > header_.record_size) return std::string("field ") + field.name + " outside the record";
+
+                copies_.push_back({old.offset, field.offset, size});
+                break;
+            }
+        }
+        if (copies_.empty()) return "no fields in common with schema version " + std::to_string(Record::VERSION);
+        return "";
+    }
+};
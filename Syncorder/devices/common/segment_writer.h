@@ -0,0 +1,290 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+// local
+#include <Syncorder/devices/common/file_writer.h>
+
+
+/**
+ * @class SegmentWriter - preallocated, memory-mapped segment files
+ *
+ * "dir/name.csv" is written as dir/name_0000.csv, dir/name_0001.csv, ...
+ * Each segment is allocated to segment_bytes up front (posix_fallocate /
+ * SetEndOfFile), mapped, and filled with memcpy, so appends never touch file
+ * metadata. The next segment is prepared on a helper thread while the current
+ * one fills, which keeps rotation off the write path. A segment rotates when
+ * the next write does not fit or segment_seconds have passed; the last one is
+ * truncated to its used size on close.
+ *
+ * The first preamble_lines lines of the stream (a CSV header) are repeated at
+ * the top of every segment, so each file stands on its own.
+ *
+ * stallNs() counts rotations that had to wait for the next segment.
+ */
+
+class SegmentWriter : public BFileSink {
+private:
+    struct Segment {
+        std::string path;
+        char* base = nullptr;
+        std::uint64_t capacity = 0;
+        std::uint64_t used = 0;
+#if defined(_WIN32)
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int fd = -1;
+#endif
+    };
+
+    FileWriterOptions options_;
+    std::filesystem::path stem_;
+    std::string extension_;
+
+    Segment current_;
+    Segment next_;
+    std::thread prepare_;
+    unsigned index_ = 0;
+    std::chrono::steady_clock::time_point opened_at_;
+
+    // preamble
+    std::string preamble_;
+    int preamble_lines_ = 0;
+    int preamble_seen_ = 0;
+
+    std::uint64_t bytes_ = 0;
+    std::atomic<bool> failed_{false};
+    std::atomic<std::uint64_t> stall_ns_{0};
+
+public:
+    SegmentWriter() = default;
+    SegmentWriter(const SegmentWriter&) = delete;
+    SegmentWriter& operator=(const SegmentWriter&) = delete;
+
+    ~SegmentWriter() override { close(); }
+
+public:
+    bool open(const std::string& path, const FileWriterOptions& options, int preamble_lines = 0) {
+        close();
+
+        std::filesystem::path target(path);
+        if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path());
+
+        options_ = options;
+        options_.segment_bytes = alignUp(static_cast<std::size_t>(options_.segment_bytes ? options_.segment_bytes : FILE_WRITER_SEGMENT_BYTES));
+        stem_ = target.parent_path() / target.stem();
+        extension_ = target.extension().string();
+
+        preamble_.clear();
+        preamble_lines_ = preamble_lines;
+        preamble_seen_ = 0;
+        bytes_ = 0;
+        failed_ = false;
+        stall_ns_.store(0, std::memory_order_relaxed);
+        index_ = 0;
+
+        if (!_map(current_, _path(index_))) {
+            failed_ = true;
+            return false;
+        }
+        opened_at_ = std::chrono::steady_clock::now();
+        _prepareNext();
+        return true;
+    }
+
+    void close() override {
+        if (prepare_.joinable()) prepare_.join();
+
+        // the spare segment was never written
+        if (!next_.path.empty()) {
+            std::string spare = next_.path;
+            _unmap(next_, 0);
+            std::remove(spare.c_str());
+        }
+        if (!current_.path.empty()) _unmap(current_, current_.used);
+    }
+
+    void write(const void* data, std::size_t size) override {
+        const char* bytes = static_cast<const char*>(data);
+        _capturePreamble(bytes, size);
+
+        if (_expired()) _rotate();
+
+        while (size > 0 && current_.base) {
+            std::uint64_t room = current_.capacity - current_.used;
+
+            // only split a write that could not fit even in a fresh segment
+            if (room < size && current_.used > preamble_.size()) {
+                _rotate();
+                continue;
+            }
+
+            std::size_t chunk = static_cast<std::size_t>(size < room ? size : room);
+            std::memcpy(current_.base + current_.used, bytes, chunk);
+            current_.used += chunk;
+            bytes_ += chunk;
+            bytes += chunk;
+            size -= chunk;
+
+            if (size > 0) _rotate();
+        }
+    }
+
+    std::uint64_t bytes() const noexcept {
+        return bytes_;
+    }
+
+    unsigned segments() const noexcept {
+        return index_ + 1;
+    }
+
+    bool failed() const noexcept {
+        return failed_;
+    }
+
+    std::uint64_t stallNs() const noexcept override {
+        return stall_ns_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::string _path(unsigned index) const {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), "_%04u", index);
+        return stem_.string() + suffix + extension_;
+    }
+
+    void _capturePreamble(const char* data, std::size_t size) {
+        for (std::size_t i = 0; i < size && preamble_seen_ < preamble_lines_; ++i) {
+            preamble_.push_back(data[i]);
+            if (data[i] == '\n') ++preamble_seen_;
+        }
+    }
+
+    bool _expired() const {
+        if (options_.segment_seconds <= 0 || current_.used <= preamble_.size()) return false;
+        return std::chrono::steady_clock::now() - opened_at_ >= std::chrono::seconds(options_.segment_seconds);
+    }
+
+    void _rotate() {
+        _unmap(current_, current_.used);
+
+        // waiting for the helper, or mapping inline after it failed, is a stall
+        auto start = std::chrono::steady_clock::now();
+        if (prepare_.joinable()) prepare_.join();
+        ++index_;
+
+        if (next_.base) {
+            current_ = next_;
+            next_ = Segment();
+        } else if (!_map(current_, _path(index_))) {
+            failed_ = true;
+            addStall(stall_ns_, start);
+            return;
+        }
+        addStall(stall_ns_, start);
+
+        opened_at_ = std::chrono::steady_clock::now();
+        if (!preamble_.empty()) {
+            std::memcpy(current_.base, preamble_.data(), preamble_.size());
+            current_.used = preamble_.size();
+            bytes_ += preamble_.size();
+        }
+        _prepareNext();
+    }
+
+    void _prepareNext() {
+        std::string path = _path(index_ + 1);
+        prepare_ = std::thread([this, path] {
+            _map(next_, path);
+        });
+    }
+
+    /**
+     * create, preallocate and map one segment; leaves it empty on failure
+     */
+    bool _map(Segment& segment, const std::string& path) {
+        if (_create(segment, path)) return true;
+
+        _unmap(segment, 0);
+        std::remove(path.c_str());
+        return false;
+    }
+
+    bool _create(Segment& segment, const std::string& path) {
+        segment = Segment();
+        segment.path = path;
+        segment.capacity = options_.segment_bytes;
+
+#if defined(_WIN32)
+        segment.file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (segment.file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(segment.capacity);
+        if (!SetFilePointerEx(segment.file, size, nullptr, FILE_BEGIN) || !SetEndOfFile(segment.file)) return false;
+
+        segment.mapping = CreateFileMappingA(segment.file, nullptr, PAGE_READWRITE, size.HighPart, size.LowPart, nullptr);
+        if (!segment.mapping) return false;
+
+        segment.base = static_cast<char*>(MapViewOfFile(segment.mapping, FILE_MAP_WRITE, 0, 0, 0));
+        return segment.base != nullptr;
+#else
+        segment.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (segment.fd < 0) return false;
+
+        // only filesystems without fallocate fall back to a sparse file; ENOSPC and
+        // other errors fail the segment rather than defer SIGBUS to the memcpy
+        int rc = posix_fallocate(segment.fd, 0, static_cast<off_t>(segment.capacity));
+        if (rc != 0) {
+            if (rc != EOPNOTSUPP && rc != EINVAL) return false;
+            if (::ftruncate(segment.fd, static_cast<off_t>(segment.capacity)) != 0) return false;
+        }
+
+        void* base = mmap(nullptr, static_cast<std::size_t>(segment.capacity), PROT_READ | PROT_WRITE, MAP_SHARED, segment.fd, 0);
+        if (base == MAP_FAILED) return false;
+
+        madvise(base, static_cast<std::size_t>(segment.capacity), MADV_SEQUENTIAL);
+        segment.base = static_cast<char*>(base);
+        return true;
+#endif
+    }
+
+    /**
+     * unmap and cut the file back to the bytes actually written
+     */
+    void _unmap(Segment& segment, std::uint64_t used) {
+#if defined(_WIN32)
+        if (segment.base) UnmapViewOfFile(segment.base);
+        if (segment.mapping) CloseHandle(segment.mapping);
+        if (segment.file != INVALID_HANDLE_VALUE) {
+            LARGE_INTEGER size;
+            size.QuadPart = static_cast<LONGLONG>(used);
+            SetFilePointerEx(segment.file, size, nullptr, FILE_BEGIN);
+            SetEndOfFile(segment.file);
+            CloseHandle(segment.file);
+        }
+#else
+        if (segment.base) munmap(segment.base, static_cast<std::size_t>(segment.capacity));
+        if (segment.fd >= 0) {
+            if (::ftruncate(segment.fd, static_cast<off_t>(used)) != 0) failed_ = true;
+            ::close(segment.fd);
+        }
+#endif
+        segment = Segment();
+    }
+};
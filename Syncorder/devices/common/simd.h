@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define SYNCORDER_X86 1
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+
+
+/**
+ * SIMD dispatch - runtime CPU detection for the frame kernels
+ *
+ * Kernels are compiled for every level in the same TU and picked at run time,
+ * so one binary runs everywhere. MSVC accepts AVX2 intrinsics without /arch;
+ * GCC / Clang need the per-function target attribute (SYNCORDER_TARGET_*).
+ * SSE2 is the x86-64 baseline and needs no attribute.
+ */
+
+#if defined(SYNCORDER_X86) && !defined(_MSC_VER)
+    #define SYNCORDER_TARGET_SSE41 __attribute__((target("sse4.1")))
+    #define SYNCORDER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define SYNCORDER_TARGET_SSE41
+    #define SYNCORDER_TARGET_AVX2
+#endif
+
+enum class SimdLevel {
+    SCALAR = 0,
+    SSE2 = 1,
+    SSE41 = 2,
+    AVX2 = 3,
+};
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::SSE41: return "sse4.1";
+        case SimdLevel::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+inline SimdLevel _detectSimdLevel() {
+#if defined(SYNCORDER_X86)
+    unsigned regs[4] = {0, 0, 0, 0};
+    auto cpuid = [&](unsigned leaf) {
+    #if defined(_MSC_VER)
+        int info[4];
+        __cpuidex(info, static_cast<int>(leaf), 0);
+        for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(info[i]);
+    #else
+        __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+    };
+
+    cpuid(0);
+    unsigned max_leaf = regs[0];
+
+    cpuid(1);
+    bool sse2 = (regs[3] >> 26) & 1;
+    bool sse41 = (regs[2] >> 19) & 1;
+    bool osxsave = (regs[2] >> 27) & 1;
+    bool avx = (regs[2] >> 28) & 1;
+
+    // AVX state must also be enabled by the OS (XCR0 bits 1 and 2)
+    bool ymm = false;
+    if (osxsave && avx) {
+    #if defined(_MSC_VER)
+        ymm = (_xgetbv(0) & 6) == 6;
+    #else
+        unsigned lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        ymm = (lo & 6) == 6;
+    #endif
+    }
+
+    bool avx2 = false;
+    if (max_leaf >= 7 && ymm) {
+        cpuid(7);
+        avx2 = (regs[1] >> 5) & 1;
+    }
+
+    if (avx2) return SimdLevel::AVX2;
+    if (sse41) return SimdLevel::SSE41;
+    if (sse2) return SimdLevel::SSE2;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+/**
+ * best level this CPU supports, detected once
+ */
+inline SimdLevel simdLevel() {
+    static const SimdLevel level = _detectSimdLevel();
+    return level;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <filesystem>
+#include <type_traits>
+
+
+/**
+ * @class SpillSegment - disk-backed SPSC overflow for a BBuffer
+ *
+ * The producer appends raw records and publishes written_ after each flush;
+ * the consumer reads through its own handle up to written_. Records are
+ * byte copies, so T must be trivially copyable. The file is removed on close.
+ *
+ * Flushes are batched: every FLUSH_BATCH records, or at once when the
+ * consumer has read everything published (it is waiting; an unflushed tail
+ * then goes out with the next push). Once the consumer
+ * has read every record the producer rewinds the file, so a long session's
+ * spill only ever holds the current backlog. Records are numbered
+ * monotonically; base_ is the number stored at file offset 0.
+ */
+
+template<typename T>
+class SpillSegment {
+private:
+    std::string path_;
+    std::FILE* writer_ = nullptr;
+    std::FILE* reader_ = nullptr;
+
+    static constexpr std::uint64_t FLUSH_BATCH = 64;
+
+    std::atomic<std::uint64_t> appended_{0};    // producer: fwritten, maybe not flushed
+    std::atomic<std::uint64_t> written_{0};     // flushed: readable
+    std::atomic<std::uint64_t> read_{0};
+    std::atomic<std::uint64_t> base_{0};        // record number at offset 0
+    std::uint64_t reader_base_ = 0;             // consumer: base_ its handle is positioned for
+
+public:
+    SpillSegment() = default;
+    SpillSegment(const SpillSegment&) = delete;
+    SpillSegment& operator=(const SpillSegment&) = delete;
+
+    ~SpillSegment() { close(); }
+
+public:
+    bool open(const std::string& path) {
+        close();
+
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent);
+
+        writer_ = std::fopen(path.c_str(), "wb");
+        if (!writer_) return false;
+
+        reader_ = std::fopen(path.c_str(), "rb");
+        if (!reader_) {
+            std::fclose(writer_);
+            writer_ = nullptr;
+            return false;
+        }
+        std::setvbuf(reader_, nullptr, _IONBF, 0);
+
+        path_ = path;
+        appended_.store(0, std::memory_order_relaxed);
+        written_.store(0, std::memory_order_relaxed);
+        read_.store(0, std::memory_order_relaxed);
+        base_.store(0, std::memory_order_relaxed);
+        reader_base_ = 0;
+        return true;
+    }
+
+    void close() {
+        if (writer_) std::fclose(writer_);
+        if (reader_) std::fclose(reader_);
+        writer_ = nullptr;
+        reader_ = nullptr;
+
+        if (!path_.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(path_, ec);
+            path_.clear();
+        }
+    }
+
+    // producer: records not yet read, flushed or not
+    bool pending() const noexcept {
+        return read_.load(std::memory_order_acquire) != appended_.load(std::memory_order_relaxed);
+    }
+
+    bool push(const T& value) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "SpillSegment needs a trivially copyable record");
+
+        if (!writer_) return false;
+
+        std::uint64_t appended = appended_.load(std::memory_order_relaxed);
+        std::uint64_t read = read_.load(std::memory_order_acquire);
+
+        // all read: start over at offset 0 (the consumer holds no unread offset)
+        if (read == appended && appended != base_.load(std::memory_order_relaxed)) {
+            writer_ = std::freopen(path_.c_str(), "wb", writer_);
+            if (!writer_) return false;
+            base_.store(appended, std::memory_order_relaxed);     // published by the written_ release below
+        }
+
+        if (std::fwrite(&value, sizeof(T), 1, writer_) != 1) return false;
+        appended_.store(++appended, std::memory_order_relaxed);
+
+        std::uint64_t written = written_.load(std::memory_order_relaxed);
+        if (appended - written >= FLUSH_BATCH || read == written) {
+            if (std::fflush(writer_) != 0) return false;
+            written_.store(appended, std::memory_order_release);
+        }
+        return true;
+    }
+
+    // producer: publish the batched tail now (end of a burst)
+    bool flush() noexcept {
+        if (!writer_) return false;
+
+        std::uint64_t appended = appended_.load(std::memory_order_relaxed);
+        if (written_.load(std::memory_order_relaxed) == appended) return true;
+        if (std::fflush(writer_) != 0) return false;
+
+        written_.store(appended, std::memory_order_release);
+        return true;
+    }
+
+    // consumer: flushed records not yet read
+    bool readable() const noexcept {
+        return read_.load(std::memory_order_relaxed) != written_.load(std::memory_order_acquire);
+    }
+
+    std::size_t pop_n(T* out, std::size_t max) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "SpillSegment needs a trivially copyable record");
+
+        if (!reader_) return 0;
+
+        std::uint64_t current_read = read_.load(std::memory_order_relaxed);
+        std::uint64_t available = written_.load(std::memory_order_acquire) - current_read;
+        std::size_t count = static_cast<std::size_t>(available < max ? available : max);
+        if (count == 0) return 0;
+
+        // the producer rewound since the last read
+        std::uint64_t base = base_.load(std::memory_order_relaxed);
+        if (base != reader_base_) {
+            if (std::fseek(reader_, static_cast<long>((current_read - base) * sizeof(T)), SEEK_SET) != 0) return 0;
+            reader_base_ = base;
+        }
+
+        count = std::fread(out, sizeof(T), count, reader_);
+        read_.store(current_read + count, std::memory_order_release);
+        return count;
+    }
+
+    // records in the file now (producer)
+    std::uint64_t fileRecords() const noexcept {
+        return appended_.load(std::memory_order_relaxed) - base_.load(std::memory_order_relaxed);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+
+/**
+ * @class CancelToken - cooperative cancellation for one manager stage call
+ *
+ * The orchestrator hands every BManager stage call a token carrying that
+ * manager's deadline. It reads as cancelled once the deadline passes, the
+ * orchestrator gives up on the call, or the session aborts. Stage code checks
+ * cancelled() between steps and uses sleepFor() instead of a bare sleep, so a
+ * cancelled call returns promptly instead of holding its worker.
+ *
+ * Tokens are cheap handles on shared state: a worker still running a call the
+ * orchestrator has abandoned keeps the state alive. An abandoned token is
+ * cancelled first, so it never reads the abort flag again once its owner is
+ * gone.
+ */
+
+class CancelToken {
+private:
+    struct State {
+        std::chrono::steady_clock::time_point deadline;
+        const std::atomic<bool>* abort = nullptr;
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;
+        std::condition_variable wake;
+    };
+
+    std::shared_ptr<State> state_;
+
+    static constexpr std::chrono::milliseconds ABORT_POLL{10};
+
+public:
+    // never cancelled
+    CancelToken() : CancelToken(std::chrono::steady_clock::time_point::max()) {}
+
+    explicit CancelToken(std::chrono::steady_clock::time_point deadline, const std::atomic<bool>* abort = nullptr)
+    :
+        state_(std::make_shared<State>())
+    {
+        state_->deadline = deadline;
+        state_->abort = abort;
+    }
+
+public:
+    void cancel() const {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->cancelled.store(true, std::memory_order_release);
+        }
+        state_->wake.notify_all();
+    }
+
+    bool cancelled() const noexcept {
+        if (state_->cancelled.load(std::memory_order_acquire)) return true;
+        if (state_->abort && state_->abort->load(std::memory_order_acquire)) return true;
+        return std::chrono::steady_clock::now() >= state_->deadline;
+    }
+
+    std::chrono::steady_clock::time_point deadline() const noexcept { return state_->deadline; }
+
+    /**
+     * sleep up to duration; false if cancelled first (returns as soon as it is)
+     */
+    template <typename Rep, typename Period>
+    bool sleepFor(std::chrono::duration<Rep, Period> duration) const {
+        auto until = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration);
+        if (until > state_->deadline) until = state_->deadline;
+
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        while (!cancelled()) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= until) return true;
+
+            // abort is a plain flag, not a notify: poll it
+            auto slice = state_->abort ? std::min<std::chrono::steady_clock::duration>(until - now, ABORT_POLL) : until - now;
+            state_->wake.wait_for(lock, slice);
+        }
+        return false;
+    }
+};
+
+
+/**
+ * @class StagePool - persistent workers for the orchestrator's stage calls
+ *
+ * Workers are kept across stages instead of a fresh thread per manager per
+ * stage; submit() spawns one more only when none is idle, so a stage with n
+ * managers runs n calls in parallel and later stages reuse the threads.
+ *
+ * A StageTask is waited on up to its own deadline; on timeout the caller
+ * cancels its token and moves on. The worker stays busy until the call
+ * returns, and the pool grows around it. shutdown() waits for the idle
+ * workers to exit and leaves the ones still inside an abandoned call behind
+ * (detached; they own the shared pool state, not the pool), so a hung device
+ * cannot stall shutdown. The pool is usable again afterwards.
+ */
+
+class StageTask {
+private:
+    friend class StagePool;
+
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        bool done = false;
+        bool result = false;
+        std::string error;
+    };
+
+    std::shared_ptr<State> state_ = std::make_shared<State>();
+    CancelToken token_;
+
+public:
+    explicit StageTask(CancelToken token) : token_(std::move(token)) {}
+
+public:
+    const CancelToken& token() const noexcept { return token_; }
+
+    /**
+     * true once the call returned; false on timeout (the token is then
+     * cancelled and the call abandoned)
+     */
+    bool waitUntil(std::chrono::steady_clock::time_point deadline) {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        if (state_->done_cv.wait_until(lock, deadline, [this] { return state_->done; })) return true;
+
+        lock.unlock();
+        token_.cancel();
+        return false;
+    }
+
+    bool done() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->done;
+    }
+
+    // after waitUntil() returned true
+    bool result() const { return state_->result; }
+    const std::string& error() const { return state_->error; }
+};
+
+class StagePool {
+private:
+    struct Shared {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<std::function<void()>> jobs;
+        std::size_t idle = 0;
+        std::size_t busy = 0;
+        std::size_t exited = 0;
+        bool stopping = false;
+    };
+
+    std::shared_ptr<Shared> shared_ = std::make_shared<Shared>();
+    std::vector<std::thread> workers_;
+
+public:
+    StagePool() = default;
+    StagePool(const StagePool&) = delete;
+    StagePool& operator=(const StagePool&) = delete;
+
+    ~StagePool() { shutdown(); }
+
+public:
+    /**
+     * run call(token) on a worker; never blocks
+     */
+    StageTask submit(CancelToken token, std::function<bool(const CancelToken&)> call) {
+        StageTask task(std::move(token));
+        auto state = task.state_;
+        CancelToken handle = task.token();
+
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        shared_->jobs.push_back([state, handle, call = std::move(call)] {
+            bool result = false;
+            std::string error;
+            try {
+                result = call(handle);
+            } catch (const std::exception& e) {
+                error = e.what();
+            } catch (...) {
+                error = "unknown exception";
+            }
+
+            {
+                std::lock_guard<std::mutex> done_lock(state->mutex);
+                state->result = result;
+                state->error = std::move(error);
+                state->done = true;
+            }
+            state->done_cv.notify_all();
+        });
+
+        if (shared_->idle < shared_->jobs.size()) workers_.emplace_back(&StagePool::_work, shared_);
+        shared_->wake.notify_one();
+        return task;
+    }
+
+    std::size_t workers() const noexcept { return workers_.size(); }
+
+    // workers inside a call right now (a hung call stays counted)
+    std::size_t busy() const {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        return shared_->busy;
+    }
+
+    /**
+     * stop the idle workers and leave the ones stuck in an abandoned call
+     */
+    void shutdown() {
+        if (workers_.empty()) return;
+
+        std::shared_ptr<Shared> shared = shared_;
+        std::size_t total = workers_.size();
+        for (auto& worker : workers_) worker.detach();
+        workers_.clear();
+        shared_ = std::make_shared<Shared>();
+
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        shared->stopping = true;
+        shared->jobs.clear();
+        shared->wake.notify_all();
+
+        // every worker not inside a call exits now; the busy ones exit when their call returns
+        shared->wake.wait(lock, [&] { return shared->exited + shared->busy >= total; });
+    }
+
+private:
+    static void _work(std::shared_ptr<Shared> shared) {
+        std::unique_lock<std::mutex> lock(shared->mutex);
+        for (;;) {
+            ++shared->idle;
+            shared->wake.wait(lock, [&] { return shared->stopping || !shared->jobs.empty(); });
+            --shared->idle;
+            if (shared->stopping) break;
+
+            auto job = std::move(shared->jobs.front());
+            shared->jobs.pop_front();
+            ++shared->busy;
+
+            lock.unlock();
+            job();
+            lock.lock();
+
+            --shared->busy;
+        }
+
+        ++shared->exited;
+        shared->wake.notify_all();
+    }
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+// local
+#include <Syncorder/devices/common/timestamp.h>
+
+
+/**
+ * @class StartBarrier - one start instant for every stream
+ *
+ * The orchestrator arms the barrier with an instant lead ahead of now (in
+ * capture ticks, the clock every sample is stamped with); each manager's
+ * start stage then waits for it and opens its buffer gate. The wait sleeps
+ * until spin before the instant, then spins on timestamps().now() (yielding,
+ * so waiters sharing a core still get through), so every gate opens within a
+ * few microseconds of the instant instead of whenever its stage worker
+ * happened to be scheduled.
+ *
+ * spin must cover the OS sleep overshoot: ~100 us on Linux, a timer tick
+ * (up to 15.6 ms) on Windows without a raised timer resolution. A caller that
+ * reaches the barrier after the instant opens at once; the start report shows
+ * it as a large skew.
+ */
+
+class StartBarrier {
+private:
+    std::atomic<std::int64_t> start_ticks_{0};      // 0 = disarmed: open at once
+    std::int64_t spin_ticks_ = 0;
+
+public:
+    StartBarrier() = default;
+    StartBarrier(const StartBarrier&) = delete;
+    StartBarrier& operator=(const StartBarrier&) = delete;
+
+public:
+    /**
+     * before the start stage; returns the start instant in ticks
+     */
+    std::int64_t arm(std::chrono::microseconds lead, std::chrono::microseconds spin) {
+        TimestampMapping map = timestamps().mapping();
+        spin_ticks_ = static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(spin).count() / map.ns_per_tick);
+
+        std::int64_t start = timestamps().now() + static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(lead).count() / map.ns_per_tick);
+        start_ticks_.store(start, std::memory_order_release);
+        return start;
+    }
+
+    void disarm() noexcept { start_ticks_.store(0, std::memory_order_release); }
+
+    bool armed() const noexcept { return start_ticks_.load(std::memory_order_acquire) != 0; }
+    std::int64_t startTicks() const noexcept { return start_ticks_.load(std::memory_order_acquire); }
+
+    /**
+     * block until the start instant: sleep, then spin the last stretch
+     */
+    void wait() const {
+        std::int64_t start = start_ticks_.load(std::memory_order_acquire);
+        if (!start) return;
+
+        double ns_per_tick = timestamps().mapping().ns_per_tick;
+        for (;;) {
+            std::int64_t remaining = start - spin_ticks_ - timestamps().now();
+            if (remaining <= 0) break;
+            std::this_thread::sleep_for(std::chrono::nanoseconds(static_cast<std::int64_t>(remaining * ns_per_tick)));
+        }
+        while (timestamps().now() < start) std::this_thread::yield();
+    }
+};
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cmath>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <cstdint>
+
+#if defined(_WIN32)
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <time.h>
+#endif
+
+// local
+#include <Syncorder/devices/common/simd.h>
+
+
+/**
+ * Capture timestamps - one cheap read in the callback, conversion in the broker
+ *
+ * Callbacks run on SDK threads and only call timestamps().now(): a raw tick
+ * count, either the TSC (rdtsc, when the CPU reports an invariant TSC) or the
+ * OS monotonic clock (QueryPerformanceCounter / CLOCK_MONOTONIC_RAW). Neither
+ * is slewed or stepped by NTP.
+ *
+ * Brokers take a TimestampMapping once per batch and convert:
+ *   host ns - the OS monotonic clock's timeline (the clock ClockAligner
+ *             aligns every device to); TSC ticks map onto it through a
+ *             calibrated, periodically re-fitted rate
+ *   wall ns - host ns + a wall-clock anchor (system_clock - host), re-read
+ *             every ANCHOR_PERIOD; changes are slewed in at most 500 ppm, so
+ *             an NTP step shows up as a gentle ramp, not a jump. Steps of a
+ *             second or more (manual clock change) are taken as is.
+ */
+
+enum class TimestampBackend {
+    MONOTONIC = 0,      // QueryPerformanceCounter / CLOCK_MONOTONIC_RAW / steady_clock
+    TSC = 1,            // rdtsc, calibrated against MONOTONIC
+};
+
+inline const char* timestampBackendName(TimestampBackend backend) {
+    return backend == TimestampBackend::TSC ? "tsc" : "monotonic";
+}
+
+
+/**
+ * @helper: clock reads
+ */
+
+// OS monotonic clock, ns
+inline std::int64_t _readMonotonic() noexcept {
+#if defined(_WIN32)
+    static const std::int64_t frequency = [] {
+        LARGE_INTEGER f;
+        QueryPerformanceFrequency(&f);
+        return static_cast<std::int64_t>(f.QuadPart);
+    }();
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    std::int64_t ticks = static_cast<std::int64_t>(counter.QuadPart);
+    return ticks / frequency * 1000000000LL + ticks % frequency * 1000000000LL / frequency;
+#elif defined(__linux__)
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return static_cast<std::int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline std::int64_t _readTsc() noexcept {
+#if defined(SYNCORDER_X86)
+    return static_cast<std::int64_t>(__rdtsc());
+#else
+    return _readMonotonic();
+#endif
+}
+
+inline std::int64_t _readWall() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * CPUID 0x80000007 EDX bit 8: TSC rate is constant across P/C-states
+ */
+inline bool _invariantTsc() {
+#if defined(SYNCORDER_X86)
+    unsigned regs[4] = {0, 0, 0, 0};
+    #if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, static_cast<int>(0x80000000u));
+        if (static_cast<unsigned>(info[0]) < 0x80000007u) return false;
+        __cpuid(info, static_cast<int>(0x80000007u));
+        regs[3] = static_cast<unsigned>(info[3]);
+    #else
+        if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u) return false;
+        __cpuid(0x80000007u, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+    return (regs[3] >> 8) & 1;
+#else
+    return false;
+#endif
+}
+
+
+/**
+ * @struct TimestampMapping - tick -> host / wall ns, valid around its anchor
+ */
+
+struct TimestampMapping {
+    std::int64_t tick = 0;
+    std::int64_t host_ns = 0;
+    double ns_per_tick = 1.0;
+    std::int64_t wall_offset_ns = 0;    // wall - host
+
+    std::int64_t hostNs(std::int64_t ticks) const noexcept {
+        return host_ns + static_cast<std::int64_t>(std::llround((ticks - tick) * ns_per_tick));
+    }
+
+    std::int64_t wallNs(std::int64_t ticks) const noexcept {
+        return hostNs(ticks) + wall_offset_ns;
+    }
+
+    std::chrono::system_clock::time_point wallTime(std::int64_t ticks) const noexcept {
+        return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(wallNs(ticks))));
+    }
+};
+
+
+/**
+ * @class TimestampSource - process-wide capture clock (see above)
+ */
+
+class TimestampSource {
+private:
+    TimestampBackend backend_ = TimestampBackend::MONOTONIC;
+
+    static constexpr std::int64_t ANCHOR_PERIOD_NS = 1000000000LL;
+    static constexpr double SLEW_PPM = 500.0;
+    static constexpr std::int64_t STEP_NS = 1000000000LL;
+
+    std::mutex mutex_;
+    TimestampMapping mapping_;
+    std::int64_t next_refresh_ = 0;     // in ticks
+
+    // TSC rate fit: first calibration pair
+    std::int64_t tick_0_ = 0;
+    std::int64_t host_0_ = 0;
+
+public:
+    TimestampSource() { select(TimestampBackend::MONOTONIC); }
+    TimestampSource(const TimestampSource&) = delete;
+    TimestampSource& operator=(const TimestampSource&) = delete;
+
+public:
+    /**
+     * pick the backend and calibrate; call before capture starts. TSC falls
+     * back to MONOTONIC without an invariant TSC. Returns the backend in use.
+     */
+    TimestampBackend select(TimestampBackend backend) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (backend == TimestampBackend::TSC && !_invariantTsc()) backend = TimestampBackend::MONOTONIC;
+        backend_ = backend;
+
+        std::int64_t tick = 0, host = 0;
+        _pair(tick, host);
+        tick_0_ = tick;
+        host_0_ = host;
+
+        mapping_ = TimestampMapping();
+        mapping_.tick = tick;
+        mapping_.host_ns = host;
+        mapping_.ns_per_tick = 1.0;
+        mapping_.wall_offset_ns = _readWall() - host;
+
+        if (backend_ == TimestampBackend::TSC) {
+            // short calibration; refined on every refresh as the baseline grows
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            _pair(tick, host);
+            mapping_.ns_per_tick = static_cast<double>(host - host_0_) / static_cast<double>(tick - tick_0_);
+            mapping_.tick = tick;
+            mapping_.host_ns = host;
+        }
+
+        next_refresh_ = mapping_.tick + _ticks(ANCHOR_PERIOD_NS);
+        return backend_;
+    }
+
+    TimestampBackend backend() const noexcept { return backend_; }
+
+    /**
+     * the one read a callback does
+     */
+    std::int64_t now() const noexcept {
+        return backend_ == TimestampBackend::TSC ? _readTsc() : _readMonotonic();
+    }
+
+    /**
+     * current mapping, re-anchored at most once per ANCHOR_PERIOD; take it
+     * once per batch
+     */
+    TimestampMapping mapping() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (now() >= next_refresh_) _refresh();
+        return mapping_;
+    }
+
+private:
+    std::int64_t _ticks(std::int64_t ns) const noexcept {
+        return static_cast<std::int64_t>(ns / mapping_.ns_per_tick);
+    }
+
+    /**
+     * (tick, host ns) read back to back; for TSC the tightest of a few
+     * bracketed reads, tick at the midpoint
+     */
+    void _pair(std::int64_t& tick, std::int64_t& host) const {
+        if (backend_ != TimestampBackend::TSC) {
+            tick = host = _readMonotonic();
+            return;
+        }
+
+        std::int64_t best = INT64_MAX;
+        for (int i = 0; i < 5; ++i) {
+            std::int64_t before = _readTsc();
+            std::int64_t ns = _readMonotonic();
+            std::int64_t after = _readTsc();
+            if (after - before < best) {
+                best = after - before;
+                tick = before + (after - before) / 2;
+                host = ns;
+            }
+        }
+    }
+
+    void _refresh() {
+        std::int64_t tick = 0, host = 0;
+        _pair(tick, host);
+        std::int64_t wall = _readWall();
+
+        // continue from the old mapping at this tick, so host ns never jumps
+        std::int64_t mapped = mapping_.hostNs(tick);
+        std::int64_t elapsed = mapped - mapping_.host_ns;
+
+        if (backend_ == TimestampBackend::TSC) {
+            // long-baseline rate, plus the residual steered out over the next period (bounded by the slew rate)
+            double rate = static_cast<double>(host - host_0_) / static_cast<double>(tick - tick_0_);
+            double steer = static_cast<double>(host - mapped) / ANCHOR_PERIOD_NS;
+            steer = std::fmax(-SLEW_PPM * 1e-6, std::fmin(SLEW_PPM * 1e-6, steer));
+            mapping_.ns_per_tick = rate * (1.0 + steer);
+        }
+
+        // wall anchor: slew towards system_clock - host, take big steps as is
+        std::int64_t target = wall - mapped;
+        std::int64_t diff = target - mapping_.wall_offset_ns;
+        std::int64_t limit = static_cast<std::int64_t>(elapsed * SLEW_PPM * 1e-6);
+        if (diff >= STEP_NS || diff <= -STEP_NS) mapping_.wall_offset_ns = target;
+        else mapping_.wall_offset_ns += diff > limit ? limit : (diff < -limit ? -limit : diff);
+
+        mapping_.tick = tick;
+        mapping_.host_ns = mapped;
+        next_refresh_ = tick + _ticks(ANCHOR_PERIOD_NS);
+    }
+};
+
+/**
+ * process-wide source; callbacks and brokers share it
+ */
+inline TimestampSource& timestamps() {
+    static TimestampSource source;
+    return source;
+}
+
+/**
+ * gonfig.timestamp_source: auto | tsc | monotonic (auto = tsc when invariant)
+ */
+inline TimestampBackend parseTimestampBackend(const std::string& name) {
+    if (name == "monotonic") return TimestampBackend::MONOTONIC;
+    return TimestampBackend::TSC;
+}
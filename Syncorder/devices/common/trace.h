@@ -0,0 +1,152 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <deque>
+#include <string>
+#include <cstdint>
+#include <ostream>
+#include <iomanip>
+#include <type_traits>
+
+// local
+#include <Syncorder/devices/common/histogram.h>
+
+
+/**
+ * Per-sample latency tracing - build with /DSYNCORDER_TRACE (-DSYNCORDER_TRACE)
+ *
+ * callback entry -> enqueue -> dequeue -> write completion
+ *
+ * The first two stamps travel inside the sample (TraceSlot base of the buffer
+ * data); dequeue and write are read once per broker batch. Without the flag
+ * TraceSlot is an empty base, traceNow() is constant 0 and the broker-side
+ * recording is discarded at compile time.
+ */
+
+#ifdef SYNCORDER_TRACE
+constexpr bool TRACE_ENABLED = true;
+#else
+constexpr bool TRACE_ENABLED = false;
+#endif
+
+inline std::int64_t traceNow() noexcept {
+    if constexpr (TRACE_ENABLED) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    } else {
+        return 0;
+    }
+}
+
+
+/**
+ * @struct TraceSlot - in-sample stamps (empty without SYNCORDER_TRACE)
+ */
+
+struct TraceSlot {
+#ifdef SYNCORDER_TRACE
+    std::int64_t trace_callback_ns = 0;
+    std::int64_t trace_enqueue_ns = 0;
+#endif
+
+    void traceCallback(std::int64_t ns) noexcept {
+#ifdef SYNCORDER_TRACE
+        trace_callback_ns = ns;
+#else
+        (void)ns;
+#endif
+    }
+
+    void traceEnqueue() noexcept {
+#ifdef SYNCORDER_TRACE
+        trace_enqueue_ns = traceNow();
+#endif
+    }
+};
+
+
+/**
+ * @class StreamTrace - lock-free stage histograms of one stream
+ */
+
+class StreamTrace {
+public:
+    std::string name_;
+
+    LatencyHistogram map_;          // callback entry -> enqueue
+    LatencyHistogram queue_;        // enqueue -> dequeue
+    LatencyHistogram write_;        // dequeue -> write completion
+    LatencyHistogram total_;        // callback entry -> write completion
+
+public:
+    explicit StreamTrace(const std::string& name) : name_(name) {}
+
+public:
+    template<typename DataType>
+    void record(const DataType* data, std::size_t count, std::int64_t dequeue_ns, std::int64_t write_ns) noexcept {
+        if constexpr (TRACE_ENABLED && std::is_base_of_v<TraceSlot, DataType>) {
+            write_.record(write_ns - dequeue_ns);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                map_.record(data[i].trace_enqueue_ns - data[i].trace_callback_ns);
+                queue_.record(dequeue_ns - data[i].trace_enqueue_ns);
+                total_.record(write_ns - data[i].trace_callback_ns);
+            }
+        } else {
+            (void)data; (void)count; (void)dequeue_ns; (void)write_ns;
+        }
+    }
+
+    void dump(std::ostream& os) const {
+        _row(os, "map", map_);
+        _row(os, "queue", queue_);
+        _row(os, "write", write_);
+        _row(os, "total", total_);
+    }
+
+private:
+    void _row(std::ostream& os, const char* stage, const LatencyHistogram& histogram) const {
+        auto us = [](std::uint64_t ns) { return ns / 1000.0; };
+
+        os << "[Trace] " << std::left << std::setw(10) << name_ << std::setw(6) << stage << std::right
+           << " n=" << histogram.count()
+           << std::fixed << std::setprecision(1)
+           << " p50=" << us(histogram.percentile(50.0)) << "us"
+           << " p99=" << us(histogram.percentile(99.0)) << "us"
+           << " p99.9=" << us(histogram.percentile(99.9)) << "us"
+           << " max=" << us(histogram.max()) << "us\n";
+    }
+};
+
+
+/**
+ * @class TraceRegistry - process-wide list of stream traces
+ *
+ * stream() is called at setup; the returned reference stays valid for the
+ * process lifetime (deque never relocates).
+ */
+
+class TraceRegistry {
+private:
+    std::mutex mutex_;
+    std::deque<StreamTrace> streams_;
+
+public:
+    static TraceRegistry& instance() {
+        static TraceRegistry registry;
+        return registry;
+    }
+
+public:
+    StreamTrace& stream(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& stream : streams_) if (stream.name_ == name) return stream;
+        return streams_.emplace_back(name);
+    }
+
+    void dump(std::ostream& os) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& stream : streams_) stream.dump(os);
+    }
+};
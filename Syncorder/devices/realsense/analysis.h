@@ -0,0 +1,459 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// local
+#include <Syncorder/devices/common/simd.h>
+
+
+/**
+ * Per-frame quality metrics - one pass over the frame on the broker thread
+ *
+ * Kernels exist for AVX2 and SSE4.1 with a scalar fallback; all three give
+ * bit-identical results. Sums are kept in 64-bit lanes via psadbw, so there
+ * is no overflow at any resolution.
+ */
+
+
+/**
+ * @struct DepthAnalysis - Z16 frame summary, in raw depth units
+ *
+ * A pixel is valid when it is non-zero; min / max / avg are over valid pixels
+ * only and stay 0 when the frame has none.
+ */
+
+struct DepthAnalysis {
+    uint16_t center_depth = 0;
+    float valid_pixel_ratio = 0.0f;
+    uint16_t min_depth = 0;
+    uint16_t max_depth = 0;
+    uint16_t avg_depth = 0;
+};
+
+struct _DepthSums {
+    std::uint64_t sum = 0;
+    std::uint64_t valid = 0;
+    std::uint16_t min = 0xffff;
+    std::uint16_t max = 0;
+};
+
+inline void _depthSumsScalar(const std::uint16_t* src, std::size_t count, _DepthSums& sums) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint16_t v = src[i];
+        if (v == 0) continue;
+
+        sums.sum += v;
+        ++sums.valid;
+        if (v < sums.min) sums.min = v;
+        if (v > sums.max) sums.max = v;
+    }
+}
+
+#if defined(SYNCORDER_X86)
+/**
+ * fold the vector lanes: lo / hi are psadbw sums of the low / high bytes,
+ * zeros the invalid-pixel count, over the first count pixels
+ */
+inline void _depthReduce(const std::uint64_t* lo, const std::uint64_t* hi, const std::uint64_t* zeros, int quads,
+                         const std::uint16_t* mins, const std::uint16_t* maxs, int lanes,
+                         std::size_t count, _DepthSums& sums) {
+    std::uint64_t invalid = 0;
+    for (int q = 0; q < quads; ++q) {
+        sums.sum += lo[q] + (hi[q] << 8);
+        invalid += zeros[q];
+    }
+    sums.valid += count - invalid;
+
+    for (int l = 0; l < lanes; ++l) {
+        if (mins[l] < sums.min) sums.min = mins[l];
+        if (maxs[l] > sums.max) sums.max = maxs[l];
+    }
+}
+
+SYNCORDER_TARGET_SSE41
+inline void _depthSumsSse41(const std::uint16_t* src, std::size_t count, _DepthSums& sums) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low = _mm_set1_epi16(0x00ff);
+    const __m128i one = _mm_set1_epi16(1);
+
+    __m128i vmin = _mm_set1_epi16(-1);
+    __m128i vmax = zero;
+    __m128i lo = zero;
+    __m128i hi = zero;
+    __m128i zeros = zero;
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i invalid = _mm_cmpeq_epi16(v, zero);
+
+        vmin = _mm_min_epu16(vmin, _mm_or_si128(v, invalid));      // invalid -> 0xffff
+        vmax = _mm_max_epu16(vmax, v);
+        lo = _mm_add_epi64(lo, _mm_sad_epu8(_mm_and_si128(v, low), zero));
+        hi = _mm_add_epi64(hi, _mm_sad_epu8(_mm_srli_epi16(v, 8), zero));
+        zeros = _mm_add_epi64(zeros, _mm_sad_epu8(_mm_and_si128(invalid, one), zero));
+    }
+
+    alignas(16) std::uint64_t lo_lanes[2], hi_lanes[2], zero_lanes[2];
+    alignas(16) std::uint16_t min_lanes[8], max_lanes[8];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lo_lanes), lo);
+    _mm_store_si128(reinterpret_cast<__m128i*>(hi_lanes), hi);
+    _mm_store_si128(reinterpret_cast<__m128i*>(zero_lanes), zeros);
+    _mm_store_si128(reinterpret_cast<__m128i*>(min_lanes), vmin);
+    _mm_store_si128(reinterpret_cast<__m128i*>(max_lanes), vmax);
+    _depthReduce(lo_lanes, hi_lanes, zero_lanes, 2, min_lanes, max_lanes, 8, i, sums);
+
+    _depthSumsScalar(src + i, count - i, sums);
+}
+
+SYNCORDER_TARGET_AVX2
+inline void _depthSumsAvx2(const std::uint16_t* src, std::size_t count, _DepthSums& sums) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i low = _mm256_set1_epi16(0x00ff);
+    const __m256i one = _mm256_set1_epi16(1);
+
+    __m256i vmin = _mm256_set1_epi16(-1);
+    __m256i vmax = zero;
+    __m256i lo = zero;
+    __m256i hi = zero;
+    __m256i zeros = zero;
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i invalid = _mm256_cmpeq_epi16(v, zero);
+
+        vmin = _mm256_min_epu16(vmin, _mm256_or_si256(v, invalid));
+        vmax = _mm256_max_epu16(vmax, v);
+        lo = _mm256_add_epi64(lo, _mm256_sad_epu8(_mm256_and_si256(v, low), zero));
+        hi = _mm256_add_epi64(hi, _mm256_sad_epu8(_mm256_srli_epi16(v, 8), zero));
+        zeros = _mm256_add_epi64(zeros, _mm256_sad_epu8(_mm256_and_si256(invalid, one), zero));
+    }
+
+    alignas(32) std::uint64_t lo_lanes[4], hi_lanes[4], zero_lanes[4];
+    alignas(32) std::uint16_t min_lanes[16], max_lanes[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lo_lanes), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hi_lanes), hi);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(zero_lanes), zeros);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(min_lanes), vmin);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(max_lanes), vmax);
+    _depthReduce(lo_lanes, hi_lanes, zero_lanes, 4, min_lanes, max_lanes, 16, i, sums);
+
+    _depthSumsScalar(src + i, count - i, sums);
+}
+#endif
+
+/**
+ * whole-frame depth summary; frame is width * height Z16 pixels, row-major
+ */
+inline DepthAnalysis analyzeDepth(const std::uint16_t* frame, int width, int height, SimdLevel level = simdLevel()) {
+    DepthAnalysis analysis;
+    if (!frame || width <= 0 || height <= 0) return analysis;
+
+    std::size_t pixels = static_cast<std::size_t>(width) * height;
+    _DepthSums sums;
+
+#if defined(SYNCORDER_X86)
+    if (level >= SimdLevel::AVX2) _depthSumsAvx2(frame, pixels, sums);
+    else if (level >= SimdLevel::SSE41) _depthSumsSse41(frame, pixels, sums);
+    else _depthSumsScalar(frame, pixels, sums);
+#else
+    _depthSumsScalar(frame, pixels, sums);
+#endif
+
+    analysis.center_depth = frame[static_cast<std::size_t>(height / 2) * width + width / 2];
+    analysis.valid_pixel_ratio = static_cast<float>(static_cast<double>(sums.valid) / pixels);
+    if (sums.valid) {
+        analysis.min_depth = sums.min;
+        analysis.max_depth = sums.max;
+        analysis.avg_depth = static_cast<std::uint16_t>(sums.sum / sums.valid);
+    }
+    return analysis;
+}
+
+
+/**
+ * @struct ColorAnalysis - RGB8 frame summary
+ *
+ * Luma is BT.601 in 8-bit fixed point, (77 R + 150 G + 29 B) >> 8. The
+ * histogram has COLOR_HISTOGRAM_BINS bins of 16 luma levels each; the first
+ * and last bins are the dark / bright (clipped) fractions used for exposure
+ * flags. Histogram and ratios stay 0 when the histogram is not requested.
+ */
+
+constexpr int COLOR_HISTOGRAM_BINS = 16;
+constexpr int COLOR_HISTOGRAM_SHIFT = 12;      // luma * 256 >> 12 = luma >> 4
+constexpr float COLOR_CLIP_RATIO = 0.25f;      // dark / bright share that flags the exposure
+
+enum ExposureFlag : uint8_t {
+    EXPOSURE_OK = 0,
+    EXPOSURE_DARK = 1,
+    EXPOSURE_BRIGHT = 2,
+};
+
+struct ColorAnalysis {
+    uint8_t center_r = 0;
+    uint8_t center_g = 0;
+    uint8_t center_b = 0;
+    uint8_t avg_brightness = 0;
+
+    uint8_t mean_r = 0;
+    uint8_t mean_g = 0;
+    uint8_t mean_b = 0;
+
+    bool has_histogram = false;
+    uint32_t histogram[COLOR_HISTOGRAM_BINS] = {};
+    float dark_ratio = 0.0f;       // luma < 16
+    float bright_ratio = 0.0f;     // luma >= 240
+};
+
+struct _ColorSums {
+    std::uint64_t r = 0;
+    std::uint64_t g = 0;
+    std::uint64_t b = 0;
+    // 4 interleaved copies so consecutive pixels in one bin do not serialize on one counter
+    std::uint32_t histogram[4][COLOR_HISTOGRAM_BINS] = {};
+};
+
+inline unsigned _lumaBin(unsigned r, unsigned g, unsigned b) {
+    return (77 * r + 150 * g + 29 * b) >> COLOR_HISTOGRAM_SHIFT;
+}
+
+inline void _colorSumsScalar(const std::uint8_t* src, std::size_t count, bool histogram, _ColorSums& sums) {
+    for (std::size_t i = 0; i < count; ++i, src += 3) {
+        sums.r += src[0];
+        sums.g += src[1];
+        sums.b += src[2];
+        if (histogram) ++sums.histogram[i & 3][_lumaBin(src[0], src[1], src[2])];
+    }
+}
+
+#if defined(SYNCORDER_X86)
+/**
+ * pshufb masks that gather channel c of 16 RGB pixels out of the 3 source
+ * vectors; entry [c][k] picks from vector k, -1 lanes are zeroed
+ */
+struct _RgbShuffle {
+    alignas(16) std::int8_t mask[3][3][16];
+
+    _RgbShuffle() {
+        for (int c = 0; c < 3; ++c) {
+            for (int k = 0; k < 3; ++k) {
+                for (int j = 0; j < 16; ++j) {
+                    int index = 3 * j + c - 16 * k;
+                    mask[c][k][j] = static_cast<std::int8_t>(index >= 0 && index < 16 ? index : -1);
+                }
+            }
+        }
+    }
+
+    static const _RgbShuffle& get() {
+        static const _RgbShuffle shuffle;
+        return shuffle;
+    }
+};
+
+inline void _colorHistogram(const std::uint8_t* bins, std::size_t count, _ColorSums& sums) {
+    for (std::size_t i = 0; i < count; ++i) ++sums.histogram[i & 3][bins[i]];
+}
+
+/**
+ * AVX2 histogram without scatter: one 8-bit counter lane per (bin, byte
+ * position), bumped with cmpeq / sub and folded into the totals with psadbw
+ * before the counters can wrap (every 255 vectors). With 16-byte vectors the
+ * extra compares cost more than the scalar increments, so SSE4.1 stores the
+ * bins and uses _colorHistogram instead.
+ */
+constexpr int COLOR_COUNTER_FLUSH = 255;
+
+SYNCORDER_TARGET_AVX2
+inline void _histogramFlush256(__m256i* counters, std::uint32_t* histogram) {
+    alignas(32) std::uint64_t lanes[4];
+    for (int bin = 0; bin < COLOR_HISTOGRAM_BINS; ++bin) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_sad_epu8(counters[bin], _mm256_setzero_si256()));
+        histogram[bin] += static_cast<std::uint32_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+        counters[bin] = _mm256_setzero_si256();
+    }
+}
+
+SYNCORDER_TARGET_SSE41
+inline __m128i _lumaBins128(__m128i r16, __m128i g16, __m128i b16) {
+    __m128i y = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(r16, _mm_set1_epi16(77)),
+                                            _mm_mullo_epi16(g16, _mm_set1_epi16(150))),
+                              _mm_mullo_epi16(b16, _mm_set1_epi16(29)));
+    return _mm_srli_epi16(y, COLOR_HISTOGRAM_SHIFT);
+}
+
+/**
+ * 16 pixels of R / G / B bytes -> 16 histogram bin indices
+ */
+SYNCORDER_TARGET_SSE41
+inline __m128i _lumaBins128(__m128i r, __m128i g, __m128i b, __m128i zero) {
+    __m128i lo = _lumaBins128(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero), _mm_unpacklo_epi8(b, zero));
+    __m128i hi = _lumaBins128(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero), _mm_unpackhi_epi8(b, zero));
+    return _mm_packus_epi16(lo, hi);
+}
+
+SYNCORDER_TARGET_SSE41
+inline void _colorSumsSse41(const std::uint8_t* src, std::size_t count, bool histogram, _ColorSums& sums) {
+    const _RgbShuffle& shuffle = _RgbShuffle::get();
+    const __m128i zero = _mm_setzero_si128();
+    __m128i mask[3][3];
+    for (int c = 0; c < 3; ++c) {
+        for (int k = 0; k < 3; ++k) mask[c][k] = _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle.mask[c][k]));
+    }
+
+    __m128i sum[3] = {zero, zero, zero};
+    alignas(16) std::uint8_t bins[16];
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(src + 3 * i);
+        __m128i v[3] = {_mm_loadu_si128(p), _mm_loadu_si128(p + 1), _mm_loadu_si128(p + 2)};
+
+        __m128i channel[3];
+        for (int c = 0; c < 3; ++c) {
+            channel[c] = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v[0], mask[c][0]), _mm_shuffle_epi8(v[1], mask[c][1])),
+                                      _mm_shuffle_epi8(v[2], mask[c][2]));
+            sum[c] = _mm_add_epi64(sum[c], _mm_sad_epu8(channel[c], zero));
+        }
+
+        if (histogram) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(bins), _lumaBins128(channel[0], channel[1], channel[2], zero));
+            _colorHistogram(bins, 16, sums);
+        }
+    }
+
+    alignas(16) std::uint64_t lanes[2];
+    std::uint64_t* totals[3] = {&sums.r, &sums.g, &sums.b};
+    for (int c = 0; c < 3; ++c) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum[c]);
+        *totals[c] += lanes[0] + lanes[1];
+    }
+
+    _colorSumsScalar(src + 3 * i, count - i, histogram, sums);
+}
+
+SYNCORDER_TARGET_AVX2
+inline __m256i _lumaBins256(__m256i r16, __m256i g16, __m256i b16) {
+    __m256i y = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(r16, _mm256_set1_epi16(77)),
+                                                  _mm256_mullo_epi16(g16, _mm256_set1_epi16(150))),
+                                 _mm256_mullo_epi16(b16, _mm256_set1_epi16(29)));
+    return _mm256_srli_epi16(y, COLOR_HISTOGRAM_SHIFT);
+}
+
+/**
+ * 32 pixels -> 32 bin indices; the order inside the vector does not matter
+ * for a histogram, so the per-lane unpack / pack needs no cross-lane fixup
+ */
+SYNCORDER_TARGET_AVX2
+inline __m256i _lumaBins256(__m256i r, __m256i g, __m256i b, __m256i zero) {
+    __m256i lo = _lumaBins256(_mm256_unpacklo_epi8(r, zero), _mm256_unpacklo_epi8(g, zero), _mm256_unpacklo_epi8(b, zero));
+    __m256i hi = _lumaBins256(_mm256_unpackhi_epi8(r, zero), _mm256_unpackhi_epi8(g, zero), _mm256_unpackhi_epi8(b, zero));
+    return _mm256_packus_epi16(lo, hi);
+}
+
+SYNCORDER_TARGET_AVX2
+inline void _colorSumsAvx2(const std::uint8_t* src, std::size_t count, bool histogram, _ColorSums& sums) {
+    const _RgbShuffle& shuffle = _RgbShuffle::get();
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i mask[3][3];
+    for (int c = 0; c < 3; ++c) {
+        for (int k = 0; k < 3; ++k) mask[c][k] = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(shuffle.mask[c][k])));
+    }
+
+    __m256i sum[3] = {zero, zero, zero};
+    __m256i counters[COLOR_HISTOGRAM_BINS];
+    for (auto& counter : counters) counter = zero;
+    int pending = 0;
+
+    // 32 pixels: pixels 0..15 in the low 128-bit lanes, 16..31 in the high ones
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(src + 3 * i);
+        __m256i v[3];
+        for (int k = 0; k < 3; ++k) {
+            v[k] = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(p + k)), _mm_loadu_si128(p + 3 + k), 1);
+        }
+
+        __m256i channel[3];
+        for (int c = 0; c < 3; ++c) {
+            channel[c] = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(v[0], mask[c][0]), _mm256_shuffle_epi8(v[1], mask[c][1])),
+                                         _mm256_shuffle_epi8(v[2], mask[c][2]));
+            sum[c] = _mm256_add_epi64(sum[c], _mm256_sad_epu8(channel[c], zero));
+        }
+
+        if (histogram) {
+            __m256i bins = _lumaBins256(channel[0], channel[1], channel[2], zero);
+            for (int bin = 0; bin < COLOR_HISTOGRAM_BINS; ++bin) {
+                counters[bin] = _mm256_sub_epi8(counters[bin], _mm256_cmpeq_epi8(bins, _mm256_set1_epi8(static_cast<char>(bin))));
+            }
+            if (++pending == COLOR_COUNTER_FLUSH) {
+                _histogramFlush256(counters, sums.histogram[0]);
+                pending = 0;
+            }
+        }
+    }
+    if (pending) _histogramFlush256(counters, sums.histogram[0]);
+
+    alignas(32) std::uint64_t lanes[4];
+    std::uint64_t* totals[3] = {&sums.r, &sums.g, &sums.b};
+    for (int c = 0; c < 3; ++c) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum[c]);
+        *totals[c] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    _colorSumsScalar(src + 3 * i, count - i, histogram, sums);
+}
+#endif
+
+/**
+ * whole-frame colour summary; frame is width * height packed RGB8 pixels
+ */
+inline ColorAnalysis analyzeColor(const std::uint8_t* frame, int width, int height, bool histogram = true, SimdLevel level = simdLevel()) {
+    ColorAnalysis analysis;
+    if (!frame || width <= 0 || height <= 0) return analysis;
+
+    std::size_t pixels = static_cast<std::size_t>(width) * height;
+    _ColorSums sums;
+
+#if defined(SYNCORDER_X86)
+    if (level >= SimdLevel::AVX2) _colorSumsAvx2(frame, pixels, histogram, sums);
+    else if (level >= SimdLevel::SSE41) _colorSumsSse41(frame, pixels, histogram, sums);
+    else _colorSumsScalar(frame, pixels, histogram, sums);
+#else
+    _colorSumsScalar(frame, pixels, histogram, sums);
+#endif
+
+    const std::uint8_t* center = frame + 3 * (static_cast<std::size_t>(height / 2) * width + width / 2);
+    analysis.center_r = center[0];
+    analysis.center_g = center[1];
+    analysis.center_b = center[2];
+
+    analysis.mean_r = static_cast<uint8_t>(sums.r / pixels);
+    analysis.mean_g = static_cast<uint8_t>(sums.g / pixels);
+    analysis.mean_b = static_cast<uint8_t>(sums.b / pixels);
+    analysis.avg_brightness = static_cast<uint8_t>((77 * sums.r + 150 * sums.g + 29 * sums.b) / (256 * pixels));
+
+    if (histogram) {
+        analysis.has_histogram = true;
+        for (int bin = 0; bin < COLOR_HISTOGRAM_BINS; ++bin) {
+            for (int copy = 0; copy < 4; ++copy) analysis.histogram[bin] += sums.histogram[copy][bin];
+        }
+        analysis.dark_ratio = static_cast<float>(static_cast<double>(analysis.histogram[0]) / pixels);
+        analysis.bright_ratio = static_cast<float>(static_cast<double>(analysis.histogram[COLOR_HISTOGRAM_BINS - 1]) / pixels);
+    }
+    return analysis;
+}
+
+/**
+ * EXPOSURE_DARK / EXPOSURE_BRIGHT bits when more than COLOR_CLIP_RATIO of the
+ * frame sits in the first / last histogram bin
+ */
+inline uint8_t exposureFlags(const ColorAnalysis& analysis) {
+    uint8_t flags = EXPOSURE_OK;
+    if (analysis.dark_ratio > COLOR_CLIP_RATIO) flags |= EXPOSURE_DARK;
+    if (analysis.bright_ratio > COLOR_CLIP_RATIO) flags |= EXPOSURE_BRIGHT;
+    return flags;
+}
@@ -5,114 +5,317 @@
 #include <chrono>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
 #include <filesystem>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <memory>
+#include <cmath>
 
 // local
 #include <Syncorder/gonfig/gonfig.h>
 #include <Syncorder/error/exception.h>
 #include <Syncorder/devices/common/broker_base.h>
+#include <Syncorder/devices/common/csv_writer.h>
+#include <Syncorder/devices/common/container.h>
+#include <Syncorder/devices/common/gaze_join.h>
 #include <Syncorder/devices/realsense/model.h>
+#include <Syncorder/devices/realsense/record.h>
+#include <Syncorder/devices/realsense/analysis.h>
+#include <Syncorder/devices/realsense/encoder.h>
+#include <Syncorder/devices/realsense/depth_writer.h>
+#include <Syncorder/devices/realsense/buffer.cpp>
 
 #include <librealsense2/rs.hpp>
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include "stb_image_write.h"
-
-
-/**
- * @helper: struct
- */
-
-struct DepthAnalysis {
-    uint16_t center_depth = 0;
-    float valid_pixel_ratio = 0.0f;
-    uint16_t min_depth = 65535;
-    uint16_t max_depth = 0;
-    uint16_t avg_depth = 0;
-};
-
-struct ColorAnalysis {
-    uint8_t center_r = 0;
-    uint8_t center_g = 0;
-    uint8_t center_b = 0;
-    uint8_t avg_brightness = 0;
-};
-
-struct FrameTask {
-    rs2::frame color_frame;
-    rs2::frame depth_frame;
-    uint64_t frame_number;
-    bool has_color;
-    bool has_depth;
-    std::string output_dir;
-    
-    FrameTask(const RealsenseBufferData& data, const std::string& output) 
-        : color_frame(data.color_frame_)
-        , depth_frame(data.depth_frame_)
-        , frame_number(data.frame_number_)
-        , has_color(data.has_color_)
-        , has_depth(data.has_depth_)
-        , output_dir(output) {}
-};
 
 
 /**
  * @class Broker
+ *
+ * gonfig.container writes RealsenseRecord rows to the "realsense" channel of
+ * the shared session container instead of realsense_data.csv (message time =
+ * system time in ns).
+ *
+ * Every record carries the callback's host monotonic time and the device
+ * timestamp aligned to that clock by clock_ (ClockAligner).
+ *
+ * gonfig.encode_workers > 0 also hands every encode_every-th frameset to a
+ * FrameEncoder that saves PNG stills under realsense/ on its own workers.
+ * gonfig.depth_workers > 0 hands every depth frame to a DepthWriter that
+ * stores it losslessly as RVL (depth/depth_<frame>.rvl).
+ * gonfig.gaze_join hands every frame's aligned time to the session
+ * GazeJoiner, which pairs it with the Tobii gaze around it (gaze_join.h).
+ *
+ * The console status line is printed at most once per
+ * gonfig.status_interval_ms; per-batch numbers belong in metrics.csv.
  */
 
-class RealsenseBroker : public TBBroker<RealsenseBufferData> {
+class RealsenseBroker : public TBBroker<RealsenseBufferData, RealsenseBuffer> {
 private:
-    std::ofstream csv_;
+    CsvWriter csv_;
     std::string output_;
 
+    // capture ticks -> host / wall ns, taken once per batch
+    TimestampMapping stamps_;
+
+    // container
+    std::shared_ptr<ContainerWriter> container_;
+    std::uint16_t channel_ = 0;
+    std::vector<RealsenseRecord> records_;
+    std::vector<std::int64_t> times_;
+    std::uint64_t container_bytes_ = 0;
+    std::uint64_t container_stall_ns_ = 0;
+
+    // stills, lossless depth
+    std::unique_ptr<FrameEncoder> encoder_;
+    std::unique_ptr<DepthWriter> depth_writer_;
+
+    // gaze join
+    std::shared_ptr<GazeJoiner> joiner_;
+    std::vector<GazeJoinFrame> join_frames_;
+
+    // ExposureFlag bits of the last colour frame, shown on the status line
+    std::uint8_t exposure_ = EXPOSURE_OK;
+
+    // status line, at most once per gonfig.status_interval_ms
+    std::chrono::steady_clock::time_point next_status_;
+
+    static_assert(COLOR_HISTOGRAM_BINS == sizeof(RealsenseRecord::luma_histogram) / sizeof(std::uint16_t), "record histogram size");
+
 public:
     RealsenseBroker() {
         output_ = gonfig.output_path + "realsense/";
+        clock_.configure(gonfig.clock_window_s, gonfig.clock_gate);
+
+        FileWriterOptions writer = makeWriterOptions(gonfig.writer, gonfig.writer_direct, gonfig.writer_block_kb, gonfig.writer_blocks, gonfig.segment_mb, gonfig.segment_seconds);
+
+        if (gonfig.encode_workers > 0) {
+            encoder_ = std::make_unique<FrameEncoder>(output_, gonfig.encode_workers, gonfig.encode_queue,
+                                                      parseOverflowPolicy(gonfig.encode_policy), std::chrono::microseconds(gonfig.overflow_block_us));
+        }
+        if (gonfig.depth_workers > 0) {
+            depth_writer_ = std::make_unique<DepthWriter>(output_, gonfig.depth_workers, gonfig.depth_queue,
+                                                          parseOverflowPolicy(gonfig.depth_policy), std::chrono::microseconds(gonfig.overflow_block_us));
+        }
+
+        if (gonfig.gaze_join) {
+            joiner_ = GazeJoiner::shared(gonfig.output_path + "realsense_gaze.csv", writer, gonfig.join_tolerance_ms * 1000000LL, gonfig.join_capacity);
+            if (!joiner_) throw RealsenseDeviceError("cannot open " + gonfig.output_path + "realsense_gaze.csv");
+            join_frames_.reserve(BROKER_BATCH_SIZE);
+        }
+
+        if (gonfig.container) {
+            container_ = ContainerWriter::shared(gonfig.output_path + "session.scap", writer, gonfig.container_chunk_kb * 1024, gonfig.container_compress);
+            if (!container_) throw RealsenseDeviceError("cannot open " + gonfig.output_path + "session.scap");
+            channel_ = container_->addChannel<RealsenseRecord>();
+            records_.reserve(BROKER_BATCH_SIZE);
+            times_.reserve(BROKER_BATCH_SIZE);
+            return;
+        }
 
         std::filesystem::create_directories(output_);
 
-        csv_.open(output_ + "realsense_data.csv");
-        csv_ 
-            << "DeviceTimestamp,"
-            << "SystemTime,"
-            << "CenterDepth,"
-            << "HasColor,"
-            << "HasDepth\n";
+        if (!csv_.open(output_ + "realsense_data.csv", writer)) throw RealsenseDeviceError("cannot open " + output_ + "realsense_data.csv");
+        csv_
+            .text("DeviceTimestamp,")
+            .text("SystemTime,")
+            .text("CenterDepth,")
+            .text("HasColor,")
+            .text("HasDepth,")
+            .text("ValidDepthRatio,")
+            .text("MinDepth,")
+            .text("MaxDepth,")
+            .text("AvgDepth,")
+            .text("Brightness,")
+            .text("MeanR,")
+            .text("MeanG,")
+            .text("MeanB,")
+            .text("DarkRatio,")
+            .text("BrightRatio,")
+            .text("Exposure");
+        if (gonfig.color_histogram) {
+            for (int bin = 0; bin < COLOR_HISTOGRAM_BINS; ++bin) csv_.text(",Luma").integer(bin);
+        }
+        csv_.text(",HostTime,AlignedTime\n");
+        csv_.flush();
     }
 
     ~RealsenseBroker() {
+        encoder_.reset();
+        depth_writer_.reset();
         csv_.close();
     }
 
 public:
+    /**
+     * after stop(): finish the stills / depth frames still queued and print their reports
+     */
     void cleanup() {
-        // _convert();
+        if (encoder_) {
+            encoder_->shutdown();
+            encoder_->report();
+        }
+        if (depth_writer_) {
+            depth_writer_->shutdown();
+            depth_writer_->report();
+        }
     }
 
 protected:
     void _process(const RealsenseBufferData& data) override {
-        auto sys_ms = std::chrono::duration_cast<std::chrono::milliseconds>(data.sys_time_.time_since_epoch()).count();
-        
-        uint16_t center_depth_mm = 0;
+        _process_batch(&data, 1);
+    }
+
+    void _process_batch(const RealsenseBufferData* data, std::size_t count) override {
+        stamps_ = timestamps().mapping();
+
+        if (container_) {
+            records_.clear();
+            times_.clear();
+            for (std::size_t i = 0; i < count; ++i) {
+                records_.push_back(_record(data[i]));
+                times_.push_back(stamps_.wallNs(data[i].capture_ticks_));
+            }
+            container_stall_ns_ += container_->writeRecords(channel_, times_.data(), records_.data(), count);
+            container_bytes_ += count * (sizeof(MessageHeader) + sizeof(RealsenseRecord));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) _write(_record(data[i]));
+            csv_.flush();
+        }
+
+        if (joiner_) {
+            joiner_->pushFrames(join_frames_.data(), join_frames_.size());
+            join_frames_.clear();
+        }
+        if (depth_writer_) {
+            for (std::size_t i = 0; i < count; ++i) depth_writer_->submit(data[i]);
+        }
+        if (encoder_) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (data[i].frame_number_ % static_cast<std::uint64_t>(gonfig.encode_every) == 0) encoder_->submit(data[i]);
+            }
+        }
+
+        _status(data[count - 1], count);
+    }
+
+    std::uint64_t _written() override {
+        return (container_ ? container_bytes_ : csv_.bytes()) + (depth_writer_ ? depth_writer_->written() : 0);
+    }
+
+    std::uint64_t _stalled() override {
+        return container_ ? container_stall_ns_ : csv_.stallNs();
+    }
+
+private:
+    /**
+     * console status of the batch's last frame; rate limited, since console
+     * writes are synchronous and this runs on the capture path
+     */
+    void _status(const RealsenseBufferData& last, std::size_t count) {
+        if (gonfig.status_interval_ms <= 0) return;
+
+        auto now = std::chrono::steady_clock::now();
+        if (now < next_status_) return;
+        next_status_ = now + std::chrono::milliseconds(gonfig.status_interval_ms);
+
+        auto sys_ms = stamps_.wallNs(last.capture_ticks_) / 1000000;
+
+        std::cout << "Device timestamp (ms): " << last.device_timestamp_ << ", "
+            << "System time (ms): " << sys_ms << ", "
+            << "Offset: " << (sys_ms - last.device_timestamp_) << " ms"
+            << (count > 1 ? " (batch of " + std::to_string(count) + ")" : "")
+            << (exposure_ & EXPOSURE_DARK ? " [underexposed]" : "")
+            << (exposure_ & EXPOSURE_BRIGHT ? " [overexposed]" : "")
+            << (encoder_ ? ", encode queue: " + std::to_string(encoder_->depth()) + "/" + std::to_string(encoder_->capacity()) : "")
+            << (depth_writer_ ? ", rvl queue: " + std::to_string(depth_writer_->depth()) + "/" + std::to_string(depth_writer_->capacity()) : "") << "\n";
+    }
+
+    RealsenseRecord _record(const RealsenseBufferData& data) {
+        RealsenseRecord record = {};
+        record.device_timestamp = data.device_timestamp_;
+        record.system_time_ms = stamps_.wallNs(data.capture_ticks_) / 1000000;
+        record.frame_number = data.frame_number_;
+        record.has_color = data.has_color_ ? 1 : 0;
+        record.has_depth = data.has_depth_ ? 1 : 0;
+
+        // device timestamp (ms) -> host monotonic ns
+        record.host_time_ns = stamps_.hostNs(data.capture_ticks_);
+        record.aligned_time_ns = clock_.align(std::llround(data.device_timestamp_ * 1e6), record.host_time_ns);
+        if (joiner_) join_frames_.push_back({record.frame_number, record.aligned_time_ns});
+
         if (data.has_depth_) {
             auto depth_frame = data.depth_frame_.as<rs2::depth_frame>();
-            float distance_m = depth_frame.get_distance(depth_frame.get_width() / 2, depth_frame.get_height() / 2);
-            center_depth_mm = static_cast<uint16_t>(distance_m * 1000);
+            DepthAnalysis depth = analyzeDepth(static_cast<const std::uint16_t*>(depth_frame.get_data()), depth_frame.get_width(), depth_frame.get_height());
+
+            // raw Z16 units -> mm (1 unit = 1 mm on the default depth preset); coarser
+            // units (high-range presets) can exceed the u16 field, so saturate at 65535
+            float mm_per_unit = depth_frame.get_units() * 1000.0f;
+            auto to_mm = [&](std::uint16_t value) {
+                long mm = std::lround(value * mm_per_unit);
+                return static_cast<std::uint16_t>(mm < 65535 ? mm : 65535);
+            };
+
+            record.center_depth_mm = to_mm(depth.center_depth);
+            record.depth_valid_ratio = depth.valid_pixel_ratio;
+            record.depth_min_mm = to_mm(depth.min_depth);
+            record.depth_max_mm = to_mm(depth.max_depth);
+            record.depth_avg_mm = to_mm(depth.avg_depth);
         }
 
-        std::cout << "Device timestamp (ms): " << data.device_timestamp_ << ", "
-            << "System time (ms): " << sys_ms << ", "
-            << "Offset: " << (sys_ms - data.device_timestamp_) << " ms\n";
+        if (data.has_color_) {
+            auto color_frame = data.color_frame_.as<rs2::video_frame>();
+            int width = color_frame.get_width();
+
+            // RGB8 stream (device.cpp); anything else is left at zero
+            if (color_frame.get_bytes_per_pixel() == 3 && color_frame.get_stride_in_bytes() == width * 3) {
+                ColorAnalysis color = analyzeColor(static_cast<const std::uint8_t*>(color_frame.get_data()), width, color_frame.get_height(), gonfig.color_histogram);
+
+                record.brightness = color.avg_brightness;
+                record.mean_r = color.mean_r;
+                record.mean_g = color.mean_g;
+                record.mean_b = color.mean_b;
+                record.dark_ratio = color.dark_ratio;
+                record.bright_ratio = color.bright_ratio;
+                record.exposure = exposureFlags(color);
+                exposure_ = record.exposure;
 
+                if (color.has_histogram) {
+                    double pixels = static_cast<double>(width) * color_frame.get_height();
+                    for (int bin = 0; bin < COLOR_HISTOGRAM_BINS; ++bin) {
+                        record.luma_histogram[bin] = static_cast<std::uint16_t>(std::lround(color.histogram[bin] * 1000.0 / pixels));
+                    }
+                }
+            }
+        }
+        return record;
+    }
 
-        csv_ 
-            << std::fixed << std::setprecision(2) << data.device_timestamp_ << ","
-            << sys_ms << ","
-            << center_depth_mm << ","
-            << (data.has_color_ ? 1 : 0) << ","
-            << (data.has_depth_ ? 1 : 0) << "\n";
+    void _write(const RealsenseRecord& record) {
+        // device timestamp: std::fixed << std::setprecision(2)
+        csv_
+            .fixed(record.device_timestamp, 2).put(',')
+            .integer(record.system_time_ms).put(',')
+            .integer(record.center_depth_mm).put(',')
+            .integer(record.has_color).put(',')
+            .integer(record.has_depth).put(',')
+            .fixed(record.depth_valid_ratio, 4).put(',')
+            .integer(record.depth_min_mm).put(',')
+            .integer(record.depth_max_mm).put(',')
+            .integer(record.depth_avg_mm).put(',')
+            .integer(record.brightness).put(',')
+            .integer(record.mean_r).put(',')
+            .integer(record.mean_g).put(',')
+            .integer(record.mean_b).put(',')
+            .fixed(record.dark_ratio, 4).put(',')
+            .fixed(record.bright_ratio, 4).put(',')
+            .integer(record.exposure);
+        if (gonfig.color_histogram) {
+            for (int bin = 0; bin < COLOR_HISTOGRAM_BINS; ++bin) csv_.put(',').integer(record.luma_histogram[bin]);
+        }
+        csv_
+            .put(',').integer(record.host_time_ns)
+            .put(',').integer(record.aligned_time_ns).put('\n');
     }
 };
\ No newline at end of file
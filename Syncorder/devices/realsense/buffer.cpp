@@ -12,25 +12,14 @@
 
 // local
 #include <Syncorder/error/exception.h>
-#include <Syncorder/devices/common/buffer_base.h>
+#include <Syncorder/devices/common/mbuffer_base.h>
 #include <Syncorder/devices/realsense/model.h>
 
 
 /**
- * @class Buffer
+ * @class Buffer - multi-producer: librealsense may deliver from several sensor threads
  */
 
 constexpr std::size_t REALSENSE_RING_BUFFER_SIZE = 1024;
 
-class RealsenseBuffer : public BBuffer<RealsenseBufferData, REALSENSE_RING_BUFFER_SIZE> {
-    public:
-    static void* dequeue(void* instance) {
-        auto* buffer = static_cast<RealsenseBuffer*>(instance);
-        auto result = buffer->_dequeue();
-        if (!result.has_value()) return nullptr;
-        
-        return new RealsenseBufferData(std::move(result.value()));
-    }
-protected:
-    void onOverflow() noexcept override { std::cout << "[RealsenseBuffer Warning] Buffer overflow\n"; }
-};
\ No newline at end of file
+class RealsenseBuffer : public MBuffer<RealsenseBufferData, REALSENSE_RING_BUFFER_SIZE> {};
\ No newline at end of file
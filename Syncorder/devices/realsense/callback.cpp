@@ -57,6 +57,8 @@ public:
 
 private:
     void _onFrameset(const rs2::frame& frame) {
+        std::int64_t entry_ns = traceNow();
+
         // flag
         if (!first_frame_received_.load()) first_frame_received_.store(true);
 
@@ -64,6 +66,8 @@ private:
             if (buffer_) {
                 auto* rs_buffer = static_cast<RealsenseBuffer*>(buffer_);
                 RealsenseBufferData data = _map(fs);
+                data.traceCallback(entry_ns);
+                data.traceEnqueue();
                 rs_buffer->enqueue(std::move(data));
             }
         }
@@ -73,7 +77,7 @@ private:
     RealsenseBufferData _map(const rs2::frameset& fs) {
         return RealsenseBufferData(
             fs,
-            std::chrono::system_clock::now(),
+            timestamps().now(),
             fs.get_timestamp()
         );
     }
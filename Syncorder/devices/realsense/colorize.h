@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+// local
+#include <Syncorder/devices/common/simd.h>
+
+
+/**
+ * Depth visualization - Z16 millimetres to turbo-coloured RGB24
+ *
+ * Same mapping as the old ffmpeg pipeline (scripts/ops/convert.bat):
+ *   index = v == 0 ? 0 : clip((v - 200) * 255 / 9800, 0, 255)
+ *   rgb   = turbo(index / 255)   (Mikhailov polynomial, as ffmpeg pseudocolor)
+ *
+ * The index step runs on 16-bit lanes: saturating subtract, clamp, then
+ * x * 255 / 9800 as (x * 6 + mulhi(x, 43335)) >> 8, which equals
+ * floor(x * 255 / 9800) for every x in [0, 9800]. The colour step is a
+ * 256-entry table lookup.
+ */
+
+constexpr std::uint16_t DEPTH_NEAR_MM = 200;
+constexpr std::uint16_t DEPTH_FAR_MM = 10000;
+constexpr std::uint16_t DEPTH_RANGE_MM = DEPTH_FAR_MM - DEPTH_NEAR_MM;
+constexpr std::uint16_t DEPTH_SCALE_MUL = 6;         // 436551 >> 16
+constexpr std::uint16_t DEPTH_SCALE_MULHI = 43335;   // 436551 & 0xffff, 436551 = ceil(255 << 24 / 9800)
+
+using TurboLut = std::array<std::uint32_t, 256>;    // 0x00BBGGRR, bytes in memory are R, G, B, 0
+
+/**
+ * turbo colormap sampled at 256 points
+ */
+inline const TurboLut& turboLut() {
+    static const TurboLut lut = [] {
+        static const double coeffs[3][6] = {
+            {0.13572138, 4.61539260, -42.66032258, 132.13108234, -152.94239396, 59.28637943},
+            {0.09140261, 2.19418839, 4.84296658, -14.18503333, 4.27729857, 2.82956604},
+            {0.10667330, 12.64194608, -60.58204836, 110.36276771, -89.90310912, 27.34824973},
+        };
+
+        TurboLut table{};
+        for (int i = 0; i < 256; ++i) {
+            double t = i / 255.0;
+            std::uint8_t rgb[4] = {0, 0, 0, 0};
+            for (int c = 0; c < 3; ++c) {
+                const double* k = coeffs[c];
+                double value = k[0] + t * (k[1] + t * (k[2] + t * (k[3] + t * (k[4] + t * k[5]))));
+                value = value < 0.0 ? 0.0 : (value > 1.0 ? 1.0 : value);
+                rgb[c] = static_cast<std::uint8_t>(std::lround(value * 255.0));
+            }
+            std::memcpy(&table[i], rgb, 4);
+        }
+        return table;
+    }();
+    return lut;
+}
+
+inline std::uint8_t depthIndex(std::uint16_t value) {
+    unsigned x = value > DEPTH_NEAR_MM ? value - DEPTH_NEAR_MM : 0;
+    if (x > DEPTH_RANGE_MM) x = DEPTH_RANGE_MM;
+    return static_cast<std::uint8_t>(x * 255 / DEPTH_RANGE_MM);
+}
+
+inline void _depthToIndexScalar(const std::uint16_t* src, std::uint8_t* dst, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) dst[i] = depthIndex(src[i]);
+}
+
+#if defined(SYNCORDER_X86)
+inline __m128i _depthIndex128(__m128i v) {
+    const __m128i near = _mm_set1_epi16(static_cast<short>(DEPTH_NEAR_MM));
+    const __m128i range = _mm_set1_epi16(static_cast<short>(DEPTH_RANGE_MM));
+
+    __m128i x = _mm_subs_epu16(v, near);
+    x = _mm_sub_epi16(x, _mm_subs_epu16(x, range));     // min(x, range) without SSE4.1
+    __m128i y = _mm_add_epi16(_mm_mullo_epi16(x, _mm_set1_epi16(DEPTH_SCALE_MUL)),
+                              _mm_mulhi_epu16(x, _mm_set1_epi16(static_cast<short>(DEPTH_SCALE_MULHI))));
+    return _mm_srli_epi16(y, 8);
+}
+
+inline void _depthToIndexSse2(const std::uint16_t* src, std::uint8_t* dst, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a = _depthIndex128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        __m128i b = _depthIndex128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+    }
+    _depthToIndexScalar(src + i, dst + i, count - i);
+}
+
+SYNCORDER_TARGET_AVX2
+inline __m256i _depthIndex256(__m256i v) {
+    const __m256i near = _mm256_set1_epi16(static_cast<short>(DEPTH_NEAR_MM));
+    const __m256i range = _mm256_set1_epi16(static_cast<short>(DEPTH_RANGE_MM));
+
+    __m256i x = _mm256_min_epu16(_mm256_subs_epu16(v, near), range);
+    __m256i y = _mm256_add_epi16(_mm256_mullo_epi16(x, _mm256_set1_epi16(DEPTH_SCALE_MUL)),
+                                 _mm256_mulhi_epu16(x, _mm256_set1_epi16(static_cast<short>(DEPTH_SCALE_MULHI))));
+    return _mm256_srli_epi16(y, 8);
+}
+
+SYNCORDER_TARGET_AVX2
+inline void _depthToIndexAvx2(const std::uint16_t* src, std::uint8_t* dst, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i a = _depthIndex256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+        __m256i b = _depthIndex256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16)));
+        // packus works per 128-bit lane; restore element order across lanes
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    _depthToIndexSse2(src + i, dst + i, count - i);
+}
+#endif
+
+/**
+ * Z16 -> colormap index (0..255)
+ */
+inline void depthToIndex(const std::uint16_t* src, std::uint8_t* dst, std::size_t count, SimdLevel level = simdLevel()) {
+#if defined(SYNCORDER_X86)
+    if (level >= SimdLevel::AVX2) return _depthToIndexAvx2(src, dst, count);
+    if (level >= SimdLevel::SSE2) return _depthToIndexSse2(src, dst, count);
+#endif
+    _depthToIndexScalar(src, dst, count);
+}
+
+/**
+ * Z16 -> turbo RGB24; rgb holds 3 * count bytes
+ */
+inline void colorizeDepth(const std::uint16_t* src, std::uint8_t* rgb, std::size_t count, SimdLevel level = simdLevel()) {
+    constexpr std::size_t BLOCK = 256;
+    const TurboLut& lut = turboLut();
+    std::uint8_t index[BLOCK];
+
+    for (std::size_t base = 0; base < count; base += BLOCK) {
+        std::size_t n = count - base < BLOCK ? count - base : BLOCK;
+        depthToIndex(src + base, index, n, level);
+
+        // 4-byte stores overlap the next pixel; the very last pixel gets an exact 3-byte copy
+        std::uint8_t* out = rgb + 3 * base;
+        std::size_t wide = base + n == count ? n - 1 : n;
+        for (std::size_t i = 0; i < wide; ++i, out += 3) std::memcpy(out, &lut[index[i]], 4);
+        if (wide != n) std::memcpy(out, &lut[index[wide]], 3);
+    }
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <filesystem>
+
+// local
+#include <Syncorder/devices/common/job_pool.h>
+#include <Syncorder/devices/common/histogram.h>
+#include <Syncorder/devices/common/csv_writer.h>
+#include <Syncorder/devices/realsense/model.h>
+#include <Syncorder/devices/realsense/encoder.h>
+#include <Syncorder/devices/realsense/rvl.h>
+
+#include <librealsense2/rs.hpp>
+
+
+/**
+ * @class DepthWriter - lossless depth frames, RVL-compressed off the broker thread
+ *
+ * RealsenseBroker submits every depth frame; a JobPool of workers compresses
+ * each one independently (rvl.h) and writes depth/depth_<frame>.rvl, so
+ * compression scales with the worker count instead of capping the frame rate.
+ * frame_convert decodes .rvl wherever it used to read .raw.
+ *
+ * A full queue follows the pool's OverflowPolicy (block by default: a depth
+ * frame is data, not a preview). Every frame is logged to depth_rvl.csv
+ * (frame, raw bytes, compressed bytes, encode time); report() prints the
+ * overall ratio and encode time percentiles.
+ */
+
+class DepthWriter {
+private:
+    std::string output_;
+
+    std::atomic<std::uint64_t> raw_bytes_{0};
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> failed_{0};
+    LatencyHistogram encode_time_;
+
+    CsvWriter log_;
+    std::mutex log_mutex_;
+
+    // last: workers use everything above
+    std::unique_ptr<JobPool<FrameTask>> pool_;
+
+public:
+    DepthWriter(const std::string& output, std::size_t workers, std::size_t capacity, OverflowPolicy policy, std::chrono::microseconds block_timeout)
+    :
+        output_(output)
+    {
+        std::filesystem::create_directories(output_ + "depth");
+
+        log_.open(output_ + "depth_rvl.csv");
+        log_.text("FrameNumber,RawBytes,Bytes,EncodeUs\n");
+        log_.flush();
+
+        pool_ = std::make_unique<JobPool<FrameTask>>(workers, capacity, policy, block_timeout, [this](FrameTask& task) { _compress(task); });
+    }
+
+    ~DepthWriter() { shutdown(); }
+
+public:
+    bool submit(const RealsenseBufferData& data) {
+        if (!data.has_depth_) return false;
+        return pool_->submit(FrameTask(data, output_));
+    }
+
+    /**
+     * compress what is still queued, then stop the workers
+     */
+    void shutdown() {
+        pool_->shutdown();
+
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        log_.close();
+    }
+
+    std::size_t depth() const noexcept { return pool_->depth(); }
+    std::size_t capacity() const noexcept { return pool_->capacity(); }
+
+    // compressed bytes on disk so far
+    std::uint64_t written() const noexcept { return bytes_.load(std::memory_order_relaxed); }
+
+    void report() const {
+        double raw_mb = raw_bytes_.load() / 1e6;
+        double mb = bytes_.load() / 1e6;
+
+        std::cout << "[RealSense] Depth RVL: " << pool_->completed() << " / " << pool_->submitted() << " frames, "
+                  << raw_mb << " MB -> " << mb << " MB (" << (mb > 0.0 ? raw_mb / mb : 0.0) << "x), "
+                  << pool_->dropped() << " dropped, " << failed_.load() << " failed, queue max " << pool_->maxDepth() << " / " << pool_->capacity() << "\n";
+        std::cout << "[RealSense] Depth RVL encode p50 " << encode_time_.percentile(50) / 1e6 << " ms, p99 " << encode_time_.percentile(99) / 1e6 << " ms\n";
+    }
+
+private:
+    void _compress(FrameTask& task) {
+        auto frame = task.depth_frame.as<rs2::depth_frame>();
+        int width = frame.get_width();
+        int height = frame.get_height();
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "depth/depth_%06llu.rvl", static_cast<unsigned long long>(task.frame_number));
+
+        auto start = std::chrono::steady_clock::now();
+        static thread_local std::vector<std::uint8_t> out;
+        std::size_t size = rvlEncodeFrame(static_cast<const std::uint16_t*>(frame.get_data()), width, height, frame.get_units(), out);
+
+        std::FILE* file = std::fopen((task.output_dir + name).c_str(), "wb");
+        bool ok = file && std::fwrite(out.data(), 1, size, file) == size;
+        if (file) std::fclose(file);
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        if (!ok) {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::uint64_t raw = static_cast<std::uint64_t>(width) * height * sizeof(std::uint16_t);
+        raw_bytes_.fetch_add(raw, std::memory_order_relaxed);
+        bytes_.fetch_add(size, std::memory_order_relaxed);
+        encode_time_.record(ns);
+
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        log_
+            .integer(task.frame_number).put(',')
+            .integer(raw).put(',')
+            .integer(size).put(',')
+            .integer(ns / 1000).put('\n');
+        log_.flush();
+    }
+};
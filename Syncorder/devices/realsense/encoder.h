@@ -0,0 +1,168 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <filesystem>
+
+// local
+#include <Syncorder/devices/common/job_pool.h>
+#include <Syncorder/devices/common/histogram.h>
+#include <Syncorder/devices/common/csv_writer.h>
+#include <Syncorder/devices/realsense/model.h>
+#include <Syncorder/devices/realsense/colorize.h>
+
+#include <librealsense2/rs.hpp>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+
+/**
+ * @struct FrameTask - one frameset to be saved as stills
+ *
+ * Holds references to the SDK frames, so every queued task keeps its frames
+ * out of librealsense's frame pool until encoded; the encoder queue bound
+ * (gonfig.encode_queue) is what caps that.
+ */
+
+struct FrameTask {
+    rs2::frame color_frame;
+    rs2::frame depth_frame;
+    uint64_t frame_number = 0;
+    bool has_color = false;
+    bool has_depth = false;
+    std::string output_dir;
+
+    FrameTask() = default;
+
+    FrameTask(const RealsenseBufferData& data, const std::string& output)
+        : color_frame(data.color_frame_)
+        , depth_frame(data.depth_frame_)
+        , frame_number(data.frame_number_)
+        , has_color(data.has_color_)
+        , has_depth(data.has_depth_)
+        , output_dir(output) {}
+};
+
+
+/**
+ * @class FrameEncoder - PNG stills off the broker thread
+ *
+ * RealsenseBroker submits FrameTasks; a JobPool of encode workers writes
+ * color/color_<frame>.png (RGB8 as is) and depth/depth_<frame>.png (Z16
+ * through the turbo colormap, as frame_convert) with stb_image_write at
+ * compression level 1. A full queue is handled by the pool's OverflowPolicy,
+ * so a slow disk costs stills, never ring-buffer space.
+ *
+ * Every image is logged to encode.csv (frame, image, queue depth when the
+ * worker picked it up, encode time); report() prints the totals and encode
+ * time percentiles.
+ */
+
+class FrameEncoder {
+private:
+    std::string output_;
+
+    // per-image encode time
+    LatencyHistogram color_time_;
+    LatencyHistogram depth_time_;
+
+    CsvWriter log_;
+    std::mutex log_mutex_;
+
+    // last: workers use everything above
+    std::unique_ptr<JobPool<FrameTask>> pool_;
+
+public:
+    FrameEncoder(const std::string& output, std::size_t workers, std::size_t capacity, OverflowPolicy policy, std::chrono::microseconds block_timeout)
+    :
+        output_(output)
+    {
+        std::filesystem::create_directories(output_ + "color");
+        std::filesystem::create_directories(output_ + "depth");
+        stbi_write_png_compression_level = 1;
+
+        log_.open(output_ + "encode.csv");
+        log_.text("FrameNumber,Image,QueueDepth,EncodeUs\n");
+        log_.flush();
+
+        pool_ = std::make_unique<JobPool<FrameTask>>(workers, capacity, policy, block_timeout, [this](FrameTask& task) { _encode(task); });
+    }
+
+    ~FrameEncoder() { shutdown(); }
+
+public:
+    bool submit(const RealsenseBufferData& data) {
+        if (!data.has_color_ && !data.has_depth_) return false;
+        return pool_->submit(FrameTask(data, output_));
+    }
+
+    /**
+     * encode what is still queued, then stop the workers
+     */
+    void shutdown() {
+        pool_->shutdown();
+
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        log_.close();
+    }
+
+    std::size_t depth() const noexcept { return pool_->depth(); }
+    std::size_t capacity() const noexcept { return pool_->capacity(); }
+    std::uint64_t dropped() const noexcept { return pool_->dropped(); }
+
+    void report() const {
+        auto ms = [](std::uint64_t ns) { return ns / 1e6; };
+
+        std::cout << "[RealSense] Encoder: " << pool_->completed() << " / " << pool_->submitted() << " framesets encoded, "
+                  << pool_->dropped() << " dropped, queue max " << pool_->maxDepth() << " / " << pool_->capacity() << "\n";
+        std::cout << "[RealSense] Encode color p50 " << ms(color_time_.percentile(50)) << " ms, p99 " << ms(color_time_.percentile(99)) << " ms"
+                  << " | depth p50 " << ms(depth_time_.percentile(50)) << " ms, p99 " << ms(depth_time_.percentile(99)) << " ms\n";
+    }
+
+private:
+    void _encode(FrameTask& task) {
+        std::size_t depth = pool_->depth();
+        char name[64];
+
+        if (task.has_color) {
+            auto frame = task.color_frame.as<rs2::video_frame>();
+            std::snprintf(name, sizeof(name), "color/color_%06llu.png", static_cast<unsigned long long>(task.frame_number));
+
+            auto start = std::chrono::steady_clock::now();
+            stbi_write_png((task.output_dir + name).c_str(), frame.get_width(), frame.get_height(), 3, frame.get_data(), frame.get_stride_in_bytes());
+            _log(task, name, depth, color_time_, start);
+        }
+
+        if (task.has_depth) {
+            auto frame = task.depth_frame.as<rs2::depth_frame>();
+            std::snprintf(name, sizeof(name), "depth/depth_%06llu.png", static_cast<unsigned long long>(task.frame_number));
+
+            auto start = std::chrono::steady_clock::now();
+            static thread_local std::vector<std::uint8_t> rgb;
+            std::size_t pixels = static_cast<std::size_t>(frame.get_width()) * frame.get_height();
+            rgb.resize(pixels * 3);
+            colorizeDepth(static_cast<const std::uint16_t*>(frame.get_data()), rgb.data(), pixels);
+            stbi_write_png((task.output_dir + name).c_str(), frame.get_width(), frame.get_height(), 3, rgb.data(), frame.get_width() * 3);
+            _log(task, name, depth, depth_time_, start);
+        }
+    }
+
+    void _log(const FrameTask& task, const char* image, std::size_t depth, LatencyHistogram& histogram, std::chrono::steady_clock::time_point start) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        histogram.record(ns);
+
+        std::lock_guard<std::mutex> lock(log_mutex_);
+        log_
+            .integer(task.frame_number).put(',')
+            .text(image).put(',')
+            .integer(depth).put(',')
+            .integer(ns / 1000).put('\n');
+        log_.flush();
+    }
+};
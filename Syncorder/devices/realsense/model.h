@@ -4,19 +4,23 @@
 #include <chrono>
 #include <librealsense2/rs.hpp>
 
+// local
+#include <Syncorder/devices/common/trace.h>
+#include <Syncorder/devices/common/timestamp.h>
+
 
 /**
  * @struct
  */
 
-struct RealsenseBufferData {
+struct RealsenseBufferData : TraceSlot {
     // frame data
     rs2::frameset frameset_;
     rs2::frame color_frame_;
     rs2::frame depth_frame_;
     
     // time
-    std::chrono::system_clock::time_point sys_time_;
+    std::int64_t capture_ticks_ = 0;    // timestamps().now() in the callback; host / wall time in the broker
     double device_timestamp_;
     
     // metadata
@@ -34,11 +38,11 @@ public:
 
     RealsenseBufferData(
         rs2::frameset frameset,
-        std::chrono::system_clock::time_point sys_time,
+        std::int64_t capture_ticks,
         double device_timestamp
     ) {
         frameset_ = frameset;
-        sys_time_ = sys_time;
+        capture_ticks_ = capture_ticks;
         device_timestamp_ = device_timestamp;
         
         // Extract frames
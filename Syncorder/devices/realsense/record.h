@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <string>
+
+// local
+#include <Syncorder/devices/common/record_log.h>
+
+
+/**
+ * @struct RealsenseRecord - packed per-frame row of realsense_data.csv (schema v4)
+ *
+ * Frame pixels are not part of the record; this is the timing / summary row
+ * the CSV carries, in binary form for the session container.
+ *
+ * v2: whole-frame depth summary (DepthAnalysis) appended.
+ * v3: colour summary (ColorAnalysis) appended; the luma histogram is in
+ *     per-mille of the frame and all zero when gonfig.color_histogram is off.
+ * v4: host monotonic arrival time and the device timestamp aligned to that
+ *     clock (ClockAligner) appended.
+ */
+
+#pragma pack(push, 1)
+
+struct RealsenseRecord {
+    static constexpr std::uint16_t VERSION = 4;
+    static constexpr const char* STREAM = "realsense";
+
+    double device_timestamp;            // ms, device clock
+    std::int64_t system_time_ms;
+    std::uint64_t frame_number;
+    std::uint16_t center_depth_mm;      // depth columns saturate at 65535 mm
+    std::uint8_t has_color;
+    std::uint8_t has_depth;
+    float depth_valid_ratio;            // non-zero pixels / all pixels
+    std::uint16_t depth_min_mm;         // over valid pixels
+    std::uint16_t depth_max_mm;
+    std::uint16_t depth_avg_mm;
+    std::uint8_t brightness;            // mean BT.601 luma
+    std::uint8_t mean_r;
+    std::uint8_t mean_g;
+    std::uint8_t mean_b;
+    float dark_ratio;                   // luma < 16
+    float bright_ratio;                 // luma >= 240
+    std::uint8_t exposure;              // ExposureFlag bits
+    std::uint16_t luma_histogram[16];   // per mille
+    std::int64_t host_time_ns;          // host monotonic clock at the callback
+    std::int64_t aligned_time_ns;       // device_timestamp on the host monotonic clock
+
+    static std::vector<RecordField> schema() {
+        std::vector<RecordField> fields = {
+            recordField("device_timestamp", FieldType::F64, offsetof(RealsenseRecord, device_timestamp)),
+            recordField("system_time_ms", FieldType::I64, offsetof(RealsenseRecord, system_time_ms)),
+            recordField("frame_number", FieldType::U64, offsetof(RealsenseRecord, frame_number)),
+            recordField("center_depth_mm", FieldType::U16, offsetof(RealsenseRecord, center_depth_mm)),
+            recordField("has_color", FieldType::BOOL, offsetof(RealsenseRecord, has_color)),
+            recordField("has_depth", FieldType::BOOL, offsetof(RealsenseRecord, has_depth)),
+            recordField("depth_valid_ratio", FieldType::F32, offsetof(RealsenseRecord, depth_valid_ratio)),
+            recordField("depth_min_mm", FieldType::U16, offsetof(RealsenseRecord, depth_min_mm)),
+            recordField("depth_max_mm", FieldType::U16, offsetof(RealsenseRecord, depth_max_mm)),
+            recordField("depth_avg_mm", FieldType::U16, offsetof(RealsenseRecord, depth_avg_mm)),
+            recordField("brightness", FieldType::U8, offsetof(RealsenseRecord, brightness)),
+            recordField("mean_r", FieldType::U8, offsetof(RealsenseRecord, mean_r)),
+            recordField("mean_g", FieldType::U8, offsetof(RealsenseRecord, mean_g)),
+            recordField("mean_b", FieldType::U8, offsetof(RealsenseRecord, mean_b)),
+            recordField("dark_ratio", FieldType::F32, offsetof(RealsenseRecord, dark_ratio)),
+            recordField("bright_ratio", FieldType::F32, offsetof(RealsenseRecord, bright_ratio)),
+            recordField("exposure", FieldType::U8, offsetof(RealsenseRecord, exposure)),
+        };
+        for (std::size_t bin = 0; bin < 16; ++bin) {
+            std::string name = "luma_histogram_" + std::to_string(bin);
+            fields.push_back(recordField(name.c_str(), FieldType::U16, offsetof(RealsenseRecord, luma_histogram) + bin * sizeof(std::uint16_t)));
+        }
+        fields.push_back(recordField("host_time_ns", FieldType::I64, offsetof(RealsenseRecord, host_time_ns)));
+        fields.push_back(recordField("aligned_time_ns", FieldType::I64, offsetof(RealsenseRecord, aligned_time_ns)));
+        return fields;
+    }
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(RealsenseRecord) == 99, "RealsenseRecord v4 layout is part of the file format");
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+
+/**
+ * RVL - lossless Z16 depth codec (Wilson, "Fast Lossless Depth Image
+ * Compression", 2017)
+ *
+ * The frame is walked as alternating runs: a run of zeros (invalid pixels),
+ * then a run of valid pixels. Each run length is written as a variable-length
+ * integer, and so is every valid pixel, as the zigzag-encoded delta to the
+ * previous valid pixel. Variable-length integers are 3-bit payload nibbles
+ * with a continuation bit, packed eight to a 32-bit word, high nibble first.
+ *
+ * One pass, no tables, no state across frames: a frame compresses and
+ * decompresses independently, so frames can be spread over workers. Typical
+ * depth compresses 3-5x; the round trip is bit exact.
+ *
+ * .rvl file = RvlHeader + payload (little-endian 32-bit words).
+ */
+
+constexpr char RVL_MAGIC[4] = {'R', 'V', 'L', '1'};
+
+#pragma pack(push, 1)
+struct RvlHeader {
+    char magic[4];
+    std::uint16_t width;
+    std::uint16_t height;
+    float depth_units;              // metres per Z16 unit (rs2::depth_frame::get_units)
+    std::uint32_t payload_bytes;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(RvlHeader) == 16, "RvlHeader layout");
+
+/**
+ * worst case in bytes: at most 6 nibbles per valid pixel (17-bit zigzag
+ * delta) plus run lengths, under 8 nibbles = 4 bytes per pixel
+ */
+inline std::size_t rvlBound(std::size_t pixels) {
+    return pixels * 4 + 16;
+}
+
+
+/**
+ * @helper: nibble stream
+ */
+
+class RvlWriter {
+private:
+    std::uint32_t* out_;
+    std::uint32_t word_ = 0;
+    int nibbles_ = 0;
+
+public:
+    explicit RvlWriter(std::uint32_t* out) : out_(out) {}
+
+    void put(std::uint32_t value) {
+        do {
+            std::uint32_t nibble = value & 0x7;
+            value >>= 3;
+            if (value) nibble |= 0x8;
+
+            word_ = (word_ << 4) | nibble;
+            if (++nibbles_ == 8) {
+                *out_++ = word_;
+                word_ = 0;
+                nibbles_ = 0;
+            }
+        } while (value);
+    }
+
+    std::uint32_t* finish() {
+        if (nibbles_) *out_++ = word_ << (4 * (8 - nibbles_));
+        return out_;
+    }
+};
+
+class RvlReader {
+private:
+    const std::uint8_t* in_;        // any alignment: the payload follows a file header
+    const std::uint8_t* end_;
+    std::uint32_t word_ = 0;
+    int nibbles_ = 0;
+
+public:
+    RvlReader(const std::uint8_t* in, std::size_t bytes) : in_(in), end_(in + bytes / sizeof(std::uint32_t) * sizeof(std::uint32_t)) {}
+
+    // false when the payload runs out mid-value
+    bool get(std::uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 32; shift += 3) {
+            if (!nibbles_) {
+                if (in_ == end_) return false;
+                std::memcpy(&word_, in_, sizeof(word_));
+                in_ += sizeof(word_);
+                nibbles_ = 8;
+            }
+            std::uint32_t nibble = word_ >> 28;
+            word_ <<= 4;
+            --nibbles_;
+
+            value |= (nibble & 0x7) << shift;
+            if (!(nibble & 0x8)) return true;
+        }
+        return false;
+    }
+};
+
+
+/**
+ * @helper: codec
+ */
+
+/**
+ * compress pixels Z16 values into out, which must hold rvlBound(pixels)
+ * bytes; returns the payload size in bytes
+ */
+inline std::size_t rvlCompress(const std::uint16_t* src, std::size_t pixels, std::uint32_t* out) {
+    RvlWriter writer(out);
+
+    const std::uint16_t* end = src + pixels;
+    int previous = 0;
+
+    while (src != end) {
+        const std::uint16_t* run = src;
+        while (src != end && *src == 0) ++src;
+        writer.put(static_cast<std::uint32_t>(src - run));
+
+        run = src;
+        while (src != end && *src != 0) ++src;
+        writer.put(static_cast<std::uint32_t>(src - run));
+
+        for (; run != src; ++run) {
+            int delta = *run - previous;
+            writer.put((static_cast<std::uint32_t>(delta) << 1) ^ static_cast<std::uint32_t>(delta >> 31));
+            previous = *run;
+        }
+    }
+
+    return (writer.finish() - out) * sizeof(std::uint32_t);
+}
+
+/**
+ * decompress exactly pixels values into dst; false on a truncated or
+ * corrupt payload (dst is then partly written)
+ */
+inline bool rvlDecompress(const std::uint8_t* payload, std::size_t bytes, std::uint16_t* dst, std::size_t pixels) {
+    if (bytes % sizeof(std::uint32_t)) return false;
+    RvlReader reader(payload, bytes);
+
+    std::uint16_t* end = dst + pixels;
+    int previous = 0;
+
+    while (dst != end) {
+        std::uint32_t zeros, valid;
+        if (!reader.get(zeros) || zeros > static_cast<std::size_t>(end - dst)) return false;
+        std::memset(dst, 0, zeros * sizeof(std::uint16_t));
+        dst += zeros;
+
+        if (!reader.get(valid) || valid > static_cast<std::size_t>(end - dst)) return false;
+        for (std::uint32_t i = 0; i < valid; ++i) {
+            std::uint32_t zigzag;
+            if (!reader.get(zigzag)) return false;
+            previous += static_cast<int>(zigzag >> 1) ^ -static_cast<int>(zigzag & 1);
+            *dst++ = static_cast<std::uint16_t>(previous);
+        }
+    }
+    return true;
+}
+
+/**
+ * header + payload, as written to a .rvl file; returns its size. out only
+ * grows (to the bound), so a per-worker buffer is reused without reclearing
+ */
+inline std::size_t rvlEncodeFrame(const std::uint16_t* src, int width, int height, float depth_units, std::vector<std::uint8_t>& out) {
+    std::size_t pixels = static_cast<std::size_t>(width) * height;
+
+    // vector storage is malloc-aligned, so the words after the 16-byte header are aligned too
+    if (out.size() < sizeof(RvlHeader) + rvlBound(pixels)) out.resize(sizeof(RvlHeader) + rvlBound(pixels));
+    std::size_t bytes = rvlCompress(src, pixels, reinterpret_cast<std::uint32_t*>(out.data() + sizeof(RvlHeader)));
+
+    RvlHeader header = {};
+    std::memcpy(header.magic, RVL_MAGIC, sizeof(header.magic));
+    header.width = static_cast<std::uint16_t>(width);
+    header.height = static_cast<std::uint16_t>(height);
+    header.depth_units = depth_units;
+    header.payload_bytes = static_cast<std::uint32_t>(bytes);
+
+    std::memcpy(out.data(), &header, sizeof(header));
+    return sizeof(header) + bytes;
+}
+
+/**
+ * parse a .rvl file image; dst is resized to width * height
+ */
+inline bool rvlDecodeFrame(const std::uint8_t* data, std::size_t size, RvlHeader& header, std::vector<std::uint16_t>& dst) {
+    if (size < sizeof(RvlHeader)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, RVL_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (sizeof(RvlHeader) + header.payload_bytes > size) return false;
+
+    dst.resize(static_cast<std::size_t>(header.width) * header.height);
+    return rvlDecompress(data + sizeof(RvlHeader), header.payload_bytes, dst.data(), dst.size());
+}
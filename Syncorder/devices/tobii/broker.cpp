@@ -9,65 +9,95 @@
 #include <iomanip>
 #include <sstream>
 #include <filesystem>
+#include <vector>
 
 // local
 #include <Syncorder/gonfig/gonfig.h>
 #include <Syncorder/error/exception.h>
 #include <Syncorder/devices/common/broker_base.h>
+#include <Syncorder/devices/common/container.h>
+#include <Syncorder/devices/common/gaze_join.h>
 #include <Syncorder/devices/tobii/model.h>
+#include <Syncorder/devices/tobii/buffer.cpp>
+#include <Syncorder/devices/tobii/csv.h>
+#include <Syncorder/devices/tobii/record.h>
 
 
 /**
  * @class Broker
+ *
+ * gonfig.tobii_format: "csv" (default) writes tobii_data.csv; "binary" appends
+ * TobiiRecord (schema v2) to tobii_data.rec (see record.h, export with
+ * tobii_export, which also reads v1 files).
+ * gonfig.container puts the same records on the "tobii" channel of the shared
+ * session container instead (message time = wall-clock ns of the capture
+ * stamp, like every other stream).
+ *
+ * Samples are copied into rows_ once per batch so aligned_time_ns (device
+ * time on the host monotonic clock, by clock_) can be filled in before any
+ * output path writes them.
+ *
+ * gonfig.gaze_join also hands every batch to the session GazeJoiner, which
+ * joins it onto the RealSense frames (gaze_join.h).
  */
 
-class TobiiBroker : public TBBroker<TobiiBufferData> {
+class TobiiBroker : public TBBroker<TobiiBufferData, TobiiBuffer> {
 private:
-    std::ofstream csv_;
+    CsvWriter csv_;
     std::string output_;
 
+    // binary
+    bool binary_;
+    RecordLog<TobiiRecord> log_;
+    std::vector<TobiiRecord> records_;
+    std::vector<TobiiBufferData> rows_;
+
+    // container
+    std::shared_ptr<ContainerWriter> container_;
+    std::uint16_t channel_ = 0;
+    std::vector<std::int64_t> times_;
+    std::uint64_t container_bytes_ = 0;
+    std::uint64_t container_stall_ns_ = 0;
+
+    // gaze join
+    std::shared_ptr<GazeJoiner> joiner_;
+    std::vector<GazeSample> gaze_;
+
 public:
     TobiiBroker() {
         output_ = gonfig.output_path + "tobii/";
+        binary_ = gonfig.tobii_format == "binary";
+        clock_.configure(gonfig.clock_window_s, gonfig.clock_gate);
+        rows_.reserve(BROKER_BATCH_SIZE);
+
+        FileWriterOptions writer = makeWriterOptions(gonfig.writer, gonfig.writer_direct, gonfig.writer_block_kb, gonfig.writer_blocks, gonfig.segment_mb, gonfig.segment_seconds);
+
+        if (gonfig.gaze_join) {
+            joiner_ = GazeJoiner::shared(gonfig.output_path + "realsense_gaze.csv", writer, gonfig.join_tolerance_ms * 1000000LL, gonfig.join_capacity);
+            if (!joiner_) throw TobiiDeviceError("cannot open " + gonfig.output_path + "realsense_gaze.csv");
+            gaze_.reserve(BROKER_BATCH_SIZE);
+        }
+
+        if (gonfig.container) {
+            container_ = ContainerWriter::shared(gonfig.output_path + "session.scap", writer, gonfig.container_chunk_kb * 1024, gonfig.container_compress);
+            if (!container_) throw TobiiDeviceError("cannot open " + gonfig.output_path + "session.scap");
+            channel_ = container_->addChannel<TobiiRecord>();
+            records_.reserve(BROKER_BATCH_SIZE);
+            times_.reserve(BROKER_BATCH_SIZE);
+            return;
+        }
 
         std::filesystem::create_directories(output_);
 
-        csv_.open(output_ + "tobii_data.csv");
-        csv_
-            <<"left_gaze_display_x,"
-            <<"left_gaze_display_y,"
-            <<"left_gaze_3d_x,"
-            <<"left_gaze_3d_y,"
-            <<"left_gaze_3d_z,"
-            <<"left_gaze_validity,"
-            <<"right_gaze_display_x,"
-            <<"right_gaze_display_y,"
-            <<"right_gaze_3d_x,"
-            <<"right_gaze_3d_y,"
-            <<"right_gaze_3d_z,"
-            <<"right_gaze_validity,"
-            <<"left_gaze_origin_x,"
-            <<"left_gaze_origin_y,"
-            <<"left_gaze_origin_z,"
-            <<"left_gaze_origin_validity,"
-            <<"right_gaze_origin_x,"
-            <<"right_gaze_origin_y,"
-            <<"right_gaze_origin_z,"
-            <<"right_gaze_origin_validity,"
-            <<"left_pupil_diameter,"
-            <<"left_pupil_validity,"
-            <<"right_pupil_diameter,"
-            <<"right_pupil_validity,"
-            <<"system_time_stamp,"
-            <<"device_time_stamp,"
-            <<"sync_system_request_time,"
-            <<"sync_device_time,"
-            <<"sync_system_response_time,"
-            <<"sync_validity,"
-            <<"left_eye_detected,"
-            <<"right_eye_detected,"
-            <<"is_tracking,"
-            <<"overall_validity\n";
+        if (binary_) {
+            if (!log_.open(output_ + "tobii_data.rec", writer)) throw TobiiDeviceError("cannot open " + output_ + "tobii_data.rec");
+            records_.reserve(BROKER_BATCH_SIZE);
+            return;
+        }
+
+        if (!csv_.open(output_ + "tobii_data.csv", writer)) throw TobiiDeviceError("cannot open " + output_ + "tobii_data.csv");
+        writeTobiiCsvHeader(csv_);
+        csv_.flush();
     }
     ~TobiiBroker() {}
 
@@ -76,46 +106,68 @@ public:
 
 protected:
     void _process(const TobiiBufferData& data) override {
-        _write(data);
+        _process_batch(&data, 1);
+    }
+
+    void _process_batch(const TobiiBufferData* samples, std::size_t count) override {
+        // capture ticks -> host monotonic / wall ns, device time (us) -> host monotonic ns
+        TimestampMapping stamps = timestamps().mapping();
+        rows_.assign(samples, samples + count);
+        for (auto& row : rows_) {
+            row.host_time_ns = stamps.hostNs(row.capture_ticks);
+            row.aligned_time_ns = clock_.align(row.device_time_stamp * 1000, row.host_time_ns);
+        }
+        const TobiiBufferData* data = rows_.data();
+
+        if (joiner_) {
+            gaze_.clear();
+            for (std::size_t i = 0; i < count; ++i) gaze_.push_back(_gaze(data[i]));
+            joiner_->pushGaze(gaze_.data(), count);
+        }
+
+        if (container_) {
+            records_.clear();
+            times_.clear();
+            for (std::size_t i = 0; i < count; ++i) {
+                records_.push_back(toTobiiRecord(data[i]));
+                times_.push_back(stamps.wallNs(data[i].capture_ticks));
+            }
+            container_stall_ns_ += container_->writeRecords(channel_, times_.data(), records_.data(), count);
+            container_bytes_ += count * (sizeof(MessageHeader) + sizeof(TobiiRecord));
+            return;
+        }
+
+        if (!binary_) {
+            for (std::size_t i = 0; i < count; ++i) writeTobiiCsvRow(csv_, data[i]);
+            csv_.flush();
+            return;
+        }
+
+        records_.clear();
+        for (std::size_t i = 0; i < count; ++i) records_.push_back(toTobiiRecord(data[i]));
+        log_.append_n(records_.data(), records_.size());
+    }
+
+    std::uint64_t _written() override {
+        if (container_) return container_bytes_;
+        return binary_ ? log_.bytes() : csv_.bytes();
+    }
+
+    std::uint64_t _stalled() override {
+        if (container_) return container_stall_ns_;
+        return binary_ ? log_.stallNs() : csv_.stallNs();
     }
 
 private:
-    void _write(const TobiiBufferData& data) {
-        csv_
-            << data.left_gaze_point_display_x << ","
-            << data.left_gaze_point_display_y << ","
-            << data.left_gaze_point_3d_x << ","
-            << data.left_gaze_point_3d_y << ","
-            << data.left_gaze_point_3d_z << ","
-            << data.left_gaze_point_validity << ","
-            << data.right_gaze_point_display_x << ","
-            << data.right_gaze_point_display_y << ","
-            << data.right_gaze_point_3d_x << ","
-            << data.right_gaze_point_3d_y << ","
-            << data.right_gaze_point_3d_z << ","
-            << data.right_gaze_point_validity << ","
-            << data.left_gaze_origin_x << ","
-            << data.left_gaze_origin_y << ","
-            << data.left_gaze_origin_z << ","
-            << data.left_gaze_origin_validity << ","
-            << data.right_gaze_origin_x << ","
-            << data.right_gaze_origin_y << ","
-            << data.right_gaze_origin_z << ","
-            << data.right_gaze_origin_validity << ","
-            << data.left_pupil_diameter << ","
-            << data.left_pupil_validity << ","
-            << data.right_pupil_diameter << ","
-            << data.right_pupil_validity << ","
-            << data.system_time_stamp << ","
-            << data.device_time_stamp << ","
-            << data.sync_system_request_time << ","
-            << data.sync_device_time << ","
-            << data.sync_system_response_time << ","
-            << data.sync_validity << ","
-            << data.left_eye_detected << ","
-            << data.right_eye_detected << ","
-            << data.is_tracking << ","
-            << data.overall_validity
-            << "\n";
+    static GazeSample _gaze(const TobiiBufferData& data) {
+        GazeSample sample;
+        sample.time_ns = data.aligned_time_ns;
+        sample.left_x = data.left_gaze_point_display_x;
+        sample.left_y = data.left_gaze_point_display_y;
+        sample.right_x = data.right_gaze_point_display_x;
+        sample.right_y = data.right_gaze_point_display_y;
+        if (data.left_gaze_point_validity == TOBII_RESEARCH_VALIDITY_VALID) sample.valid |= GAZE_LEFT;
+        if (data.right_gaze_point_validity == TOBII_RESEARCH_VALIDITY_VALID) sample.valid |= GAZE_RIGHT;
+        return sample;
     }
 };
\ No newline at end of file
@@ -58,11 +58,15 @@ public:
 
 private:
     void _onGaze(TobiiResearchGazeData* gaze_data) {
+        std::int64_t entry_ns = traceNow();
+
         if (!first_frame_received_.load()) first_frame_received_.store(true);
         if (!gaze_data || !buffer_) return;
 
         auto* tobii_buffer = static_cast<TobiiBuffer*>(buffer_);
         TobiiBufferData data = _map(gaze_data);
+        data.traceCallback(entry_ns);
+        data.traceEnqueue();
         tobii_buffer->enqueue(std::move(data));
     }
 
@@ -73,6 +77,7 @@ private:
         // timestamp
         data.device_time_stamp = gaze_data->device_time_stamp;
         data.system_time_stamp = gaze_data->system_time_stamp;
+        data.capture_ticks = timestamps().now();
         
         // left gaze point
         data.left_gaze_point_display_x = gaze_data->left_eye.gaze_point.position_on_display_area.x;
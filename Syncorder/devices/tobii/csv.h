@@ -0,0 +1,94 @@
+#pragma once
+
+// local
+#include <Syncorder/devices/common/csv_writer.h>
+
+
+/**
+ * @helper: Tobii CSV layout - shared by TobiiBroker and the record exporter
+ * so a regenerated CSV matches a directly recorded one byte for byte.
+ * Templated on the sample type so tools and benches can use it without the SDK.
+ */
+
+constexpr const char* TOBII_CSV_HEADER =
+    "left_gaze_display_x,"
+    "left_gaze_display_y,"
+    "left_gaze_3d_x,"
+    "left_gaze_3d_y,"
+    "left_gaze_3d_z,"
+    "left_gaze_validity,"
+    "right_gaze_display_x,"
+    "right_gaze_display_y,"
+    "right_gaze_3d_x,"
+    "right_gaze_3d_y,"
+    "right_gaze_3d_z,"
+    "right_gaze_validity,"
+    "left_gaze_origin_x,"
+    "left_gaze_origin_y,"
+    "left_gaze_origin_z,"
+    "left_gaze_origin_validity,"
+    "right_gaze_origin_x,"
+    "right_gaze_origin_y,"
+    "right_gaze_origin_z,"
+    "right_gaze_origin_validity,"
+    "left_pupil_diameter,"
+    "left_pupil_validity,"
+    "right_pupil_diameter,"
+    "right_pupil_validity,"
+    "system_time_stamp,"
+    "device_time_stamp,"
+    "sync_system_request_time,"
+    "sync_device_time,"
+    "sync_system_response_time,"
+    "sync_validity,"
+    "left_eye_detected,"
+    "right_eye_detected,"
+    "is_tracking,"
+    "overall_validity,"
+    "host_time_ns,"
+    "aligned_time_ns\n";
+
+inline void writeTobiiCsvHeader(CsvWriter& csv) {
+    csv.text(TOBII_CSV_HEADER);
+}
+
+template<typename Gaze>
+void writeTobiiCsvRow(CsvWriter& csv, const Gaze& data) {
+    csv
+        .floating(data.left_gaze_point_display_x).put(',')
+        .floating(data.left_gaze_point_display_y).put(',')
+        .floating(data.left_gaze_point_3d_x).put(',')
+        .floating(data.left_gaze_point_3d_y).put(',')
+        .floating(data.left_gaze_point_3d_z).put(',')
+        .integer(data.left_gaze_point_validity).put(',')
+        .floating(data.right_gaze_point_display_x).put(',')
+        .floating(data.right_gaze_point_display_y).put(',')
+        .floating(data.right_gaze_point_3d_x).put(',')
+        .floating(data.right_gaze_point_3d_y).put(',')
+        .floating(data.right_gaze_point_3d_z).put(',')
+        .integer(data.right_gaze_point_validity).put(',')
+        .floating(data.left_gaze_origin_x).put(',')
+        .floating(data.left_gaze_origin_y).put(',')
+        .floating(data.left_gaze_origin_z).put(',')
+        .integer(data.left_gaze_origin_validity).put(',')
+        .floating(data.right_gaze_origin_x).put(',')
+        .floating(data.right_gaze_origin_y).put(',')
+        .floating(data.right_gaze_origin_z).put(',')
+        .integer(data.right_gaze_origin_validity).put(',')
+        .floating(data.left_pupil_diameter).put(',')
+        .integer(data.left_pupil_validity).put(',')
+        .floating(data.right_pupil_diameter).put(',')
+        .integer(data.right_pupil_validity).put(',')
+        .integer(data.system_time_stamp).put(',')
+        .integer(data.device_time_stamp).put(',')
+        .integer(data.sync_system_request_time).put(',')
+        .integer(data.sync_device_time).put(',')
+        .integer(data.sync_system_response_time).put(',')
+        .integer(data.sync_validity).put(',')
+        .integer(data.left_eye_detected).put(',')
+        .integer(data.right_eye_detected).put(',')
+        .integer(data.is_tracking).put(',')
+        .integer(data.overall_validity).put(',')
+        .integer(data.host_time_ns).put(',')
+        .integer(data.aligned_time_ns).put('\n');
+}
@@ -1,6 +1,8 @@
 // local
+#include <Syncorder/gonfig/gonfig.h>
 #include <Syncorder/error/exception.h>
 #include <Syncorder/devices/common/manager_base.h>
+#include <Syncorder/devices/common/executor.h>
 #include <Syncorder/devices/tobii/device.cpp>
 #include <Syncorder/devices/tobii/callback.cpp>
 #include <Syncorder/devices/tobii/buffer.cpp>
@@ -31,16 +33,23 @@ public:
         }
 
 public:
-    bool setup() override {
+    bool setup(const CancelToken& token) override {
         // device
         device_->pre_setup(callback_.get(), reinterpret_cast<void*>(&TobiiCallback::onGaze));
         device_->setup();
+        if (token.cancelled()) return false;
 
         // callback
         callback_->setup(static_cast<void*>(buffer_.get()));
 
+        // buffer
+        buffer_->setOverflowPolicy(parseOverflowPolicy(gonfig.overflow_policy), gonfig.output_path + "tobii/overflow.spill");
+        buffer_->setBlockTimeout(std::chrono::microseconds(gonfig.overflow_block_us));
+
         // broker
-        broker_->setup(buffer_.get(), reinterpret_cast<void*>(&TobiiBuffer::dequeue));
+        broker_->setup(buffer_.get());
+        broker_->setTrace(&TraceRegistry::instance().stream(__name__()));
+        if (gonfig.broker_workers > 0) broker_->setExecutor(&BrokerExecutor::shared());
 
         // flag
         is_setup_.store(true);
@@ -48,8 +57,9 @@ public:
         return true;
     }
     
-    bool warmup() override {
+    bool warmup(const CancelToken& token) override {
         device_->warmup();
+        if (token.cancelled()) return false;
         callback_->warmup();
 
         // flag
@@ -58,9 +68,10 @@ public:
         return true;
     }
     
-    bool start() override {
+    bool start(const CancelToken& token) override {
+        if (token.cancelled()) return false;
         broker_->start();
-        buffer_->start();
+        started_ticks_.store(buffer_->start(start_barrier_));
 
         // flag
         is_running_.store(true);
@@ -68,19 +79,27 @@ public:
         return true;
     }
 
-    bool stop() override {
+    bool stop(const CancelToken&) override {
         broker_->stop();
         buffer_->stop();
 
+        std::cout << "[TobiiManager] Buffer dropped: " << buffer_->dropped()
+            << ", overwritten: " << buffer_->overwritten()
+            << ", spilled: " << buffer_->spilled() << "\n";
+
         return true;
     }
-    bool cleanup() override {
+    bool cleanup(const CancelToken&) override {
         // broker_->cleanup();
         device_->cleanup();
 
         return true;
     }
 
+    StreamMetrics metrics() const override {
+        return collectMetrics(__name__(), *buffer_, *broker_);
+    }
+
     std::string __name__() const override {
         return "Tobii";
     }
@@ -6,12 +6,16 @@
 #include "tobii_research_eyetracker.h"
 #include "tobii_research_streams.h"
 
+// local
+#include <Syncorder/devices/common/trace.h>
+#include <Syncorder/devices/common/timestamp.h>
+
 
 /**
  * @struct TobiiBufferData - Global Tobii Data Structure
  */
 
-struct TobiiBufferData {
+struct TobiiBufferData : TraceSlot {
     
     // timestamp
     int64_t device_time_stamp;                          // Eye tracker device 내부 clock 기준 시간 (microseconds)
@@ -64,4 +68,9 @@ struct TobiiBufferData {
     bool right_eye_detected;                            // 오른쪽 눈 감지 여부
     bool is_tracking;                                   // 현재 tracking 진행 중 여부
     TobiiResearchValidity overall_validity;             // 전체 data bundle의 유효성
+
+    // host clock
+    int64_t capture_ticks;                              // Callback 진입 시 timestamps().now() (raw tick, broker에서 변환)
+    int64_t host_time_ns;                               // capture_ticks를 host monotonic clock으로 변환한 시간 (ns, broker에서 기록)
+    int64_t aligned_time_ns;                            // device_time_stamp를 host monotonic clock으로 정렬한 시간 (ns, broker에서 기록)
 };
\ No newline at end of file
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// local
+#include <Syncorder/devices/common/record_log.h>
+#include <Syncorder/devices/tobii/model.h>
+
+
+/**
+ * @struct TobiiRecord - packed on-disk form of TobiiBufferData (schema v2)
+ *
+ * Field order follows TobiiBufferData; validities are stored as int32 and
+ * flags as one byte, so a record is 163 bytes instead of the 224-byte struct
+ * and ~260 bytes of CSV text. Bump VERSION on any layout change.
+ *
+ * v2: host monotonic arrival time and the device time aligned to that clock
+ *     (ClockAligner) appended.
+ */
+
+#pragma pack(push, 1)
+
+struct TobiiRecord {
+    static constexpr std::uint16_t VERSION = 2;
+    static constexpr const char* STREAM = "tobii";
+
+    // timestamp
+    std::int64_t device_time_stamp;
+    std::int64_t system_time_stamp;
+
+    // left gaze point
+    float left_gaze_point_display_x;
+    float left_gaze_point_display_y;
+    float left_gaze_point_3d_x;
+    float left_gaze_point_3d_y;
+    float left_gaze_point_3d_z;
+    std::int32_t left_gaze_point_validity;
+
+    // right gaze point
+    float right_gaze_point_display_x;
+    float right_gaze_point_display_y;
+    float right_gaze_point_3d_x;
+    float right_gaze_point_3d_y;
+    float right_gaze_point_3d_z;
+    std::int32_t right_gaze_point_validity;
+
+    // left gaze origin
+    float left_gaze_origin_x;
+    float left_gaze_origin_y;
+    float left_gaze_origin_z;
+    std::int32_t left_gaze_origin_validity;
+
+    // right gaze origin
+    float right_gaze_origin_x;
+    float right_gaze_origin_y;
+    float right_gaze_origin_z;
+    std::int32_t right_gaze_origin_validity;
+
+    // pupil
+    float left_pupil_diameter;
+    std::int32_t left_pupil_validity;
+    float right_pupil_diameter;
+    std::int32_t right_pupil_validity;
+
+    // timestamp
+    std::int64_t sync_system_request_time;
+    std::int64_t sync_device_time;
+    std::int64_t sync_system_response_time;
+    std::int32_t sync_validity;
+
+    // status
+    std::uint8_t left_eye_detected;
+    std::uint8_t right_eye_detected;
+    std::uint8_t is_tracking;
+    std::int32_t overall_validity;
+
+    // host clock
+    std::int64_t host_time_ns;
+    std::int64_t aligned_time_ns;
+
+    static std::vector<RecordField> schema();
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(TobiiRecord) == 163, "TobiiRecord v2 layout is part of the file format");
+
+#define TOBII_RECORD_FIELD(name, type) recordField(#name, FieldType::type, offsetof(TobiiRecord, name))
+
+inline std::vector<RecordField> TobiiRecord::schema() {
+    return {
+        TOBII_RECORD_FIELD(device_time_stamp, I64),
+        TOBII_RECORD_FIELD(system_time_stamp, I64),
+        TOBII_RECORD_FIELD(left_gaze_point_display_x, F32),
+        TOBII_RECORD_FIELD(left_gaze_point_display_y, F32),
+        TOBII_RECORD_FIELD(left_gaze_point_3d_x, F32),
+        TOBII_RECORD_FIELD(left_gaze_point_3d_y, F32),
+        TOBII_RECORD_FIELD(left_gaze_point_3d_z, F32),
+        TOBII_RECORD_FIELD(left_gaze_point_validity, I32),
+        TOBII_RECORD_FIELD(right_gaze_point_display_x, F32),
+        TOBII_RECORD_FIELD(right_gaze_point_display_y, F32),
+        TOBII_RECORD_FIELD(right_gaze_point_3d_x, F32),
+        TOBII_RECORD_FIELD(right_gaze_point_3d_y, F32),
+        TOBII_RECORD_FIELD(right_gaze_point_3d_z, F32),
+        TOBII_RECORD_FIELD(right_gaze_point_validity, I32),
+        TOBII_RECORD_FIELD(left_gaze_origin_x, F32),
+        TOBII_RECORD_FIELD(left_gaze_origin_y, F32),
+        TOBII_RECORD_FIELD(left_gaze_origin_z, F32),
+        TOBII_RECORD_FIELD(left_gaze_origin_validity, I32),
+        TOBII_RECORD_FIELD(right_gaze_origin_x, F32),
+        TOBII_RECORD_FIELD(right_gaze_origin_y, F32),
+        TOBII_RECORD_FIELD(right_gaze_origin_z, F32),
+        TOBII_RECORD_FIELD(right_gaze_origin_validity, I32),
+        TOBII_RECORD_FIELD(left_pupil_diameter, F32),
+        TOBII_RECORD_FIELD(left_pupil_validity, I32),
+        TOBII_RECORD_FIELD(right_pupil_diameter, F32),
+        TOBII_RECORD_FIELD(right_pupil_validity, I32),
+        TOBII_RECORD_FIELD(sync_system_request_time, I64),
+        TOBII_RECORD_FIELD(sync_device_time, I64),
+        TOBII_RECORD_FIELD(sync_system_response_time, I64),
+        TOBII_RECORD_FIELD(sync_validity, I32),
+        TOBII_RECORD_FIELD(left_eye_detected, BOOL),
+        TOBII_RECORD_FIELD(right_eye_detected, BOOL),
+        TOBII_RECORD_FIELD(is_tracking, BOOL),
+        TOBII_RECORD_FIELD(overall_validity, I32),
+        TOBII_RECORD_FIELD(host_time_ns, I64),
+        TOBII_RECORD_FIELD(aligned_time_ns, I64),
+    };
+}
+
+#undef TOBII_RECORD_FIELD
+
+
+/**
+ * @helper: conversion between the in-memory sample and the on-disk record
+ */
+
+inline TobiiRecord toTobiiRecord(const TobiiBufferData& data) {
+    TobiiRecord record;
+
+    record.device_time_stamp = data.device_time_stamp;
+    record.system_time_stamp = data.system_time_stamp;
+
+    record.left_gaze_point_display_x = data.left_gaze_point_display_x;
+    record.left_gaze_point_display_y = data.left_gaze_point_display_y;
+    record.left_gaze_point_3d_x = data.left_gaze_point_3d_x;
+    record.left_gaze_point_3d_y = data.left_gaze_point_3d_y;
+    record.left_gaze_point_3d_z = data.left_gaze_point_3d_z;
+    record.left_gaze_point_validity = static_cast<std::int32_t>(data.left_gaze_point_validity);
+
+    record.right_gaze_point_display_x = data.right_gaze_point_display_x;
+    record.right_gaze_point_display_y = data.right_gaze_point_display_y;
+    record.right_gaze_point_3d_x = data.right_gaze_point_3d_x;
+    record.right_gaze_point_3d_y = data.right_gaze_point_3d_y;
+    record.right_gaze_point_3d_z = data.right_gaze_point_3d_z;
+    record.right_gaze_point_validity = static_cast<std::int32_t>(data.right_gaze_point_validity);
+
+    record.left_gaze_origin_x = data.left_gaze_origin_x;
+    record.left_gaze_origin_y = data.left_gaze_origin_y;
+    record.left_gaze_origin_z = data.left_gaze_origin_z;
+    record.left_gaze_origin_validity = static_cast<std::int32_t>(data.left_gaze_origin_validity);
+
+    record.right_gaze_origin_x = data.right_gaze_origin_x;
+    record.right_gaze_origin_y = data.right_gaze_origin_y;
+    record.right_gaze_origin_z = data.right_gaze_origin_z;
+    record.right_gaze_origin_validity = static_cast<std::int32_t>(data.right_gaze_origin_validity);
+
+    record.left_pupil_diameter = data.left_pupil_diameter;
+    record.left_pupil_validity = static_cast<std::int32_t>(data.left_pupil_validity);
+    record.right_pupil_diameter = data.right_pupil_diameter;
+    record.right_pupil_validity = static_cast<std::int32_t>(data.right_pupil_validity);
+
+    record.sync_system_request_time = data.sync_system_request_time;
+    record.sync_device_time = data.sync_device_time;
+    record.sync_system_response_time = data.sync_system_response_time;
+    record.sync_validity = static_cast<std::int32_t>(data.sync_validity);
+
+    record.left_eye_detected = data.left_eye_detected ? 1 : 0;
+    record.right_eye_detected = data.right_eye_detected ? 1 : 0;
+    record.is_tracking = data.is_tracking ? 1 : 0;
+    record.overall_validity = static_cast<std::int32_t>(data.overall_validity);
+
+    record.host_time_ns = data.host_time_ns;
+    record.aligned_time_ns = data.aligned_time_ns;
+
+    return record;
+}
+
+inline TobiiBufferData fromTobiiRecord(const TobiiRecord& record) {
+    TobiiBufferData data = {};
+
+    data.device_time_stamp = record.device_time_stamp;
+    data.system_time_stamp = record.system_time_stamp;
+
+    data.left_gaze_point_display_x = record.left_gaze_point_display_x;
+    data.left_gaze_point_display_y = record.left_gaze_point_display_y;
+    data.left_gaze_point_3d_x = record.left_gaze_point_3d_x;
+    data.left_gaze_point_3d_y = record.left_gaze_point_3d_y;
+    data.left_gaze_point_3d_z = record.left_gaze_point_3d_z;
+    data.left_gaze_point_validity = static_cast<TobiiResearchValidity>(record.left_gaze_point_validity);
+
+    data.right_gaze_point_display_x = record.right_gaze_point_display_x;
+    data.right_gaze_point_display_y = record.right_gaze_point_display_y;
+    data.right_gaze_point_3d_x = record.right_gaze_point_3d_x;
+    data.right_gaze_point_3d_y = record.right_gaze_point_3d_y;
+    data.right_gaze_point_3d_z = record.right_gaze_point_3d_z;
+    data.right_gaze_point_validity = static_cast<TobiiResearchValidity>(record.right_gaze_point_validity);
+
+    data.left_gaze_origin_x = record.left_gaze_origin_x;
+    data.left_gaze_origin_y = record.left_gaze_origin_y;
+    data.left_gaze_origin_z = record.left_gaze_origin_z;
+    data.left_gaze_origin_validity = static_cast<TobiiResearchValidity>(record.left_gaze_origin_validity);
+
+    data.right_gaze_origin_x = record.right_gaze_origin_x;
+    data.right_gaze_origin_y = record.right_gaze_origin_y;
+    data.right_gaze_origin_z = record.right_gaze_origin_z;
+    data.right_gaze_origin_validity = static_cast<TobiiResearchValidity>(record.right_gaze_origin_validity);
+
+    data.left_pupil_diameter = record.left_pupil_diameter;
+    data.left_pupil_validity = static_cast<TobiiResearchValidity>(record.left_pupil_validity);
+    data.right_pupil_diameter = record.right_pupil_diameter;
+    data.right_pupil_validity = static_cast<TobiiResearchValidity>(record.right_pupil_validity);
+
+    data.sync_system_request_time = record.sync_system_request_time;
+    data.sync_device_time = record.sync_device_time;
+    data.sync_system_response_time = record.sync_system_response_time;
+    data.sync_validity = static_cast<TobiiResearchValidity>(record.sync_validity);
+
+    data.left_eye_detected = record.left_eye_detected != 0;
+    data.right_eye_detected = record.right_eye_detected != 0;
+    data.is_tracking = record.is_tracking != 0;
+    data.overall_validity = static_cast<TobiiResearchValidity>(record.overall_validity);
+
+    data.host_time_ns = record.host_time_ns;
+    data.aligned_time_ns = record.aligned_time_ns;
+
+    return data;
+}
@@ -1,4 +1,5 @@
 #include "gonfig.h"
+#include <algorithm>
 
 // Global
 Config gonfig;
@@ -25,6 +26,99 @@ Config Config::parseArgs(int argc, char* argv[]) {
         else if (arg == "--record_duration" && i + 1 < argc) {
             conf.record_duration = std::stoi(argv[++i]);
         }
+        else if (arg == "--overflow_policy" && i + 1 < argc) {
+            conf.overflow_policy = argv[++i];
+        }
+        else if (arg == "--overflow_block_us" && i + 1 < argc) {
+            conf.overflow_block_us = std::stoi(argv[++i]);
+        }
+        else if (arg == "--broker_workers" && i + 1 < argc) {
+            conf.broker_workers = std::stoi(argv[++i]);
+        }
+        else if (arg == "--metrics_interval_ms" && i + 1 < argc) {
+            conf.metrics_interval_ms = std::stoi(argv[++i]);
+        }
+        else if (arg == "--status_interval_ms" && i + 1 < argc) {
+            conf.status_interval_ms = std::stoi(argv[++i]);
+        }
+        else if (arg == "--clock_window_s" && i + 1 < argc) {
+            conf.clock_window_s = std::stod(argv[++i]);
+        }
+        else if (arg == "--clock_gate" && i + 1 < argc) {
+            conf.clock_gate = std::stod(argv[++i]);
+        }
+        else if (arg == "--start_lead_ms" && i + 1 < argc) {
+            conf.start_lead_ms = std::stoi(argv[++i]);
+        }
+        else if (arg == "--start_spin_us" && i + 1 < argc) {
+            conf.start_spin_us = std::stoi(argv[++i]);
+        }
+        else if (arg == "--timestamp_source" && i + 1 < argc) {
+            conf.timestamp_source = argv[++i];
+        }
+        else if (arg == "--tobii_format" && i + 1 < argc) {
+            conf.tobii_format = argv[++i];
+        }
+        else if (arg == "--writer" && i + 1 < argc) {
+            conf.writer = argv[++i];
+        }
+        else if (arg == "--writer_direct" && i + 1 < argc) {
+            conf.writer_direct = std::stoi(argv[++i]) != 0;
+        }
+        else if (arg == "--writer_block_kb" && i + 1 < argc) {
+            conf.writer_block_kb = std::stoi(argv[++i]);
+        }
+        else if (arg == "--writer_blocks" && i + 1 < argc) {
+            conf.writer_blocks = std::stoi(argv[++i]);
+        }
+        else if (arg == "--segment_mb" && i + 1 < argc) {
+            conf.segment_mb = std::stoi(argv[++i]);
+        }
+        else if (arg == "--segment_seconds" && i + 1 < argc) {
+            conf.segment_seconds = std::stoi(argv[++i]);
+        }
+        else if (arg == "--container" && i + 1 < argc) {
+            conf.container = std::stoi(argv[++i]) != 0;
+        }
+        else if (arg == "--container_chunk_kb" && i + 1 < argc) {
+            conf.container_chunk_kb = std::stoi(argv[++i]);
+        }
+        else if (arg == "--container_compress" && i + 1 < argc) {
+            conf.container_compress = std::stoi(argv[++i]) != 0;
+        }
+        else if (arg == "--color_histogram" && i + 1 < argc) {
+            conf.color_histogram = std::stoi(argv[++i]) != 0;
+        }
+        else if (arg == "--encode_workers" && i + 1 < argc) {
+            conf.encode_workers = std::stoi(argv[++i]);
+        }
+        else if (arg == "--encode_every" && i + 1 < argc) {
+            conf.encode_every = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--encode_queue" && i + 1 < argc) {
+            conf.encode_queue = std::stoi(argv[++i]);
+        }
+        else if (arg == "--encode_policy" && i + 1 < argc) {
+            conf.encode_policy = argv[++i];
+        }
+        else if (arg == "--depth_workers" && i + 1 < argc) {
+            conf.depth_workers = std::stoi(argv[++i]);
+        }
+        else if (arg == "--depth_queue" && i + 1 < argc) {
+            conf.depth_queue = std::stoi(argv[++i]);
+        }
+        else if (arg == "--depth_policy" && i + 1 < argc) {
+            conf.depth_policy = argv[++i];
+        }
+        else if (arg == "--gaze_join" && i + 1 < argc) {
+            conf.gaze_join = std::stoi(argv[++i]) != 0;
+        }
+        else if (arg == "--join_tolerance_ms" && i + 1 < argc) {
+            conf.join_tolerance_ms = std::stoi(argv[++i]);
+        }
+        else if (arg == "--join_capacity" && i + 1 < argc) {
+            conf.join_capacity = std::stoi(argv[++i]);
+        }
     }
     
     return conf;
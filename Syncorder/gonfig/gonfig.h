@@ -15,6 +15,70 @@ public:
 
     int record_duration = 5;
 
+    // buffer overflow: reject | overwrite | block | spill
+    std::string overflow_policy = "reject";
+    int overflow_block_us = 2000;
+
+    // brokers: 0 = one thread per broker, n = shared executor with n workers
+    int broker_workers = 0;
+
+    // metrics: 0 = off, n = append a snapshot to <output_path>metrics.csv every n ms
+    int metrics_interval_ms = 0;
+
+    // console status line: 0 = off, n = at most one realsense status line every n ms (console writes are synchronous)
+    int status_interval_ms = 1000;
+
+    // clock alignment: device clock -> host monotonic clock, RLS over the last clock_window_s seconds,
+    // samples more than clock_gate sigmas off the fit are not fitted
+    double clock_window_s = 10.0;
+    double clock_gate = 4.0;
+
+    // start barrier: every buffer gate opens start_lead_ms after the start phase begins, sleeping then spinning
+    // the last start_spin_us, which covers a Windows timer tick (0 = open each gate as its manager starts)
+    int start_lead_ms = 50;
+    int start_spin_us = 20000;
+
+    // capture timestamps: auto | tsc | monotonic (auto and tsc use the TSC when it is invariant)
+    std::string timestamp_source = "auto";
+
+    // tobii output: csv | binary
+    std::string tobii_format = "csv";
+
+    // file writer: inline (buffered FILE* on the broker thread) | pwrite | uring (Linux, else pwrite) | segment
+    std::string writer = "inline";
+    bool writer_direct = false;         // O_DIRECT / FILE_FLAG_NO_BUFFERING
+    int writer_block_kb = 1024;
+    int writer_blocks = 4;
+
+    // segment writer: <name>_0000.csv, <name>_0001.csv, ... rotated by size or time (0 = size only)
+    int segment_mb = 256;
+    int segment_seconds = 0;
+
+    // session container: every broker writes into <output_path>session.scap instead of its own file
+    bool container = false;
+    int container_chunk_kb = 1024;
+    bool container_compress = true;     // LZ4 per chunk
+
+    // realsense colour analysis: 16-bin luma histogram + exposure flags per frame (means are always on)
+    bool color_histogram = true;
+
+    // realsense stills: 0 = off, n = encoder workers saving color / depth PNGs of every encode_every-th frame
+    int encode_workers = 0;
+    int encode_every = 1;
+    int encode_queue = 8;                    // framesets held (each pins its SDK frames)
+    std::string encode_policy = "reject";    // full queue: reject | overwrite | block (overflow_block_us)
+
+    // realsense lossless depth: 0 = off, n = workers RVL-compressing every depth frame to depth/depth_<frame>.rvl
+    int depth_workers = 0;
+    int depth_queue = 16;
+    std::string depth_policy = "block";
+
+    // gaze join: every realsense frame with the tobii gaze before / after it and interpolated to it, written live to
+    // <output_path>realsense_gaze.csv; a frame waits up to join_tolerance_ms for gaze, join_capacity entries held per stream
+    bool gaze_join = false;
+    int join_tolerance_ms = 100;
+    int join_capacity = 4096;
+
     static Config parseArgs(int argc, char* argv[]);
 };
 
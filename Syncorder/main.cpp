@@ -40,10 +40,15 @@ int main(int argc, char* argv[]) {
 
     try {
         std::cout << "=== Syncorder Multi-Device Recording ===\n\n";
+
+        // capture clock: pick and calibrate before any callback runs
+        TimestampBackend backend = timestamps().select(parseTimestampBackend(gonfig.timestamp_source));
+        std::cout << "Timestamp source: " << timestampBackendName(backend) << "\n";
         
         // Syncorder 초기화
         Syncorder syncorder;
         syncorder.setTimeout(std::chrono::milliseconds(10000));
+        syncorder.setStartBarrier(std::chrono::milliseconds(gonfig.start_lead_ms), std::chrono::microseconds(gonfig.start_spin_us));
         
         // Device 등록
         std::cout << "Registering devices...\n";
@@ -84,6 +89,10 @@ int main(int argc, char* argv[]) {
             return -1;
         }
         std::cout << "(O) Recording started\n\n";
+
+        if (gonfig.metrics_interval_ms > 0) {
+            syncorder.startMetrics(gonfig.output_path + "metrics.csv", std::chrono::milliseconds(gonfig.metrics_interval_ms));
+        }
         
 
         /**
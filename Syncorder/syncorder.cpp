@@ -6,24 +6,61 @@
 #include <atomic>
 #include <iostream>
 #include <chrono>
-#include <future>
 #include <functional>
+#include <algorithm>
 #include <string>
 
 #include <Syncorder/devices/common/manager_base.h>
+#include <Syncorder/devices/common/trace.h>
+#include <Syncorder/devices/common/metrics.h>
+#include <Syncorder/devices/common/start_barrier.h>
+#include <Syncorder/devices/common/stage_pool.h>
 
 /**
  * @class
+ *
+ * Every stage runs one call per manager on a persistent StagePool. Each call
+ * gets a CancelToken with that manager's own deadline (addDevice timeout, else
+ * setTimeout); a call past its deadline is cancelled and abandoned, so one
+ * hung device fails the stage on time instead of holding the others or
+ * shutdown.
  */
 
 class Syncorder {
 private:
     std::vector<std::unique_ptr<BManager>> managers_;
+    std::vector<std::chrono::milliseconds> timeouts_;      // per manager, 0 = default_timeout_
     std::atomic<bool> abort_flag_{false};
     std::chrono::milliseconds default_timeout_{5000};
+    MetricsRecorder metrics_recorder_;
+
+    // start barrier: every buffer gate opens start_lead_ after the start phase begins (0 = open at once)
+    StartBarrier start_barrier_;
+    std::chrono::microseconds start_lead_{50000};
+    std::chrono::microseconds start_spin_{20000};
+
+    // calls past their deadline; their managers are not destroyed while one still runs
+    std::vector<std::pair<std::size_t, StageTask>> abandoned_;
+
+    // last: stopped before the managers go
+    StagePool pool_;
     
 public:
-    void addDevice(std::unique_ptr<BManager> manager) {
+    Syncorder() = default;
+
+    ~Syncorder() {
+        // a hung call still uses its manager: leak it rather than free it under the call
+        for (auto& [index, task] : abandoned_) {
+            if (task.done() || !managers_[index]) continue;
+            std::cout << "[" << managers_[index]->__name__() << "] Manager call still running, left behind\n";
+            managers_[index].release();
+        }
+    }
+
+    /**
+     * timeout: this manager's deadline per stage call (0 = setTimeout's)
+     */
+    void addDevice(std::unique_ptr<BManager> manager, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
         if (!manager) {
             std::cout << "[Syncorder] Warning: null manager ignored\n";
             return;
@@ -31,13 +68,13 @@ public:
         
         std::cout << "[Syncorder] Added manager: " << manager->__name__() << "\n";
         managers_.push_back(std::move(manager));
+        timeouts_.push_back(timeout);
     }
     
     bool executeSetup() {
         std::cout << "[Syncorder] Coordinating setup phase...\n";
-        bool result = executeStage("setup", [](BManager& manager) {
-            manager.setup();
-            return manager.__is_setup__();
+        bool result = executeStage("setup", [](BManager& manager, const CancelToken& token) {
+            return manager.setup(token) && manager.__is_setup__();
         });
 
         std::cout << "[Syncorder] Setup phase " << (result ? "completed" : "failed") << "\n";
@@ -46,9 +83,8 @@ public:
     
     bool executeWarmup() {
         std::cout << "[Syncorder] Coordinating warmup phase...\n";
-        bool result = executeStage("warmup", [](BManager& manager) {
-            manager.warmup();
-            return manager.__is_warmup__();
+        bool result = executeStage("warmup", [](BManager& manager, const CancelToken& token) {
+            return manager.warmup(token) && manager.__is_warmup__();
         });
 
         std::cout << "[Syncorder] Warmup phase " << (result ? "completed" : "failed") << "\n";
@@ -57,57 +93,113 @@ public:
     
     bool executeStart() {
         std::cout << "[Syncorder] Coordinating start phase...\n";
-        bool result = executeStage("start", [](BManager& manager) {
-            manager.start();
-            return manager.__is_running__();
+
+        if (start_lead_.count() > 0) start_barrier_.arm(start_lead_, start_spin_);
+        else start_barrier_.disarm();
+        for (auto& manager : managers_) manager->setStartBarrier(&start_barrier_);
+
+        bool result = executeStage("start", [](BManager& manager, const CancelToken& token) {
+            return manager.start(token) && manager.__is_running__();
         });
 
+        if (result && start_barrier_.armed()) reportStartSkew();
+
         std::cout << "[Syncorder] Start phase " << (result ? "completed" : "failed") << "\n";
         return result;
     }
     
     void executeStop() {
         std::cout << "[Syncorder] Coordinating stop phase...\n";
-        std::vector<std::future<void>> futures;
-        
-        for (auto& manager : managers_) {
-            futures.push_back(
-                std::async(std::launch::async, [&manager]() {
-                    try {
-                        manager->stop();
-                        std::cout << "[" << manager->__name__() << "] Manager stopped\n";
-                    } catch (const std::exception& e) {
-                        std::cout << "[" << manager->__name__() << "] Stop error: " << e.what() << "\n";
-                    }
-                })
-            );
-        }
-        
-        waitForAllFutures(futures, default_timeout_);
+
+        // not abortable: stop is what an abort runs
+        runStage("stop", [](BManager& manager, const CancelToken& token) {
+            bool stopped = manager.stop(token);
+            std::cout << "[" << manager.__name__() << "] Manager stopped\n";
+            return stopped;
+        }, false);
+
+        // metrics: final snapshot after the brokers have drained
+        metrics_recorder_.stop();
+
+        // trace
+        if constexpr (TRACE_ENABLED) TraceRegistry::instance().dump(std::cout);
 
         std::cout << "[Syncorder] Stop phase completed\n";
     }
     
     void executeCleanup() {
         std::cout << "[Syncorder] Coordinating cleanup phase...\n";
-        for (auto& manager : managers_) {
-            try {
-                manager->cleanup();
-                std::cout << "[" << manager->__name__() << "] Manager cleaned up\n";
-            } catch (const std::exception& e) {
-                std::cout << "[" << manager->__name__() << "] Cleanup error: " << e.what() << "\n";
+
+        // one manager at a time, each under its own deadline
+        for (std::size_t i = 0; i < managers_.size(); ++i) {
+            BManager* manager = managers_[i].get();
+            StageTask task = pool_.submit(CancelToken(_deadline(i)), [manager](const CancelToken& token) {
+                return manager->cleanup(token);
+            });
+
+            if (!task.waitUntil(task.token().deadline())) {
+                std::cout << "[" << manager->__name__() << "] Cleanup timeout, abandoned\n";
+                abandoned_.emplace_back(i, task);
             }
+            else if (!task.error().empty()) std::cout << "[" << manager->__name__() << "] Cleanup error: " << task.error() << "\n";
+            else std::cout << "[" << manager->__name__() << "] Manager cleaned up\n";
         }
 
         std::cout << "[Syncorder] Cleanup phase completed\n";
     }
     
+    std::vector<StreamMetrics> snapshotMetrics() const {
+        std::vector<StreamMetrics> snapshot;
+        snapshot.reserve(managers_.size());
+        for (const auto& manager : managers_) snapshot.push_back(manager->metrics());
+        return snapshot;
+    }
+
+    bool startMetrics(const std::string& path, std::chrono::milliseconds interval) {
+        bool started = metrics_recorder_.start(path, interval, [this] { return snapshotMetrics(); });
+        std::cout << "[Syncorder] Metrics " << (started ? "recording to " + path : "could not open " + path) << "\n";
+        return started;
+    }
+
     void abort() {
         std::cout << "[Syncorder] Abort requested\n";
         abort_flag_.store(true);
         executeStop();
     }
     
+    /**
+     * start barrier: lead = how far ahead of the start phase the common start
+     * instant is set (0 = open each gate as soon as its manager starts), spin =
+     * how much of the wait is spun instead of slept
+     */
+    void setStartBarrier(std::chrono::microseconds lead, std::chrono::microseconds spin) {
+        start_lead_ = lead;
+        start_spin_ = spin;
+        std::cout << "[Syncorder] Start barrier lead " << lead.count() << "us, spin " << spin.count() << "us\n";
+    }
+
+    /**
+     * per-stream gate opening time vs the barrier instant, in us
+     */
+    void reportStartSkew() const {
+        TimestampMapping map = timestamps().mapping();
+        std::int64_t start = start_barrier_.startTicks();
+
+        double lo = 0.0, hi = 0.0;
+        bool first = true;
+        for (const auto& manager : managers_) {
+            if (!manager->startedTicks()) continue;     // no buffer gate
+
+            double skew_us = (manager->startedTicks() - start) * map.ns_per_tick / 1e3;
+            std::cout << "[Syncorder] Start skew " << manager->__name__() << ": " << skew_us << " us\n";
+
+            lo = first ? skew_us : std::min(lo, skew_us);
+            hi = first ? skew_us : std::max(hi, skew_us);
+            first = false;
+        }
+        std::cout << "[Syncorder] Start skew spread: " << (hi - lo) << " us\n";
+    }
+
     void setTimeout(std::chrono::milliseconds timeout) {
         default_timeout_ = timeout;
         std::cout << "[Syncorder] Timeout set to " << timeout.count() << "ms\n";
@@ -134,24 +226,7 @@ private:
             return false;
         }
         
-        std::vector<std::future<bool>> futures;
-        
-        for (auto& manager : managers_) {
-            futures.push_back(
-                std::async(std::launch::async, [&manager, &func, &stage_name]() {
-                    try {
-                        bool success = func(*manager);
-
-                        return success;
-                    } catch (const std::exception& e) {
-                        std::cout << "[" << manager->__name__() << "] Manager " << stage_name << " error: " << e.what() << "\n";
-                        return false;
-                    }
-                })
-            );
-        }
-        
-        bool all_success = waitForAllFutures(futures, default_timeout_);
+        bool all_success = runStage(stage_name, func, true);
         
         if (!all_success) {
             std::cout << "[Syncorder] " << stage_name << " phase failed\n";
@@ -162,42 +237,45 @@ private:
         
         return all_success;
     }
-    
-    template<typename T>
-    bool waitForAllFutures(std::vector<std::future<T>>& futures, std::chrono::milliseconds timeout) {
-        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    /**
+     * func(manager, token) for every manager in parallel on the pool; waits
+     * for each call up to its manager's deadline and cancels the late ones
+     */
+    template<typename StageFunc>
+    bool runStage(const std::string& stage_name, StageFunc func, bool abortable) {
+        std::vector<StageTask> tasks;
+        tasks.reserve(managers_.size());
+
+        for (std::size_t i = 0; i < managers_.size(); ++i) {
+            BManager* manager = managers_[i].get();
+            CancelToken token(_deadline(i), abortable ? &abort_flag_ : nullptr);
+            tasks.push_back(pool_.submit(token, [manager, func](const CancelToken& token) { return func(*manager, token); }));
+        }
+
         bool all_success = true;
-        
-        for (auto& future : futures) {
-            auto remaining = deadline - std::chrono::steady_clock::now();
-            if (remaining <= std::chrono::milliseconds(0)) {
-                std::cout << "[Syncorder] Timeout waiting for completion\n";
-                return false;
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const std::string name = managers_[i]->__name__();
+
+            if (!tasks[i].waitUntil(tasks[i].token().deadline())) {
+                std::cout << "[" << name << "] Manager " << stage_name << " timeout, cancelled\n";
+                abandoned_.emplace_back(i, tasks[i]);
+                all_success = false;
             }
-            
-            if (future.wait_for(remaining) == std::future_status::timeout) {
-                std::cout << "[Syncorder] Manager timeout\n";
-                return false;
+            else if (!tasks[i].error().empty()) {
+                std::cout << "[" << name << "] Manager " << stage_name << " error: " << tasks[i].error() << "\n";
+                all_success = false;
             }
-            
-            if constexpr (std::is_same_v<T, bool>) {
-                try {
-                    if (!future.get()) {
-                        all_success = false;
-                    }
-                } catch (const std::exception& e) {
-                    std::cout << "[Syncorder] Future exception: " << e.what() << "\n";
-                    all_success = false;
-                }
-            } else {
-                try {
-                    future.get();
-                } catch (const std::exception& e) {
-                    std::cout << "[Syncorder] Future exception: " << e.what() << "\n";
-                }
+            else if (!tasks[i].result()) {
+                all_success = false;
             }
         }
-        
+
         return all_success;
     }
+
+    std::chrono::steady_clock::time_point _deadline(std::size_t index) const {
+        std::chrono::milliseconds timeout = timeouts_[index].count() > 0 ? timeouts_[index] : default_timeout_;
+        return std::chrono::steady_clock::now() + timeout;
+    }
 };
\ No newline at end of file
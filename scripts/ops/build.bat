@@ -28,4 +28,18 @@ cl ^
   ole32.lib ^
   tobii_research.lib ^
   arducam_evk_cpp_sdk.lib ^
-  realsense2.lib
\ No newline at end of file
+  realsense2.lib
+
+REM frame_convert (bin\frame_convert.exe, used by scripts\ops\convert.bat)
+cl ^
+  /std:c++17 ^
+  /EHsc ^
+  /MT ^
+  /W3 ^
+  /O2 ^
+  /D_CRT_SECURE_NO_WARNINGS ^
+  /wd4819 ^
+  /I . ^
+  /I "C:\Users\user\Workspace\Intel RealSense SDK 2.0\third-party" ^
+  tools\frame_convert\frame_convert.cpp ^
+  /Fe:bin\frame_convert.exe
\ No newline at end of file
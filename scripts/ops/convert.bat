@@ -2,17 +2,33 @@
 setlocal enabledelayedexpansion
 
 REM ===================================================
-REM Enhanced RealSense CSV Converter with Depth Visualization
+REM RealSense CSV Converter with Depth Visualization
+REM (runs bin\frame_convert.exe, built by scripts\ops\build.bat; falls back to
+REM  per-frame ffmpeg for CSV sessions when the exe is missing)
+REM (also accepts a directory of RVL depth frames: convert.bat output\realsense)
 REM ===================================================
 
 set "CSV_FILE=%~1"
 if "%CSV_FILE%"=="" (
-    echo Usage: %~nx0 "path\to\realsense_data.csv"
+    echo Usage: %~nx0 "path\to\realsense_data.csv" or "path\to\rvl directory" [--threads n] [--fps f]
     echo.
     echo This script converts RealSense raw files to PNG with proper depth visualization
     exit /b 1
 )
 
+set "FRAME_CONVERT=%~dp0..\..\bin\frame_convert.exe"
+if exist "%FRAME_CONVERT%" (
+    "%FRAME_CONVERT%" %*
+    exit /b !errorlevel!
+)
+
+REM ===== ffmpeg fallback =====
+echo Warning: %FRAME_CONVERT% not found, converting with ffmpeg ^(build it with scripts\ops\build.bat^)
+
+if exist "%CSV_FILE%\" (
+    echo Error: RVL directories need frame_convert.exe
+    exit /b 1
+)
 if not exist "%CSV_FILE%" (
     echo Error: CSV file not found: %CSV_FILE%
     exit /b 1
@@ -46,6 +62,7 @@ echo Depth frames processed: %DEPTH_COUNT%
 echo Total converted: %CONVERTED%
 echo Total failed: %FAILED%
 echo ==============================
+if %FAILED% gtr 0 exit /b 1
 exit /b 0
 
 :convert_color
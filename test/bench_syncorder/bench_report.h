@@ -0,0 +1,157 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <utility>
+#include <thread>
+
+#include "Syncorder/devices/common/histogram.h"
+
+/**
+ * Bench report - 모든 bench 결과를 모아 JSON 한 파일로 출력 (release 간 회귀 추적용)
+ *
+ * {
+ *   "suite": "syncorder_capture_core", "schema": 1, "timestamp": ..., "hardware_concurrency": ...,
+ *   "results": [
+ *     { "bench": "...", "case": "...", "params": {...}, "metrics": {...},
+ *       "latency_ns": { "count", "min", "mean", "p50", "p90", "p99", "p999", "max", "buckets": [[lower, upper, count], ...] } }
+ *   ]
+ * }
+ */
+struct BenchRecord {
+    std::string bench;
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> params;
+    std::vector<std::pair<std::string, double>> metrics;
+    std::string latency_json;
+
+    BenchRecord& param(const std::string& key, const std::string& value) {
+        params.emplace_back(key, value);
+        return *this;
+    }
+
+    BenchRecord& param(const std::string& key, std::uint64_t value) {
+        return param(key, std::to_string(value));
+    }
+
+    BenchRecord& metric(const std::string& key, double value) {
+        metrics.emplace_back(key, value);
+        return *this;
+    }
+
+    BenchRecord& latency(const LatencyHistogram& histogram) {
+        std::ostringstream os;
+        os << "{\"count\": " << histogram.count()
+           << ", \"min\": " << histogram.min()
+           << ", \"mean\": " << std::fixed << std::setprecision(1) << histogram.mean()
+           << ", \"p50\": " << histogram.percentile(50.0)
+           << ", \"p90\": " << histogram.percentile(90.0)
+           << ", \"p99\": " << histogram.percentile(99.0)
+           << ", \"p999\": " << histogram.percentile(99.9)
+           << ", \"max\": " << histogram.max()
+           << ", \"buckets\": [";
+
+        bool first = true;
+        histogram.forEachBucket([&](std::uint64_t lower, std::uint64_t upper, std::uint64_t count) {
+            os << (first ? "" : ", ") << "[" << lower << ", " << upper << ", " << count << "]";
+            first = false;
+        });
+        os << "]}";
+
+        latency_json = os.str();
+        return *this;
+    }
+};
+
+class BenchReport {
+private:
+    std::vector<BenchRecord> records_;
+
+public:
+    BenchRecord& add(const std::string& bench, const std::string& name) {
+        records_.push_back(BenchRecord{bench, name, {}, {}, {}});
+        return records_.back();
+    }
+
+    /**
+     * "bench/case" of every record whose "identical" metric is 0 (output differs from the reference)
+     */
+    std::vector<std::string> mismatches() const {
+        std::vector<std::string> failed;
+        for (const BenchRecord& record : records_) {
+            for (const auto& metric : record.metrics) {
+                if (metric.first == "identical" && metric.second == 0.0) failed.push_back(record.bench + "/" + record.name);
+            }
+        }
+        return failed;
+    }
+
+    std::string toJson() const {
+        std::ostringstream os;
+        auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        os << "{\n";
+        os << "  \"suite\": \"syncorder_capture_core\",\n";
+        os << "  \"schema\": 1,\n";
+        os << "  \"timestamp\": " << timestamp << ",\n";
+        os << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+        os << "  \"results\": [";
+
+        for (std::size_t i = 0; i < records_.size(); ++i) {
+            const BenchRecord& record = records_[i];
+            os << (i ? ",\n" : "\n") << "    {\"bench\": " << _quote(record.bench)
+               << ", \"case\": " << _quote(record.name);
+
+            os << ", \"params\": {";
+            for (std::size_t j = 0; j < record.params.size(); ++j) {
+                os << (j ? ", " : "") << _quote(record.params[j].first) << ": " << _quote(record.params[j].second);
+            }
+            os << "}";
+
+            os << ", \"metrics\": {";
+            for (std::size_t j = 0; j < record.metrics.size(); ++j) {
+                os << (j ? ", " : "") << _quote(record.metrics[j].first) << ": " << _number(record.metrics[j].second);
+            }
+            os << "}";
+
+            if (!record.latency_json.empty()) os << ", \"latency_ns\": " << record.latency_json;
+            os << "}";
+        }
+
+        os << "\n  ]\n}\n";
+        return os.str();
+    }
+
+    bool write(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+
+        file << toJson();
+        return file.good();
+    }
+
+private:
+    static std::string _quote(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    static std::string _number(double value) {
+        // JSON has no inf / nan
+        if (!(value == value) || value > 1e300 || value < -1e300) return "null";
+
+        std::ostringstream os;
+        os << std::setprecision(10) << value;
+        return os.str();
+    }
+};
@@ -0,0 +1,1946 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <cstdint>
+#include <array>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <optional>
+#include <mutex>
+#include <sstream>
+#include <fstream>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <functional>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "Syncorder/devices/common/buffer_base.h"
+#include "Syncorder/devices/common/mbuffer_base.h"
+#include "Syncorder/devices/common/broker_base.h"
+#include "Syncorder/devices/common/executor.h"
+#include "Syncorder/devices/common/job_pool.h"
+#include "Syncorder/devices/common/histogram.h"
+#include "Syncorder/devices/common/csv_writer.h"
+#include "Syncorder/devices/tobii/csv.h"
+#include "Syncorder/devices/common/container.h"
+#include "Syncorder/devices/realsense/colorize.h"
+#include "Syncorder/devices/realsense/analysis.h"
+#include "Syncorder/devices/realsense/rvl.h"
+#include "Syncorder/devices/common/timestamp.h"
+#include "Syncorder/devices/common/gaze_join.h"
+#include "Syncorder/syncorder.cpp"
+#include "test/bench_syncorder/bench_report.h"
+
+static BenchReport g_report;
+
+/**
+ * Allocation counter - 모든 thread의 heap 할당 횟수
+ */
+static std::atomic<std::uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+/**
+ * Mock data - SDK 없이 device data 크기/특성 재현
+ */
+struct BenchGazeData {                      // TobiiBufferData 크기의 trivially copyable sample
+    std::int64_t seq;
+    std::int64_t sys_ns;
+    char payload[136];
+};
+
+struct BenchFrameData {                     // RealsenseBufferData처럼 ref-counted frame handle을 보유
+    std::shared_ptr<const std::vector<std::uint8_t>> color_frame_;
+    std::shared_ptr<const std::vector<std::uint8_t>> depth_frame_;
+    std::int64_t seq = 0;
+    std::int64_t sys_ns = 0;
+    double device_timestamp_ = 0.0;
+};
+
+template<typename T, std::size_t N>
+class BenchBuffer : public BBuffer<T, N> {};
+
+/**
+ * Stamped element - 앞 8 byte에 송신 시각(ns), 나머지는 payload (element 크기별 측정용)
+ */
+template<std::size_t Size>
+struct Stamped {
+    static_assert(Size >= sizeof(std::int64_t), "Stamped needs room for the timestamp");
+
+    std::int64_t stamp;
+    char payload[Size - sizeof(std::int64_t) > 0 ? Size - sizeof(std::int64_t) : 1];
+};
+
+template<typename T>
+T makeStamped(std::int64_t ns) {
+    if constexpr (std::is_same_v<T, std::int64_t>) {
+        return ns;
+    } else {
+        T value;
+        value.stamp = ns;
+        return value;
+    }
+}
+
+template<typename T>
+std::int64_t stampOf(const T& value) {
+    if constexpr (std::is_same_v<T, std::int64_t>) return value;
+    else return value.stamp;
+}
+
+/**
+ * Legacy handoff - void* dequeue + per-sample new/unique_ptr (비교 기준)
+ */
+namespace legacy {
+
+template<typename T, std::size_t N>
+class Buffer : public BenchBuffer<T, N> {
+public:
+    static void* dequeue(void* instance) {
+        auto* buffer = static_cast<Buffer*>(instance);
+        auto result = buffer->_dequeue();
+        if (!result.has_value()) return nullptr;
+
+        return new T(std::move(result.value()));
+    }
+};
+
+template<typename T>
+class Broker {
+private:
+    void* buffer_ = nullptr;
+    void* dequeue_ = nullptr;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+public:
+    std::atomic<std::uint64_t> processed_{0};
+
+    ~Broker() { stop(); }
+
+    void setup(void* buffer, void* dequeue) { buffer_ = buffer; dequeue_ = dequeue; }
+    void start() { running_ = true; thread_ = std::thread([this] { while (running_) _broker(); }); }
+    void stop() { running_ = false; if (thread_.joinable()) thread_.join(); }
+
+private:
+    void _broker() {
+        typedef void* (*DequeueFunc)(void*);
+        void* raw_data = reinterpret_cast<DequeueFunc>(dequeue_)(buffer_);
+        if (raw_data != nullptr) {
+            std::unique_ptr<T> data(static_cast<T*>(raw_data));
+            processed_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+};
+
+/**
+ * 이전 BBuffer layout - head/buffer/tail 인접 배치, cached index 없음, % N
+ */
+template <typename T, std::size_t N>
+class Ring {
+protected:
+    std::atomic<std::size_t> m_head{0};
+    std::array<T, N> m_buff;
+    std::atomic<std::size_t> m_tail{0};
+
+    std::atomic<bool> gate_{true};
+
+public:
+    bool enqueue(T val) noexcept {
+        if (gate_.load(std::memory_order_acquire)) return false;
+
+        std::size_t current_tail = m_tail.load(std::memory_order_relaxed);
+        if (current_tail - m_head.load(std::memory_order_acquire) < N) {
+            m_buff[current_tail % N] = std::move(val);
+            m_tail.store(current_tail + 1, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+
+    std::optional<T> _dequeue() noexcept {
+        std::size_t current_tail = m_tail.load(std::memory_order_acquire);
+        std::size_t current_head = m_head.load(std::memory_order_relaxed);
+
+        if (current_head != current_tail) {
+            auto value = std::move(m_buff[current_head % N]);
+            m_head.store(current_head + 1, std::memory_order_release);
+            return std::optional<T>(std::move(value));
+        }
+        return std::nullopt;
+    }
+
+    void start() { gate_.store(false, std::memory_order_release); }
+};
+
+/**
+ * 이전 TobiiBroker::_write / RealsenseBroker::_write - ofstream operator<< 경로
+ */
+template<typename Gaze>
+void writeTobiiRow(std::ostream& csv, const Gaze& data) {
+    csv
+        << data.left_gaze_point_display_x << ","
+        << data.left_gaze_point_display_y << ","
+        << data.left_gaze_point_3d_x << ","
+        << data.left_gaze_point_3d_y << ","
+        << data.left_gaze_point_3d_z << ","
+        << data.left_gaze_point_validity << ","
+        << data.right_gaze_point_display_x << ","
+        << data.right_gaze_point_display_y << ","
+        << data.right_gaze_point_3d_x << ","
+        << data.right_gaze_point_3d_y << ","
+        << data.right_gaze_point_3d_z << ","
+        << data.right_gaze_point_validity << ","
+        << data.left_gaze_origin_x << ","
+        << data.left_gaze_origin_y << ","
+        << data.left_gaze_origin_z << ","
+        << data.left_gaze_origin_validity << ","
+        << data.right_gaze_origin_x << ","
+        << data.right_gaze_origin_y << ","
+        << data.right_gaze_origin_z << ","
+        << data.right_gaze_origin_validity << ","
+        << data.left_pupil_diameter << ","
+        << data.left_pupil_validity << ","
+        << data.right_pupil_diameter << ","
+        << data.right_pupil_validity << ","
+        << data.system_time_stamp << ","
+        << data.device_time_stamp << ","
+        << data.sync_system_request_time << ","
+        << data.sync_device_time << ","
+        << data.sync_system_response_time << ","
+        << data.sync_validity << ","
+        << data.left_eye_detected << ","
+        << data.right_eye_detected << ","
+        << data.is_tracking << ","
+        << data.overall_validity << ","
+        << data.host_time_ns << ","
+        << data.aligned_time_ns
+        << "\n";
+}
+
+inline void writeRealsenseRow(std::ostream& csv, double device_timestamp, long long sys_ms, std::uint16_t center_depth_mm, bool has_color, bool has_depth) {
+    csv << std::fixed << std::setprecision(2);
+    csv
+        << device_timestamp << ","
+        << sys_ms << ","
+        << center_depth_mm << ","
+        << (has_color ? 1 : 0) << ","
+        << (has_depth ? 1 : 0) << "\n";
+}
+
+} // namespace legacy
+
+/**
+ * Typed handoff - TBBroker<DataType, BufferType>
+ */
+template<typename T, typename BufferType>
+class CountingBroker : public TBBroker<T, BufferType> {
+public:
+    std::atomic<std::uint64_t> processed_{0};
+
+protected:
+    void _process(const T&) override {
+        processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * 출력 헬퍼
+ */
+void printBenchHeader(const std::string& bench_name, const std::string& description) {
+    std::cout << "\n";
+    std::cout << "=========================================\n";
+    std::cout << "BENCH: " << bench_name << "\n";
+    std::cout << "=========================================\n";
+    std::cout << "PURPOSE: " << description << "\n\n";
+}
+
+/**
+ * 고정 rate producer - 실제 device callback 주기 재현
+ */
+template<typename T, typename Buffer, typename MakeSample>
+std::uint64_t produceAtRate(Buffer& buffer, double rate_hz, std::chrono::milliseconds duration, MakeSample make_sample) {
+    auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+    auto next = std::chrono::steady_clock::now();
+    auto end = next + duration;
+
+    std::uint64_t produced = 0;
+    while (next < end) {
+        std::this_thread::sleep_until(next);
+        if (buffer.enqueue(make_sample(produced))) produced++;
+        next += period;
+    }
+    return produced;
+}
+
+template<typename T, typename MakeSample>
+void runAllocationCase(const std::string& stream, double rate_hz, std::chrono::milliseconds duration, MakeSample make_sample) {
+    constexpr std::size_t N = 1024;
+
+    // legacy
+    std::uint64_t legacy_allocs = 0;
+    std::uint64_t legacy_processed = 0;
+    {
+        legacy::Buffer<T, N> buffer;
+        legacy::Broker<T> broker;
+        broker.setup(&buffer, reinterpret_cast<void*>(&legacy::Buffer<T, N>::dequeue));
+        broker.start();
+        buffer.start();
+
+        auto before = g_allocations.load();
+        produceAtRate<T>(buffer, rate_hz, duration, make_sample);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        legacy_allocs = g_allocations.load() - before;
+
+        broker.stop();
+        legacy_processed = broker.processed_.load();
+    }
+
+    // typed
+    std::uint64_t typed_allocs = 0;
+    std::uint64_t typed_processed = 0;
+    {
+        BenchBuffer<T, N> buffer;
+        CountingBroker<T, BenchBuffer<T, N>> broker;
+        broker.setup(&buffer);
+        broker.start();
+        buffer.start();
+
+        auto before = g_allocations.load();
+        produceAtRate<T>(buffer, rate_hz, duration, make_sample);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        typed_allocs = g_allocations.load() - before;
+
+        broker.stop();
+        typed_processed = broker.processed_.load();
+    }
+
+    double seconds = std::chrono::duration<double>(duration).count();
+    std::cout << std::left << std::setw(22) << stream
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << (legacy_allocs / seconds)
+              << std::setw(12) << (typed_allocs / seconds)
+              << std::setw(12) << legacy_processed
+              << std::setw(12) << typed_processed << "\n";
+
+    g_report.add("handoff_allocations", stream)
+        .param("rate_hz", static_cast<std::uint64_t>(rate_hz))
+        .metric("legacy_allocs_per_sec", legacy_allocs / seconds)
+        .metric("typed_allocs_per_sec", typed_allocs / seconds)
+        .metric("legacy_processed", static_cast<double>(legacy_processed))
+        .metric("typed_processed", static_cast<double>(typed_processed));
+}
+
+void benchHandoffAllocations() {
+    printBenchHeader("Handoff Allocations",
+                     "Heap allocations per second between ring buffer and broker at device rates");
+
+    auto duration = std::chrono::milliseconds(2000);
+
+    std::cout << std::left << std::setw(22) << "Stream"
+              << std::right << std::setw(12) << "legacy/s"
+              << std::setw(12) << "typed/s"
+              << std::setw(12) << "legacy_n"
+              << std::setw(12) << "typed_n" << "\n";
+    std::cout << "----------------------------------------------------------------------\n";
+
+    runAllocationCase<BenchGazeData>("Tobii 600Hz", 600.0, duration, [](std::uint64_t i) {
+        BenchGazeData data{};
+        data.seq = static_cast<std::int64_t>(i);
+        return data;
+    });
+
+    auto color = std::make_shared<const std::vector<std::uint8_t>>(640 * 480 * 3);
+    auto depth = std::make_shared<const std::vector<std::uint8_t>>(640 * 480 * 2);
+    runAllocationCase<BenchFrameData>("RealSense 60fps", 60.0, duration, [&](std::uint64_t i) {
+        BenchFrameData data;
+        data.color_frame_ = color;
+        data.depth_frame_ = depth;
+        data.seq = static_cast<std::int64_t>(i);
+        return data;
+    });
+}
+
+/**
+ * Core pinning - producer / consumer를 서로 다른 core에 고정
+ */
+bool pinThread(unsigned core) {
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core) != 0;
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct RingResult {
+    double ops_per_sec = 0.0;
+    double p50_ns = 0.0;
+    double p99_ns = 0.0;
+    bool pinned = false;
+    std::unique_ptr<LatencyHistogram> latency = std::make_unique<LatencyHistogram>();
+};
+
+template<typename T, typename Ring>
+RingResult runRingCase(std::chrono::milliseconds duration, std::size_t latency_samples) {
+    RingResult result;
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    unsigned producer_core = 0;
+    unsigned consumer_core = cores > 1 ? 1 : 0;
+
+    // core가 하나뿐이면 spin 대신 양보
+    auto backoff = [cores] {
+        if (cores == 1) std::this_thread::yield();
+        else cpuRelax();
+    };
+
+    // throughput - 포화 상태 SPSC, 고정 시간 동안
+    {
+        auto ring = std::make_unique<Ring>();
+        ring->start();
+
+        std::atomic<bool> ready{false};
+        std::atomic<bool> done{false};
+        std::atomic<bool> consumer_pinned{false};
+        std::atomic<std::uint64_t> sent{0};
+        std::uint64_t received = 0;
+
+        std::thread consumer([&] {
+            consumer_pinned = pinThread(consumer_core);
+            ready = true;
+            while (!done.load(std::memory_order_acquire) || received < sent.load(std::memory_order_acquire)) {
+                if (ring->_dequeue()) received++;
+                else backoff();
+            }
+        });
+
+        bool producer_pinned = pinThread(producer_core);
+        while (!ready) std::this_thread::yield();
+
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + duration;
+        std::uint64_t i = 0;
+        while (true) {
+            // deadline check를 1024회마다
+            if ((i & 1023) == 0 && std::chrono::steady_clock::now() >= end) break;
+            if (ring->enqueue(makeStamped<T>(static_cast<std::int64_t>(i)))) i++;
+            else backoff();
+        }
+        sent.store(i, std::memory_order_release);
+        done.store(true, std::memory_order_release);
+        consumer.join();
+        auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        result.ops_per_sec = received / seconds;
+        result.pinned = producer_pinned && consumer_pinned && cores > 1;
+    }
+
+    // latency - 한 번에 하나의 sample만 in-flight
+    {
+        auto ring = std::make_unique<Ring>();
+        ring->start();
+
+        std::atomic<std::size_t> received{0};
+        std::atomic<bool> ready{false};
+        std::thread consumer([&] {
+            pinThread(consumer_core);
+            ready = true;
+            while (received.load(std::memory_order_relaxed) < latency_samples) {
+                if (auto value = ring->_dequeue()) {
+                    auto index = received.load(std::memory_order_relaxed);
+                    result.latency->record(nowNs() - stampOf(*value));
+                    received.store(index + 1, std::memory_order_release);
+                } else {
+                    backoff();
+                }
+            }
+        });
+
+        pinThread(producer_core);
+        while (!ready) std::this_thread::yield();
+
+        for (std::size_t i = 0; i < latency_samples; ++i) {
+            while (!ring->enqueue(makeStamped<T>(nowNs()))) backoff();
+            while (received.load(std::memory_order_acquire) <= i) backoff();
+        }
+        consumer.join();
+
+        result.p50_ns = static_cast<double>(result.latency->percentile(50.0));
+        result.p99_ns = static_cast<double>(result.latency->percentile(99.0));
+    }
+
+    return result;
+}
+
+void benchRingLayout() {
+    printBenchHeader("Ring Layout",
+                     "SPSC ops/s and handoff latency: legacy layout vs cache-line padded + cached indices");
+
+    constexpr std::size_t N = 1024;
+    const auto duration = std::chrono::milliseconds(1000);
+    const std::size_t samples = 20000;
+
+    auto legacy_result = runRingCase<std::int64_t, legacy::Ring<std::int64_t, N>>(duration, samples);
+    auto padded_result = runRingCase<std::int64_t, BenchBuffer<std::int64_t, N>>(duration, samples);
+
+    std::cout << std::left << std::setw(14) << "Layout"
+              << std::right << std::setw(16) << "ops/s"
+              << std::setw(12) << "p50(ns)"
+              << std::setw(12) << "p99(ns)" << "\n";
+    std::cout << "------------------------------------------------------\n";
+
+    auto row = [](const std::string& name, const RingResult& r) {
+        std::cout << std::left << std::setw(14) << name
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(16) << r.ops_per_sec
+                  << std::setw(12) << r.p50_ns
+                  << std::setw(12) << r.p99_ns << "\n";
+
+        g_report.add("ring_layout", name)
+            .param("capacity", N)
+            .metric("ops_per_sec", r.ops_per_sec)
+            .metric("pinned", r.pinned ? 1.0 : 0.0)
+            .latency(*r.latency);
+    };
+    row("legacy", legacy_result);
+    row("padded", padded_result);
+
+    if (!padded_result.pinned) {
+        std::cout << "\nNote: producer/consumer not pinned to distinct cores (single core or affinity denied)\n";
+    }
+}
+
+/**
+ * Fan-in 비교 기준 - producer 측 mutex로 감싼 SPSC BBuffer
+ */
+template<typename T, std::size_t N>
+class MutexFanIn {
+private:
+    std::mutex mutex_;
+    BenchBuffer<T, N> buffer_;
+
+public:
+    void start() { buffer_.start(); }
+    bool enqueue(T val) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return buffer_.enqueue(std::move(val));
+    }
+    std::size_t dequeue_n(T* out, std::size_t max) { return buffer_.dequeue_n(out, max); }
+    std::uint64_t dropped() const { return buffer_.dropped(); }
+};
+
+struct ContentionResult {
+    double ops_per_sec = 0.0;
+    double drop_ratio = 0.0;
+};
+
+template<typename Buffer>
+ContentionResult runContentionCase(unsigned producers, std::chrono::milliseconds duration) {
+    auto buffer = std::make_unique<Buffer>();
+    buffer->start();
+
+    std::atomic<bool> go{false};
+    std::atomic<bool> done{false};
+    std::atomic<unsigned> finished{0};
+    std::atomic<std::uint64_t> attempted{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            while (!go) std::this_thread::yield();
+            std::uint64_t local = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                BenchGazeData data{};
+                data.seq = static_cast<std::int64_t>(local);
+                data.sys_ns = p;
+                buffer->enqueue(data);
+                if ((++local & 255) == 0) std::this_thread::yield();
+            }
+            attempted += local;
+            finished++;
+        });
+    }
+
+    std::uint64_t received = 0;
+    BenchGazeData batch[BROKER_BATCH_SIZE];
+
+    go = true;
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        std::size_t n = buffer->dequeue_n(batch, BROKER_BATCH_SIZE);
+        if (n == 0) std::this_thread::yield();
+        received += n;
+    }
+    done = true;
+    while (finished < producers) received += buffer->dequeue_n(batch, BROKER_BATCH_SIZE);
+    for (auto& t : threads) t.join();
+    while (std::size_t n = buffer->dequeue_n(batch, BROKER_BATCH_SIZE)) received += n;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    ContentionResult result;
+    result.ops_per_sec = received / seconds;
+    result.drop_ratio = attempted ? static_cast<double>(buffer->dropped()) / attempted : 0.0;
+    return result;
+}
+
+void benchMultiProducer() {
+    printBenchHeader("Multi-Producer Contention",
+                     "Delivered samples/s into one consumer: lock-free MBuffer vs mutex-guarded BBuffer");
+
+    constexpr std::size_t N = 1024;
+    const auto duration = std::chrono::milliseconds(500);
+
+    std::cout << std::left << std::setw(12) << "Producers"
+              << std::right << std::setw(16) << "mbuffer/s"
+              << std::setw(10) << "drop%"
+              << std::setw(16) << "mutex/s"
+              << std::setw(10) << "drop%" << "\n";
+    std::cout << "------------------------------------------------------------------\n";
+
+    for (unsigned producers : {1u, 2u, 4u, 8u}) {
+        auto lockfree = runContentionCase<MBuffer<BenchGazeData, N>>(producers, duration);
+        auto locked = runContentionCase<MutexFanIn<BenchGazeData, N>>(producers, duration);
+
+        std::cout << std::left << std::setw(12) << producers
+                  << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(16) << lockfree.ops_per_sec
+                  << std::setprecision(2) << std::setw(10) << (lockfree.drop_ratio * 100.0)
+                  << std::setprecision(0) << std::setw(16) << locked.ops_per_sec
+                  << std::setprecision(2) << std::setw(10) << (locked.drop_ratio * 100.0) << "\n";
+
+        g_report.add("multi_producer", "mbuffer")
+            .param("producers", producers)
+            .metric("ops_per_sec", lockfree.ops_per_sec)
+            .metric("drop_ratio", lockfree.drop_ratio);
+        g_report.add("multi_producer", "mutex_bbuffer")
+            .param("producers", producers)
+            .metric("ops_per_sec", locked.ops_per_sec)
+            .metric("drop_ratio", locked.drop_ratio);
+    }
+}
+
+/**
+ * Element size sweep - TobiiBufferData(200B)부터 큰 inline frame struct까지
+ */
+template<typename T, std::size_t N>
+void runSizeCase(const std::string& name, std::chrono::milliseconds duration, std::size_t samples) {
+    auto r = runRingCase<T, BenchBuffer<T, N>>(duration, samples);
+    double mb_per_sec = r.ops_per_sec * sizeof(T) / (1024.0 * 1024.0);
+
+    std::cout << std::left << std::setw(14) << name
+              << std::right << std::setw(10) << sizeof(T)
+              << std::setw(8) << N
+              << std::fixed << std::setprecision(0)
+              << std::setw(14) << r.ops_per_sec
+              << std::setw(10) << mb_per_sec
+              << std::setw(10) << r.p50_ns
+              << std::setw(10) << r.p99_ns
+              << std::setw(12) << r.latency->percentile(99.9) << "\n";
+
+    g_report.add("buffer_element_size", name)
+        .param("element_bytes", sizeof(T))
+        .param("capacity", N)
+        .metric("ops_per_sec", r.ops_per_sec)
+        .metric("mb_per_sec", mb_per_sec)
+        .metric("pinned", r.pinned ? 1.0 : 0.0)
+        .latency(*r.latency);
+}
+
+void benchBufferSizes() {
+    printBenchHeader("Buffer Element Size",
+                     "BBuffer SPSC throughput and one-in-flight latency histogram per element size");
+
+    const auto duration = std::chrono::milliseconds(500);
+    const std::size_t samples = 5000;
+
+    std::cout << std::left << std::setw(14) << "Element"
+              << std::right << std::setw(10) << "bytes"
+              << std::setw(8) << "N"
+              << std::setw(14) << "ops/s"
+              << std::setw(10) << "MB/s"
+              << std::setw(10) << "p50(ns)"
+              << std::setw(10) << "p99(ns)"
+              << std::setw(12) << "p99.9(ns)" << "\n";
+    std::cout << "----------------------------------------------------------------------------------\n";
+
+    runSizeCase<std::int64_t, 1024>("int64", duration, samples);
+    runSizeCase<Stamped<200>, 1024>("tobii_200B", duration, samples);
+    runSizeCase<Stamped<1024>, 1024>("record_1KiB", duration, samples);
+    runSizeCase<Stamped<4096>, 256>("record_4KiB", duration, samples);
+    runSizeCase<Stamped<65536>, 32>("frame_64KiB", duration, samples);
+}
+
+/**
+ * Broker end-to-end - enqueue 시각부터 TBBroker::_process 진입까지
+ */
+using BrokerSample = Stamped<200>;
+using BrokerBuffer = BenchBuffer<BrokerSample, 1024>;
+
+class LatencyBroker : public TBBroker<BrokerSample, BrokerBuffer> {
+public:
+    LatencyHistogram latency_;
+    std::atomic<std::uint64_t> processed_{0};
+
+protected:
+    void _process(const BrokerSample& data) override {
+        latency_.record(nowNs() - data.stamp);
+        processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+void runBrokerCase(const std::string& mode, BExecutor* executor, double rate_hz, std::chrono::milliseconds duration) {
+    auto buffer = std::make_unique<BrokerBuffer>();
+    auto broker = std::make_unique<LatencyBroker>();
+    broker->setup(buffer.get());
+    broker->setExecutor(executor);
+    broker->start();
+    buffer->start();
+
+    std::uint64_t produced = produceAtRate<BrokerSample>(*buffer, rate_hz, duration, [](std::uint64_t) {
+        return makeStamped<BrokerSample>(nowNs());
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (broker->processed_.load() < produced && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    broker->stop();
+    buffer->stop();
+
+    const LatencyHistogram& latency = broker->latency_;
+    std::cout << std::left << std::setw(18) << mode
+              << std::right << std::setw(10) << static_cast<std::uint64_t>(rate_hz)
+              << std::setw(10) << latency.count()
+              << std::setw(12) << latency.percentile(50.0)
+              << std::setw(12) << latency.percentile(99.0)
+              << std::setw(12) << latency.max() << "\n";
+
+    g_report.add("broker_end_to_end", mode)
+        .param("rate_hz", static_cast<std::uint64_t>(rate_hz))
+        .metric("produced", static_cast<double>(produced))
+        .metric("processed", static_cast<double>(broker->processed_.load()))
+        .latency(latency);
+}
+
+void benchBrokerLatency() {
+    printBenchHeader("Broker End-to-End",
+                     "Latency from BBuffer::enqueue to TBBroker::_process at device rates");
+
+    const auto duration = std::chrono::milliseconds(1000);
+
+    std::cout << std::left << std::setw(18) << "Mode"
+              << std::right << std::setw(10) << "rate_hz"
+              << std::setw(10) << "samples"
+              << std::setw(12) << "p50(ns)"
+              << std::setw(12) << "p99(ns)"
+              << std::setw(12) << "max(ns)" << "\n";
+    std::cout << "------------------------------------------------------------------------\n";
+
+    BrokerExecutor executor(1);
+    for (double rate_hz : {600.0, 5000.0}) {
+        runBrokerCase("dedicated_thread", nullptr, rate_hz, duration);
+        runBrokerCase("executor_1", &executor, rate_hz, duration);
+    }
+    executor.shutdown();
+}
+
+/**
+ * Orchestrator overhead - 즉시 반환하는 manager N개로 executeStage 비용만 측정
+ */
+class NoopManager : public BManager {
+private:
+    std::string name_;
+
+public:
+    explicit NoopManager(int index) : name_("Noop" + std::to_string(index)) {}
+
+    bool setup(const CancelToken&) override { is_setup_.store(true); return true; }
+    bool warmup(const CancelToken&) override { is_warmup_.store(true); return true; }
+    bool start(const CancelToken&) override { is_running_.store(true); return true; }
+    bool stop(const CancelToken&) override { is_running_.store(false); return true; }
+    bool cleanup(const CancelToken&) override { return true; }
+
+    std::string __name__() const override { return name_; }
+};
+
+class NullStreamBuf : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+void benchExecuteStage() {
+    printBenchHeader("Orchestrator Stage",
+                     "Syncorder::executeStage wall time per stage with N no-op managers");
+
+    const int repeats = 200;
+
+    std::cout << std::left << std::setw(12) << "Managers"
+              << std::right << std::setw(14) << "mean(us)"
+              << std::setw(12) << "p50(us)"
+              << std::setw(12) << "p99(us)"
+              << std::setw(16) << "per_mgr(us)" << "\n";
+    std::cout << "------------------------------------------------------------------\n";
+
+    for (int managers : {1, 4, 16, 64}) {
+        LatencyHistogram latency;
+        {
+            // stage 로그는 측정에서 제외
+            NullStreamBuf null_buffer;
+            std::streambuf* original = std::cout.rdbuf(&null_buffer);
+
+            Syncorder syncorder;
+            for (int i = 0; i < managers; ++i) syncorder.addDevice(std::make_unique<NoopManager>(i));
+
+            for (int r = 0; r < repeats; ++r) {
+                auto start = nowNs();
+                syncorder.executeSetup();
+                latency.record(nowNs() - start);
+            }
+
+            std::cout.rdbuf(original);
+        }
+
+        double mean_us = latency.mean() / 1000.0;
+        std::cout << std::left << std::setw(12) << managers
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << mean_us
+                  << std::setw(12) << (latency.percentile(50.0) / 1000.0)
+                  << std::setw(12) << (latency.percentile(99.0) / 1000.0)
+                  << std::setw(16) << (mean_us / managers) << "\n";
+
+        g_report.add("execute_stage", "setup")
+            .param("managers", static_cast<std::uint64_t>(managers))
+            .param("repeats", static_cast<std::uint64_t>(repeats))
+            .metric("mean_us", mean_us)
+            .metric("per_manager_us", mean_us / managers)
+            .latency(latency);
+    }
+}
+
+/**
+ * CSV emit - ofstream operator<< vs CsvWriter(to_chars), 출력 byte 동일성 확인 포함
+ */
+enum BenchValidity { BENCH_VALIDITY_INVALID, BENCH_VALIDITY_VALID };
+
+struct BenchTobiiData {                    // TobiiBufferData와 같은 field 이름/type (SDK 없이 csv.h 사용)
+    std::int64_t device_time_stamp;
+    std::int64_t system_time_stamp;
+    float left_gaze_point_display_x;
+    float left_gaze_point_display_y;
+    float left_gaze_point_3d_x;
+    float left_gaze_point_3d_y;
+    float left_gaze_point_3d_z;
+    BenchValidity left_gaze_point_validity;
+    float right_gaze_point_display_x;
+    float right_gaze_point_display_y;
+    float right_gaze_point_3d_x;
+    float right_gaze_point_3d_y;
+    float right_gaze_point_3d_z;
+    BenchValidity right_gaze_point_validity;
+    float left_gaze_origin_x;
+    float left_gaze_origin_y;
+    float left_gaze_origin_z;
+    BenchValidity left_gaze_origin_validity;
+    float right_gaze_origin_x;
+    float right_gaze_origin_y;
+    float right_gaze_origin_z;
+    BenchValidity right_gaze_origin_validity;
+    float left_pupil_diameter;
+    BenchValidity left_pupil_validity;
+    float right_pupil_diameter;
+    BenchValidity right_pupil_validity;
+    std::int64_t sync_system_request_time;
+    std::int64_t sync_device_time;
+    std::int64_t sync_system_response_time;
+    BenchValidity sync_validity;
+    bool left_eye_detected;
+    bool right_eye_detected;
+    bool is_tracking;
+    BenchValidity overall_validity;
+    std::int64_t host_time_ns;
+    std::int64_t aligned_time_ns;
+};
+
+std::vector<BenchTobiiData> makeTobiiRows(std::size_t count) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> display(0.0f, 1.0f);
+    std::uniform_real_distribution<float> mm(-400.0f, 700.0f);
+    std::uniform_real_distribution<float> pupil(2.0f, 7.0f);
+
+    std::vector<BenchTobiiData> rows(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        BenchTobiiData& d = rows[i];
+        bool valid = (i % 10) != 0;
+        float nan = std::numeric_limits<float>::quiet_NaN();
+
+        d.device_time_stamp = 1234567890LL + static_cast<std::int64_t>(i) * 1666;
+        d.system_time_stamp = 1700000000000000LL + static_cast<std::int64_t>(i) * 1667;
+        d.left_gaze_point_display_x = valid ? display(rng) : nan;
+        d.left_gaze_point_display_y = valid ? display(rng) : nan;
+        d.left_gaze_point_3d_x = mm(rng);
+        d.left_gaze_point_3d_y = mm(rng);
+        d.left_gaze_point_3d_z = mm(rng) * 1e-3f;
+        d.left_gaze_point_validity = valid ? BENCH_VALIDITY_VALID : BENCH_VALIDITY_INVALID;
+        d.right_gaze_point_display_x = display(rng);
+        d.right_gaze_point_display_y = display(rng) * 1e-6f;
+        d.right_gaze_point_3d_x = mm(rng) * 1e4f;
+        d.right_gaze_point_3d_y = mm(rng);
+        d.right_gaze_point_3d_z = 600.0f;
+        d.right_gaze_point_validity = BENCH_VALIDITY_VALID;
+        d.left_gaze_origin_x = mm(rng);
+        d.left_gaze_origin_y = mm(rng);
+        d.left_gaze_origin_z = mm(rng);
+        d.left_gaze_origin_validity = BENCH_VALIDITY_VALID;
+        d.right_gaze_origin_x = -mm(rng);
+        d.right_gaze_origin_y = mm(rng);
+        d.right_gaze_origin_z = mm(rng);
+        d.right_gaze_origin_validity = BENCH_VALIDITY_VALID;
+        d.left_pupil_diameter = valid ? pupil(rng) : -1.0f;
+        d.left_pupil_validity = valid ? BENCH_VALIDITY_VALID : BENCH_VALIDITY_INVALID;
+        d.right_pupil_diameter = pupil(rng);
+        d.right_pupil_validity = BENCH_VALIDITY_VALID;
+        d.sync_system_request_time = -static_cast<std::int64_t>(i);
+        d.sync_device_time = 0;
+        d.sync_system_response_time = std::numeric_limits<std::int64_t>::max();
+        d.sync_validity = BENCH_VALIDITY_INVALID;
+        d.host_time_ns = 987654321000LL + static_cast<std::int64_t>(i) * 1666667;
+        d.aligned_time_ns = d.host_time_ns - 2000000 + static_cast<std::int64_t>(i % 7) * 1000;
+        d.left_eye_detected = valid;
+        d.right_eye_detected = true;
+        d.is_tracking = true;
+        d.overall_validity = valid ? BENCH_VALIDITY_VALID : BENCH_VALIDITY_INVALID;
+    }
+    return rows;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream os;
+    os << file.rdbuf();
+    return os.str();
+}
+
+template<typename Emit>
+double timeRows(std::size_t rows, Emit emit) {
+    auto start = std::chrono::steady_clock::now();
+    emit();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return rows / seconds;
+}
+
+void benchCsvEmit() {
+    printBenchHeader("CSV Emit",
+                     "Rows/s written to disk: ofstream operator<< vs CsvWriter (to_chars + block flush)");
+
+    const std::size_t count = 200000;
+    const std::size_t batch = BROKER_BATCH_SIZE;
+    auto rows = makeTobiiRows(count);
+
+    const std::string ofstream_path = "bench_csv_ofstream.csv";
+    const std::string writer_path = "bench_csv_writer.csv";
+
+    std::cout << std::left << std::setw(14) << "Stream"
+              << std::right << std::setw(16) << "ofstream/s"
+              << std::setw(16) << "to_chars/s"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "identical" << "\n";
+    std::cout << "--------------------------------------------------------------------\n";
+
+    auto report = [&](const std::string& stream, double legacy_rate, double writer_rate) {
+        bool identical = readFile(ofstream_path) == readFile(writer_path);
+
+        std::cout << std::left << std::setw(14) << stream
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(16) << legacy_rate
+                  << std::setw(16) << writer_rate
+                  << std::setprecision(2) << std::setw(10) << (writer_rate / legacy_rate)
+                  << std::setw(12) << (identical ? "yes" : "NO") << "\n";
+
+        g_report.add("csv_emit", stream)
+            .param("rows", count)
+            .metric("ofstream_rows_per_sec", legacy_rate)
+            .metric("to_chars_rows_per_sec", writer_rate)
+            .metric("identical", identical ? 1.0 : 0.0);
+
+        std::remove(ofstream_path.c_str());
+        std::remove(writer_path.c_str());
+    };
+
+    // tobii - 34 fields
+    {
+        double legacy_rate = timeRows(count, [&] {
+            std::ofstream csv(ofstream_path);
+            for (const auto& row : rows) legacy::writeTobiiRow(csv, row);
+        });
+        double writer_rate = timeRows(count, [&] {
+            CsvWriter csv;
+            csv.open(writer_path);
+            for (std::size_t i = 0; i < count; ++i) {
+                writeTobiiCsvRow(csv, rows[i]);
+                if ((i + 1) % batch == 0) csv.flush();
+            }
+        });
+        report("tobii", legacy_rate, writer_rate);
+    }
+
+    // realsense - fixed(2) device timestamp
+    {
+        auto device_ms = [](std::size_t i) { return 1.7e12 / 1e3 + i * 33.333; };
+        auto sys_ms = [](std::size_t i) { return 1700000000000LL + static_cast<long long>(i) * 33; };
+
+        double legacy_rate = timeRows(count, [&] {
+            std::ofstream csv(ofstream_path);
+            for (std::size_t i = 0; i < count; ++i) legacy::writeRealsenseRow(csv, device_ms(i), sys_ms(i), static_cast<std::uint16_t>(i % 4000), true, i % 2 == 0);
+        });
+        double writer_rate = timeRows(count, [&] {
+            CsvWriter csv;
+            csv.open(writer_path);
+            for (std::size_t i = 0; i < count; ++i) {
+                csv.fixed(device_ms(i), 2).put(',')
+                   .integer(sys_ms(i)).put(',')
+                   .integer(static_cast<std::uint16_t>(i % 4000)).put(',')
+                   .integer(1).put(',')
+                   .integer(i % 2 == 0 ? 1 : 0).put('\n');
+                if ((i + 1) % batch == 0) csv.flush();
+            }
+        });
+        report("realsense", legacy_rate, writer_rate);
+    }
+}
+
+/**
+ * File writer - broker 쪽에서 본 write() 호출 지연 (inline FILE* vs 비동기 writer)
+ */
+void runFileWriterCase(const std::string& mode, const std::string& backend, bool direct, std::size_t total, std::size_t chunk) {
+    const std::string path = "bench_file_writer.bin";
+    std::vector<char> data(chunk, 'x');
+    LatencyHistogram latency;
+    std::string actual = backend;
+    std::uint64_t stall_ns = 0;
+
+    auto start = nowNs();
+    if (backend == "inline") {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::vector<char> io_buffer(CSV_FILE_BUFFER);
+        std::setvbuf(file, io_buffer.data(), _IOFBF, io_buffer.size());
+        for (std::size_t written = 0; written < total; written += chunk) {
+            auto call = nowNs();
+            std::fwrite(data.data(), 1, chunk, file);
+            latency.record(nowNs() - call);
+        }
+        std::fclose(file);
+    } else if (backend == "segment") {
+        // 64 MiB segments so the 256 MiB stream rotates a few times
+        SegmentWriter writer;
+        writer.open(path, makeWriterOptions(backend, false, 0, 0, 64, 0));
+        for (std::size_t written = 0; written < total; written += chunk) {
+            auto call = nowNs();
+            writer.write(data.data(), chunk);
+            latency.record(nowNs() - call);
+        }
+        writer.close();
+        stall_ns = writer.stallNs();
+        for (unsigned i = 0; i < writer.segments(); ++i) {
+            char segment[64];
+            std::snprintf(segment, sizeof(segment), "bench_file_writer_%04u.bin", i);
+            std::remove(segment);
+        }
+    } else {
+        AsyncFileWriter writer;
+        writer.open(path, makeWriterOptions(backend, direct, 1024, 4));
+        actual = writer.backend();
+        for (std::size_t written = 0; written < total; written += chunk) {
+            auto call = nowNs();
+            writer.write(data.data(), chunk);
+            latency.record(nowNs() - call);
+        }
+        writer.close();
+        stall_ns = writer.stallNs();
+    }
+    double seconds = (nowNs() - start) / 1e9;
+    double mb_per_sec = total / seconds / (1 << 20);
+    std::remove(path.c_str());
+
+    std::cout << std::left << std::setw(16) << mode
+              << std::setw(10) << actual
+              << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << mb_per_sec
+              << std::setw(12) << latency.percentile(50.0)
+              << std::setw(12) << latency.percentile(99.0)
+              << std::setw(14) << latency.max()
+              << std::setprecision(2) << std::setw(12) << (stall_ns / 1e6) << "\n";
+
+    g_report.add("file_writer", mode)
+        .param("backend", actual)
+        .param("bytes", static_cast<std::uint64_t>(total))
+        .param("chunk", static_cast<std::uint64_t>(chunk))
+        .metric("mb_per_sec", mb_per_sec)
+        .latency(latency);
+}
+
+void benchFileWriter() {
+    printBenchHeader("File Writer",
+                     "Producer-side write() latency per 64 KiB chunk, 256 MiB stream");
+
+    const std::size_t total = 256u << 20;
+    const std::size_t chunk = 64u << 10;
+
+    std::cout << std::left << std::setw(16) << "Mode"
+              << std::setw(10) << "backend"
+              << std::right << std::setw(10) << "MB/s"
+              << std::setw(12) << "p50(ns)"
+              << std::setw(12) << "p99(ns)"
+              << std::setw(14) << "max(ns)"
+              << std::setw(12) << "stall(ms)" << "\n";
+    std::cout << "------------------------------------------------------------------------------------\n";
+
+    runFileWriterCase("inline_file", "inline", false, total, chunk);
+    runFileWriterCase("async_pwrite", "pwrite", false, total, chunk);
+    runFileWriterCase("async_uring", "uring", false, total, chunk);
+    runFileWriterCase("direct_pwrite", "pwrite", true, total, chunk);
+    runFileWriterCase("direct_uring", "uring", true, total, chunk);
+    runFileWriterCase("segment_mmap", "segment", false, total, chunk);
+}
+
+/**
+ * Container - broker 3개가 하나의 session container에 동시에 기록 + 시간 seek
+ */
+void benchContainer() {
+    printBenchHeader("Session Container",
+                     "3 concurrent brokers into one chunked file; LZ4 ratio and time-seek latency");
+
+    const std::string path = "bench_container.scap";
+    const int batches = 4000;
+
+    std::cout << std::left << std::setw(14) << "Mode"
+              << std::right << std::setw(14) << "msgs/s"
+              << std::setw(10) << "ratio"
+              << std::setw(10) << "chunks"
+              << std::setw(14) << "seek(us)"
+              << std::setw(16) << "range_read(us)" << "\n";
+    std::cout << "------------------------------------------------------------------------------\n";
+
+    for (bool compress : {false, true}) {
+        std::uint64_t messages = 0;
+        double raw = 0.0;
+        double stored = 0.0;
+
+        auto start = nowNs();
+        {
+            ContainerWriter writer;
+            writer.open(path, FileWriterOptions(), CONTAINER_CHUNK_BYTES, compress);
+
+            std::uint16_t tobii = writer.addChannel("tobii", 1, 147, {});
+            std::uint16_t realsense = writer.addChannel("realsense", 1, 28, {});
+            std::uint16_t camera = writer.addChannel("camera", 1, 16, {});
+
+            // 각 stream의 sample rate 비율(600 / 30 / 60 Hz)대로 batch 크기를 잡음
+            auto producer = [&](std::uint16_t channel, std::size_t record_size, std::size_t batch, std::int64_t period_ns) {
+                std::vector<char> record(record_size);
+                for (int b = 0; b < batches; ++b) {
+                    for (std::size_t i = 0; i < batch; ++i) {
+                        std::int64_t n = static_cast<std::int64_t>(b * batch + i);
+                        std::memcpy(record.data(), &n, sizeof(n));
+                        writer.write(channel, n * period_ns, record.data(), static_cast<std::uint32_t>(record.size()));
+                    }
+                }
+            };
+
+            std::thread t1(producer, tobii, 147, 20, 1666666);
+            std::thread t2(producer, realsense, 28, 1, 33333333);
+            std::thread t3(producer, camera, 16, 2, 16666666);
+            t1.join();
+            t2.join();
+            t3.join();
+
+            messages = static_cast<std::uint64_t>(batches) * (20 + 1 + 2);
+            raw = static_cast<double>(writer.rawBytes());
+            stored = static_cast<double>(writer.storedBytes());
+        }
+        double msgs_per_sec = messages / ((nowNs() - start) / 1e9);
+
+        // 중간 1초 구간을 seek + 읽기
+        ContainerReader reader;
+        reader.open(path);
+        std::int64_t middle = static_cast<std::int64_t>(batches) * 20 * 1666666 / 2;
+
+        auto seek_start = nowNs();
+        std::size_t first = 0;
+        for (int r = 0; r < 1000; ++r) first += reader.seek(middle + r);
+        double seek_us = (nowNs() - seek_start) / 1000.0 / 1000.0;
+
+        std::uint64_t in_range = 0;
+        auto read_start = nowNs();
+        reader.forEachMessage(middle, middle + 1000000000LL, [&](const MessageHeader&, const char*) { ++in_range; });
+        double read_us = (nowNs() - read_start) / 1000.0;
+        std::size_t chunks = reader.chunks().size();
+        reader.close();
+        std::remove(path.c_str());
+
+        std::string mode = compress ? "lz4" : "raw";
+        std::cout << std::left << std::setw(14) << mode
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(14) << msgs_per_sec
+                  << std::setprecision(2) << std::setw(10) << (raw / stored)
+                  << std::setw(10) << chunks
+                  << std::setprecision(3) << std::setw(14) << seek_us
+                  << std::setprecision(0) << std::setw(16) << read_us << "\n";
+
+        g_report.add("container", mode)
+            .param("messages", messages)
+            .param("in_range", in_range)
+            .param("seek_chunk", static_cast<std::uint64_t>(first / 1000))
+            .metric("messages_per_sec", msgs_per_sec)
+            .metric("compression_ratio", raw / stored)
+            .metric("seek_us", seek_us)
+            .metric("range_read_us", read_us);
+    }
+}
+
+/**
+ * Depth Colorize - Z16 -> turbo RGB24 (frame_convert), scalar vs SIMD
+ */
+void benchDepthColorize() {
+    printBenchHeader("Depth Colorize",
+                     "Z16 frames -> 200..10000 mm turbo RGB24 per SIMD level; output must match scalar");
+
+    std::cout << std::left << std::setw(14) << "Resolution"
+              << std::setw(10) << "Level"
+              << std::right << std::setw(14) << "frames/s"
+              << std::setw(12) << "Mpix/s"
+              << std::setw(12) << "identical" << "\n";
+    std::cout << "--------------------------------------------------------------\n";
+
+    const std::pair<int, int> sizes[] = {{640, 480}, {1280, 720}};
+    for (const auto& size : sizes) {
+        std::size_t pixels = static_cast<std::size_t>(size.first) * size.second;
+
+        // 실제 depth처럼 0(무효)과 범위 밖 값을 섞음
+        std::mt19937 rng(7);
+        std::vector<std::uint16_t> depth(pixels);
+        for (auto& v : depth) v = static_cast<std::uint16_t>(rng() % 8 == 0 ? 0 : rng() % 12000);
+
+        std::vector<std::uint8_t> reference(pixels * 3);
+        std::vector<std::uint8_t> rgb(pixels * 3);
+        colorizeDepth(depth.data(), reference.data(), pixels, SimdLevel::SCALAR);
+
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2}) {
+            if (level > simdLevel()) continue;
+
+            const int frames = 200;
+            auto start = nowNs();
+            for (int f = 0; f < frames; ++f) colorizeDepth(depth.data(), rgb.data(), pixels, level);
+            double seconds = (nowNs() - start) / 1e9;
+            bool identical = rgb == reference;
+
+            std::string resolution = std::to_string(size.first) + "x" + std::to_string(size.second);
+            std::cout << std::left << std::setw(14) << resolution
+                      << std::setw(10) << simdLevelName(level)
+                      << std::right << std::fixed << std::setprecision(0)
+                      << std::setw(14) << (frames / seconds)
+                      << std::setprecision(1) << std::setw(12) << (frames * pixels / seconds / 1e6)
+                      << std::setw(12) << (identical ? "yes" : "NO") << "\n";
+
+            g_report.add("depth_colorize", resolution + "_" + simdLevelName(level))
+                .param("pixels", static_cast<std::uint64_t>(pixels))
+                .metric("frames_per_sec", frames / seconds)
+                .metric("identical", identical ? 1.0 : 0.0);
+        }
+    }
+}
+
+/**
+ * Depth Analysis - whole-frame DepthAnalysis per SIMD level vs the 60 fps frame budget
+ */
+void benchDepthAnalysis() {
+    printBenchHeader("Depth Analysis",
+                     "Single-pass Z16 summary (valid ratio, min, max, avg); share of the 16.7 ms budget at 60 fps");
+
+    std::cout << std::left << std::setw(14) << "Resolution"
+              << std::setw(10) << "Level"
+              << std::right << std::setw(14) << "frames/s"
+              << std::setw(12) << "us/frame"
+              << std::setw(12) << "budget%"
+              << std::setw(12) << "identical" << "\n";
+    std::cout << "--------------------------------------------------------------------------\n";
+
+    const std::pair<int, int> sizes[] = {{640, 480}, {1280, 720}};
+    for (const auto& size : sizes) {
+        std::size_t pixels = static_cast<std::size_t>(size.first) * size.second;
+
+        // 약 12%는 무효(0) 픽셀
+        std::mt19937 rng(11);
+        std::vector<std::uint16_t> depth(pixels);
+        for (auto& v : depth) v = static_cast<std::uint16_t>(rng() % 8 == 0 ? 0 : 200 + rng() % 9800);
+
+        DepthAnalysis reference = analyzeDepth(depth.data(), size.first, size.second, SimdLevel::SCALAR);
+
+        for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2}) {
+            if (level > simdLevel()) continue;
+
+            const int frames = 500;
+            DepthAnalysis result;
+            auto start = nowNs();
+            for (int f = 0; f < frames; ++f) result = analyzeDepth(depth.data(), size.first, size.second, level);
+            double us = (nowNs() - start) / 1000.0 / frames;
+
+            bool identical = result.min_depth == reference.min_depth && result.max_depth == reference.max_depth &&
+                             result.avg_depth == reference.avg_depth && result.valid_pixel_ratio == reference.valid_pixel_ratio;
+
+            std::string resolution = std::to_string(size.first) + "x" + std::to_string(size.second);
+            std::cout << std::left << std::setw(14) << resolution
+                      << std::setw(10) << simdLevelName(level)
+                      << std::right << std::fixed << std::setprecision(0)
+                      << std::setw(14) << (1e6 / us)
+                      << std::setprecision(1) << std::setw(12) << us
+                      << std::setprecision(2) << std::setw(12) << (us / 16666.7 * 100.0)
+                      << std::setw(12) << (identical ? "yes" : "NO") << "\n";
+
+            g_report.add("depth_analysis", resolution + "_" + simdLevelName(level))
+                .param("pixels", static_cast<std::uint64_t>(pixels))
+                .metric("frames_per_sec", 1e6 / us)
+                .metric("us_per_frame", us)
+                .metric("identical", identical ? 1.0 : 0.0);
+        }
+    }
+}
+
+/**
+ * Color Analysis - RGB8 means / luma histogram per SIMD level vs the 60 fps frame budget
+ */
+void benchColorAnalysis() {
+    printBenchHeader("Color Analysis",
+                     "Single-pass RGB8 summary (channel means, luma, 16-bin histogram); share of the 16.7 ms budget at 60 fps");
+
+    std::cout << std::left << std::setw(14) << "Resolution"
+              << std::setw(10) << "Level"
+              << std::setw(11) << "Histogram"
+              << std::right << std::setw(14) << "frames/s"
+              << std::setw(12) << "us/frame"
+              << std::setw(12) << "budget%"
+              << std::setw(12) << "identical" << "\n";
+    std::cout << "-------------------------------------------------------------------------------------\n";
+
+    const std::pair<int, int> sizes[] = {{640, 480}, {1280, 720}};
+    for (const auto& size : sizes) {
+        std::size_t pixels = static_cast<std::size_t>(size.first) * size.second;
+
+        std::mt19937 rng(13);
+        std::vector<std::uint8_t> color(pixels * 3);
+        for (auto& v : color) v = static_cast<std::uint8_t>(rng());
+
+        for (bool histogram : {false, true}) {
+            ColorAnalysis reference = analyzeColor(color.data(), size.first, size.second, histogram, SimdLevel::SCALAR);
+
+            for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2}) {
+                if (level > simdLevel()) continue;
+
+                const int frames = 300;
+                ColorAnalysis result;
+                auto start = nowNs();
+                for (int f = 0; f < frames; ++f) result = analyzeColor(color.data(), size.first, size.second, histogram, level);
+                double us = (nowNs() - start) / 1000.0 / frames;
+
+                bool identical = result.avg_brightness == reference.avg_brightness && result.mean_r == reference.mean_r &&
+                                 result.mean_g == reference.mean_g && result.mean_b == reference.mean_b &&
+                                 std::equal(std::begin(result.histogram), std::end(result.histogram), std::begin(reference.histogram));
+
+                std::string resolution = std::to_string(size.first) + "x" + std::to_string(size.second);
+                std::cout << std::left << std::setw(14) << resolution
+                          << std::setw(10) << simdLevelName(level)
+                          << std::setw(11) << (histogram ? "on" : "off")
+                          << std::right << std::fixed << std::setprecision(0)
+                          << std::setw(14) << (1e6 / us)
+                          << std::setprecision(1) << std::setw(12) << us
+                          << std::setprecision(2) << std::setw(12) << (us / 16666.7 * 100.0)
+                          << std::setw(12) << (identical ? "yes" : "NO") << "\n";
+
+                g_report.add("color_analysis", resolution + "_" + simdLevelName(level) + (histogram ? "_histogram" : ""))
+                    .param("pixels", static_cast<std::uint64_t>(pixels))
+                    .metric("frames_per_sec", 1e6 / us)
+                    .metric("us_per_frame", us)
+                    .metric("identical", identical ? 1.0 : 0.0);
+            }
+        }
+    }
+}
+
+/**
+ * Job Pool - encode-style jobs behind a bounded queue: drops, queue depth and producer stall per policy
+ */
+void benchJobPool() {
+    printBenchHeader("Job Pool",
+                     "1280x720 depth colorize x4 per job, one job per ms (overloads 1-2 workers); producer = broker thread");
+
+    std::cout << std::left << std::setw(12) << "Policy"
+              << std::setw(9) << "Workers"
+              << std::right << std::setw(11) << "completed"
+              << std::setw(10) << "dropped"
+              << std::setw(11) << "max depth"
+              << std::setw(12) << "job p50 ms"
+              << std::setw(12) << "job p99 ms"
+              << std::setw(16) << "submit p99 us" << "\n";
+    std::cout << "-------------------------------------------------------------------------------------------\n";
+
+    const std::size_t pixels = 1280 * 720;
+    std::mt19937 rng(17);
+    std::vector<std::uint16_t> depth(pixels);
+    for (auto& v : depth) v = static_cast<std::uint16_t>(rng() % 12000);
+
+    const std::pair<OverflowPolicy, const char*> policies[] = {
+        {OverflowPolicy::RejectNewest, "reject"},
+        {OverflowPolicy::OverwriteOldest, "overwrite"},
+        {OverflowPolicy::Block, "block"},
+    };
+
+    for (const auto& policy : policies) {
+        for (std::size_t workers : {1, 2, 4}) {
+            const int jobs = 300;
+            LatencyHistogram submit_time;
+
+            // 워커별 출력 버퍼
+            JobPool<int> pool(workers, 8, policy.first, std::chrono::microseconds(2000), [&](int&) {
+                static thread_local std::vector<std::uint8_t> rgb(pixels * 3);
+                for (int k = 0; k < 4; ++k) colorizeDepth(depth.data(), rgb.data(), pixels);
+            });
+
+            auto next = std::chrono::steady_clock::now();
+            for (int j = 0; j < jobs; ++j) {
+                std::this_thread::sleep_until(next);
+                next += std::chrono::milliseconds(1);
+
+                auto start = nowNs();
+                pool.submit(j);
+                submit_time.record(nowNs() - start);
+            }
+            pool.shutdown();
+
+            std::cout << std::left << std::setw(12) << policy.second
+                      << std::setw(9) << workers
+                      << std::right << std::setw(11) << pool.completed()
+                      << std::setw(10) << pool.dropped()
+                      << std::setw(11) << pool.maxDepth()
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(12) << (pool.jobTime().percentile(50) / 1e6)
+                      << std::setw(12) << (pool.jobTime().percentile(99) / 1e6)
+                      << std::setprecision(1) << std::setw(16) << (submit_time.percentile(99) / 1e3) << "\n";
+
+            g_report.add("job_pool", std::string(policy.second) + "_" + std::to_string(workers) + "w")
+                .param("jobs", static_cast<std::uint64_t>(jobs))
+                .param("workers", static_cast<std::uint64_t>(workers))
+                .metric("completed", static_cast<double>(pool.completed()))
+                .metric("dropped", static_cast<double>(pool.dropped()))
+                .metric("max_depth", static_cast<double>(pool.maxDepth()))
+                .metric("job_p99_ms", pool.jobTime().percentile(99) / 1e6)
+                .metric("submit_p99_us", submit_time.percentile(99) / 1e3);
+        }
+    }
+}
+
+/**
+ * Depth RVL - lossless compression ratio, per-frame codec time and frames/s across workers
+ */
+void benchDepthRvl() {
+    printBenchHeader("Depth RVL",
+                     "Synthetic Z16 scene (sloped floor, wall, noise, ~10% holes); raw 640x480@60 = 36.9 MB/s");
+
+    const int width = 640;
+    const int height = 480;
+    const std::size_t pixels = static_cast<std::size_t>(width) * height;
+
+    // 센서 노이즈 +-2mm, 무효 픽셀은 작은 덩어리로
+    std::mt19937 rng(19);
+    std::vector<std::vector<std::uint16_t>> frames(8, std::vector<std::uint16_t>(pixels));
+    for (std::size_t f = 0; f < frames.size(); ++f) {
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                int base = y > height / 2 ? 900 + (height - y) * 12 : 3200 + x / 4;
+                bool hole = ((x / 8 + y / 8 * 7 + static_cast<int>(f)) % 10) == 0;
+                frames[f][y * width + x] = hole ? 0 : static_cast<std::uint16_t>(base + static_cast<int>(rng() % 5) - 2);
+            }
+        }
+    }
+
+    std::vector<std::uint8_t> encoded;
+    std::vector<std::uint16_t> decoded;
+    RvlHeader header;
+
+    std::uint64_t bytes = 0;
+    bool identical = true;
+    const int rounds = 40;
+
+    auto start = nowNs();
+    for (int r = 0; r < rounds; ++r) {
+        for (const auto& frame : frames) bytes += rvlEncodeFrame(frame.data(), width, height, 0.001f, encoded);
+    }
+    double encode_ms = (nowNs() - start) / 1e6 / (rounds * frames.size());
+
+    std::uint64_t decode_ns = 0;
+    for (const auto& frame : frames) {
+        std::size_t size = rvlEncodeFrame(frame.data(), width, height, 0.001f, encoded);
+        auto t = nowNs();
+        for (int r = 0; r < rounds; ++r) identical &= rvlDecodeFrame(encoded.data(), size, header, decoded);
+        decode_ns += nowNs() - t;
+        identical &= decoded == frame;
+    }
+    double decode_ms = decode_ns / 1e6 / (rounds * frames.size());
+
+    double ratio = static_cast<double>(pixels * 2) * rounds * frames.size() / bytes;
+    std::cout << std::fixed << std::setprecision(2)
+              << "ratio " << ratio << "x, encode " << encode_ms << " ms/frame, decode " << decode_ms << " ms/frame, "
+              << "60 fps stream " << (pixels * 2 * 60 / 1e6) << " -> " << (pixels * 2 * 60 / 1e6 / ratio) << " MB/s, "
+              << "round trip " << (identical ? "identical" : "MISMATCH") << "\n\n";
+
+    g_report.add("depth_rvl", "codec_640x480")
+        .param("pixels", static_cast<std::uint64_t>(pixels))
+        .metric("ratio", ratio)
+        .metric("encode_ms", encode_ms)
+        .metric("decode_ms", decode_ms)
+        .metric("identical", identical ? 1.0 : 0.0);
+
+    std::cout << std::left << std::setw(10) << "Workers"
+              << std::right << std::setw(14) << "frames/s"
+              << std::setw(16) << "x 60 fps" << "\n";
+    std::cout << "----------------------------------------\n";
+
+    for (std::size_t workers : {1, 2, 4}) {
+        const int jobs = 400;
+        JobPool<std::size_t> pool(workers, 16, OverflowPolicy::Block, std::chrono::seconds(10), [&](std::size_t& f) {
+            static thread_local std::vector<std::uint8_t> out;
+            rvlEncodeFrame(frames[f].data(), width, height, 0.001f, out);
+        });
+
+        auto t = nowNs();
+        for (int j = 0; j < jobs; ++j) pool.submit(static_cast<std::size_t>(j) % frames.size());
+        pool.shutdown();
+        double fps = jobs / ((nowNs() - t) / 1e9);
+
+        std::cout << std::left << std::setw(10) << workers
+                  << std::right << std::setprecision(0) << std::setw(14) << fps
+                  << std::setprecision(1) << std::setw(16) << (fps / 60.0) << "\n";
+
+        g_report.add("depth_rvl", "workers_" + std::to_string(workers))
+            .param("workers", static_cast<std::uint64_t>(workers))
+            .metric("frames_per_sec", fps);
+    }
+}
+
+/**
+ * Clock Align - ClockAligner on simulated streams: aligned-time error vs raw callback arrival
+ */
+void benchClockAlign() {
+    printBenchHeader("Clock Align",
+                     "Device clock with drift, 2 ms + exp(0.5 ms) arrival latency, 1% 20 ms stalls; 10 min per stream");
+
+    std::cout << std::left << std::setw(12) << "Stream"
+              << std::right << std::setw(8) << "Hz"
+              << std::setw(12) << "true ppm"
+              << std::setw(12) << "est ppm"
+              << std::setw(16) << "arrival sd us"
+              << std::setw(16) << "aligned sd us"
+              << std::setw(14) << "ns/update" << "\n";
+    std::cout << "------------------------------------------------------------------------------------------\n";
+
+    struct Stream { const char* name; double hz; double ppm; };
+    const Stream streams[] = {{"tobii", 120.0, 35.0}, {"realsense", 60.0, -80.0}, {"camera", 30.0, 12.0}};
+
+    for (const auto& stream : streams) {
+        ClockAligner clock;
+        std::mt19937 rng(23);
+        std::exponential_distribution<double> jitter(1.0 / 500e3);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        const int samples = static_cast<int>(stream.hz * 600);
+        const int settle = static_cast<int>(stream.hz * 10);
+        double raw_sum = 0, raw_sq = 0, aligned_sum = 0, aligned_sq = 0;
+        std::uint64_t update_ns = 0;
+
+        for (int i = 0; i < samples; ++i) {
+            double capture = i / stream.hz * 1e9;       // host time of capture
+            auto device = static_cast<std::int64_t>(4e12 + capture * (1.0 + stream.ppm * 1e-6));
+            double latency = 2e6 + jitter(rng) + (uniform(rng) < 0.01 ? 20e6 : 0.0);
+            auto host = static_cast<std::int64_t>(1e12 + capture + latency);
+
+            auto t = nowNs();
+            std::int64_t aligned = clock.align(device, host);
+            update_ns += nowNs() - t;
+
+            if (i < settle) continue;
+            double raw_error = host - (1e12 + capture);
+            double aligned_error = aligned - (1e12 + capture);
+            raw_sum += raw_error; raw_sq += raw_error * raw_error;
+            aligned_sum += aligned_error; aligned_sq += aligned_error * aligned_error;
+        }
+
+        double n = samples - settle;
+        double raw_sd = std::sqrt(raw_sq / n - (raw_sum / n) * (raw_sum / n)) / 1e3;
+        double aligned_sd = std::sqrt(aligned_sq / n - (aligned_sum / n) * (aligned_sum / n)) / 1e3;
+        double per_update = static_cast<double>(update_ns) / samples;
+
+        std::cout << std::left << std::setw(12) << stream.name
+                  << std::right << std::fixed << std::setprecision(0) << std::setw(8) << stream.hz
+                  << std::setprecision(1) << std::setw(12) << stream.ppm
+                  << std::setw(12) << clock.driftPpm()
+                  << std::setw(16) << raw_sd
+                  << std::setw(16) << aligned_sd
+                  << std::setprecision(0) << std::setw(14) << per_update << "\n";
+
+        g_report.add("clock_align", stream.name)
+            .param("hz", static_cast<std::uint64_t>(stream.hz))
+            .metric("drift_ppm_error", clock.driftPpm() - stream.ppm)
+            .metric("arrival_sd_us", raw_sd)
+            .metric("aligned_sd_us", aligned_sd)
+            .metric("ns_per_update", per_update);
+    }
+}
+
+/**
+ * Timestamp Source - capture read cost per backend vs system_clock::now, and tick -> host ns mapping error
+ */
+void benchTimestampSource() {
+    printBenchHeader("Timestamp Source",
+                     "10M reads per clock; mapping error vs the OS monotonic clock over 3 s (100 ms steps)");
+
+    std::cout << std::left << std::setw(14) << "Clock"
+              << std::right << std::setw(12) << "ns/read"
+              << std::setw(18) << "map err max ns"
+              << std::setw(18) << "map err avg ns" << "\n";
+    std::cout << "--------------------------------------------------------------\n";
+
+    const int reads = 10000000;
+
+    // baseline: the read the callbacks used to do
+    {
+        std::int64_t sink = 0;
+        auto t = nowNs();
+        for (int i = 0; i < reads; ++i) sink += std::chrono::system_clock::now().time_since_epoch().count();
+        double per_read = static_cast<double>(nowNs() - t) / reads;
+        if (sink == 42) std::cout << "";
+
+        std::cout << std::left << std::setw(14) << "system_clock"
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(12) << per_read
+                  << std::setw(18) << "-" << std::setw(18) << "-" << "\n";
+
+        g_report.add("timestamp_source", "system_clock")
+            .metric("ns_per_read", per_read);
+    }
+
+    for (TimestampBackend requested : {TimestampBackend::MONOTONIC, TimestampBackend::TSC}) {
+        TimestampSource source;
+        TimestampBackend backend = source.select(requested);
+        if (backend != requested) {
+            std::cout << std::left << std::setw(14) << timestampBackendName(requested) << "  (not invariant, skipped)\n";
+            continue;
+        }
+
+        std::int64_t sink = 0;
+        auto t = nowNs();
+        for (int i = 0; i < reads; ++i) sink += source.now();
+        double per_read = static_cast<double>(nowNs() - t) / reads;
+        if (sink == 42) std::cout << "";
+
+        // mapping vs a bracketed OS monotonic read
+        double error_max = 0.0, error_sum = 0.0;
+        const int steps = 30;
+        for (int i = 0; i < steps; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            TimestampMapping map = source.mapping();
+            std::int64_t before = _readMonotonic();
+            std::int64_t ticks = source.now();
+            std::int64_t after = _readMonotonic();
+            double error = std::fabs(static_cast<double>(map.hostNs(ticks) - (before + (after - before) / 2)));
+            error_max = std::max(error_max, error);
+            error_sum += error;
+        }
+
+        std::cout << std::left << std::setw(14) << timestampBackendName(backend)
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(12) << per_read
+                  << std::setprecision(0) << std::setw(18) << error_max
+                  << std::setw(18) << (error_sum / steps) << "\n";
+
+        g_report.add("timestamp_source", timestampBackendName(backend))
+            .metric("ns_per_read", per_read)
+            .metric("map_error_max_ns", error_max)
+            .metric("map_error_avg_ns", error_sum / steps);
+    }
+}
+
+/**
+ * Gaze Join - GazeJoiner on simulated streams: forced / late joins, held entries and error vs tolerance
+ */
+void benchGazeJoin() {
+    printBenchHeader("Gaze Join",
+                     "120 Hz gaze (batches every 5-60 ms), 60 Hz frames (per frame); 10 min per tolerance");
+
+    std::cout << std::left << std::setw(12) << "Tol ms"
+              << std::right << std::setw(10) << "forced %"
+              << std::setw(12) << "late gaze"
+              << std::setw(12) << "held max"
+              << std::setw(14) << "err max px"
+              << std::setw(14) << "delay p99 ms"
+              << std::setw(12) << "ns/frame" << "\n";
+    std::cout << "--------------------------------------------------------------------------------------\n";
+
+    const std::int64_t duration = 600LL * 1000000000LL;
+    const std::int64_t gaze_period = 1000000000LL / 120;
+    const std::int64_t frame_period = 1000000000LL / 60;
+
+    // true gaze: a smooth pursuit across the display, x / y in display units
+    auto truth = [](std::int64_t t) { return 0.5 + 0.4 * std::sin(t * 1e-9 * 2.0); };
+
+    for (int tolerance_ms : {10, 25, 50, 100}) {
+        std::uint64_t joined = 0, forced = 0;
+        double error_max = 0.0;
+        GazeJoiner joiner(tolerance_ms * 1000000LL, 4096, [&](const GazeFrame& row) {
+            ++joined;
+            if (row.flags & JOIN_FORCED) ++forced;
+            if ((row.flags & (JOIN_BEFORE | JOIN_AFTER)) == (JOIN_BEFORE | JOIN_AFTER) && (row.gaze.valid & GAZE_LEFT))
+                error_max = std::max(error_max, std::fabs(row.gaze.left_x - truth(row.frame.time_ns)) * 1920.0);
+        });
+
+        std::mt19937 rng(29);
+        std::uniform_int_distribution<std::int64_t> batch_delay(5000000, 60000000);
+        std::vector<GazeSample> pending;
+        std::int64_t next_gaze = 0, next_frame = 3000000, next_flush = batch_delay(rng);
+        std::uint64_t frame_number = 0;
+        std::uint64_t push_ns = 0;
+
+        // host time walks in 1 ms steps; gaze is handed over in batches like TobiiBroker, frames one by one
+        for (std::int64_t now = 0; now < duration; now += 1000000) {
+            while (next_gaze <= now) {
+                GazeSample sample;
+                sample.time_ns = next_gaze;
+                sample.left_x = sample.right_x = static_cast<float>(truth(next_gaze));
+                sample.left_y = sample.right_y = 0.5f;
+                sample.valid = GAZE_LEFT | GAZE_RIGHT;
+                pending.push_back(sample);
+                next_gaze += gaze_period;
+            }
+            if (now >= next_flush) {
+                auto t = nowNs();
+                joiner.pushGaze(pending.data(), pending.size());
+                push_ns += nowNs() - t;
+                pending.clear();
+                next_flush = now + batch_delay(rng);
+            }
+            while (next_frame <= now) {
+                GazeJoinFrame frame{frame_number++, next_frame};
+                auto t = nowNs();
+                joiner.pushFrames(&frame, 1);
+                push_ns += nowNs() - t;
+                next_frame += frame_period;
+            }
+        }
+        joiner.close();
+
+        double forced_pct = joined ? 100.0 * forced / joined : 0.0;
+        double delay_p99 = joiner.delay().percentile(99) / 1e6;
+        double per_frame = static_cast<double>(push_ns) / frame_number;
+        std::size_t held = std::max(joiner.maxPendingFrames(), joiner.maxHeldGaze());
+
+        std::cout << std::left << std::setw(12) << tolerance_ms
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(10) << forced_pct
+                  << std::setw(12) << joiner.lateGaze()
+                  << std::setw(12) << held
+                  << std::setprecision(3) << std::setw(14) << error_max
+                  << std::setprecision(1) << std::setw(14) << delay_p99
+                  << std::setprecision(0) << std::setw(12) << per_frame << "\n";
+
+        g_report.add("gaze_join", "tolerance_" + std::to_string(tolerance_ms) + "ms")
+            .param("tolerance_ms", static_cast<std::uint64_t>(tolerance_ms))
+            .metric("frames", static_cast<double>(joined))
+            .metric("forced_pct", forced_pct)
+            .metric("late_gaze", static_cast<double>(joiner.lateGaze()))
+            .metric("held_max", static_cast<double>(held))
+            .metric("error_max_px", error_max)
+            .metric("delay_p99_ms", delay_p99)
+            .metric("ns_per_frame", per_frame);
+    }
+}
+
+/**
+ * Start Barrier - Syncorder::executeStart 후 각 buffer gate가 열린 시각의 spread (barrier 없음 vs barrier)
+ */
+class GateManager : public BManager {
+private:
+    std::string name_;
+    std::chrono::microseconds broker_start_;       // broker_->start() 비용 흉내 (thread 생성 등)
+    BBuffer<int, 64> buffer_;
+
+public:
+    GateManager(int index, std::chrono::microseconds broker_start) : name_("Gate" + std::to_string(index)), broker_start_(broker_start) {}
+
+    bool setup(const CancelToken&) override { is_setup_.store(true); return true; }
+    bool warmup(const CancelToken&) override { is_warmup_.store(true); return true; }
+    bool start(const CancelToken&) override {
+        std::this_thread::sleep_for(broker_start_);
+        started_ticks_.store(buffer_.start(start_barrier_));
+        is_running_.store(true);
+        return true;
+    }
+    bool stop(const CancelToken&) override { buffer_.stop(); is_running_.store(false); return true; }
+    bool cleanup(const CancelToken&) override { return true; }
+
+    std::string __name__() const override { return name_; }
+};
+
+void benchStartBarrier() {
+    printBenchHeader("Start Barrier",
+                     "3 managers (broker start 0 / 0.5 / 1 ms), executeStart 100 times; spread = last gate open - first gate open");
+
+    std::cout << std::left << std::setw(22) << "Mode"
+              << std::right << std::setw(14) << "p50(us)"
+              << std::setw(12) << "p99(us)"
+              << std::setw(12) << "max(us)" << "\n";
+    std::cout << "------------------------------------------------------------\n";
+
+    struct Mode { const char* name; int lead_us; int spin_us; };
+    const Mode modes[] = {{"async (no barrier)", 0, 0}, {"barrier 5ms/2ms", 5000, 2000}, {"barrier 50ms/20ms", 50000, 20000}};
+    const int repeats = 100;
+
+    for (const auto& mode : modes) {
+        LatencyHistogram spread;
+        {
+            NullStreamBuf null_buffer;
+            std::streambuf* original = std::cout.rdbuf(&null_buffer);
+
+            Syncorder syncorder;
+            std::vector<GateManager*> managers;
+            for (int i = 0; i < 3; ++i) {
+                auto manager = std::make_unique<GateManager>(i, std::chrono::microseconds(500 * i));
+                managers.push_back(manager.get());
+                syncorder.addDevice(std::move(manager));
+            }
+            syncorder.setStartBarrier(std::chrono::microseconds(mode.lead_us), std::chrono::microseconds(mode.spin_us));
+
+            for (int r = 0; r < repeats; ++r) {
+                syncorder.executeStart();
+                std::int64_t lo = managers[0]->startedTicks(), hi = lo;
+                for (auto* manager : managers) {
+                    lo = std::min(lo, manager->startedTicks());
+                    hi = std::max(hi, manager->startedTicks());
+                }
+                spread.record(static_cast<std::int64_t>((hi - lo) * timestamps().mapping().ns_per_tick));
+                for (auto* manager : managers) manager->stop(CancelToken());
+            }
+
+            std::cout.rdbuf(original);
+        }
+
+        std::cout << std::left << std::setw(22) << mode.name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << (spread.percentile(50.0) / 1000.0)
+                  << std::setw(12) << (spread.percentile(99.0) / 1000.0)
+                  << std::setw(12) << (spread.max() / 1000.0) << "\n";
+
+        g_report.add("start_barrier", mode.name)
+            .param("lead_us", static_cast<std::uint64_t>(mode.lead_us))
+            .param("spin_us", static_cast<std::uint64_t>(mode.spin_us))
+            .latency(spread);
+    }
+}
+
+/**
+ * Main Bench Runner
+ *
+ * usage: bench_syncorder [--json <path>] [--filter <bench name substring>]
+ */
+int main(int argc, char* argv[]) {
+    std::string json_path = "bench_syncorder.json";
+    std::string filter;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (false) {
+            // ...
+        }
+        else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        }
+        else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        }
+    }
+
+    std::cout << "===========================================\n";
+    std::cout << "SYNCORDER CAPTURE CORE BENCHMARK\n";
+    std::cout << "===========================================\n";
+
+    const std::vector<std::pair<std::string, std::function<void()>>> benches = {
+        {"handoff_allocations", benchHandoffAllocations},
+        {"ring_layout", benchRingLayout},
+        {"multi_producer", benchMultiProducer},
+        {"buffer_element_size", benchBufferSizes},
+        {"broker_end_to_end", benchBrokerLatency},
+        {"execute_stage", benchExecuteStage},
+        {"csv_emit", benchCsvEmit},
+        {"file_writer", benchFileWriter},
+        {"container", benchContainer},
+        {"depth_colorize", benchDepthColorize},
+        {"depth_analysis", benchDepthAnalysis},
+        {"color_analysis", benchColorAnalysis},
+        {"job_pool", benchJobPool},
+        {"depth_rvl", benchDepthRvl},
+        {"clock_align", benchClockAlign},
+        {"timestamp_source", benchTimestampSource},
+        {"gaze_join", benchGazeJoin},
+        {"start_barrier", benchStartBarrier},
+    };
+
+    try {
+        for (const auto& bench : benches) {
+            if (!filter.empty() && bench.first.find(filter) == std::string::npos) continue;
+            bench.second();
+        }
+    } catch (const std::exception& e) {
+        std::cout << "\nFATAL ERROR: " << e.what() << "\n";
+        return -1;
+    }
+
+    if (!g_report.write(json_path)) {
+        std::cout << "\nFailed to write " << json_path << "\n";
+        return -1;
+    }
+    std::cout << "\nResults written to " << json_path << "\n";
+
+    // 정확성 회귀는 exit code로도 알림
+    std::vector<std::string> mismatches = g_report.mismatches();
+    if (!mismatches.empty()) {
+        std::cout << "\nOutput mismatch in " << mismatches.size() << " case(s):\n";
+        for (const auto& name : mismatches) std::cout << "  " << name << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,13 @@
+#!/bin/sh
+# Linux / macOS build - no device SDK needed (run from repo root)
+# -Wno-mismatched-new-delete: the allocation counter replaces operator new / delete with malloc / free
+
+g++ \
+  -std=c++17 \
+  -O2 \
+  -Wall \
+  -Wno-mismatched-new-delete \
+  -I . \
+  test/bench_syncorder/bench_syncorder.cpp \
+  -o test/bench_syncorder/bench_syncorder \
+  -pthread
@@ -6,9 +6,20 @@
 #include <vector>
 #include <iomanip>
 #include <sstream>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <cmath>
+#include <functional>
 
 #include "Syncorder/devices/common/device_base.h"
 #include "Syncorder/devices/common/manager_base.h"
+#include "Syncorder/devices/common/buffer_base.h"
+#include "Syncorder/devices/common/csv_writer.h"
+#include "Syncorder/devices/common/record_log.h"
+#include "Syncorder/devices/realsense/colorize.h"
+#include "Syncorder/devices/realsense/analysis.h"
+#include "Syncorder/devices/realsense/rvl.h"
 #include "Syncorder/syncorder.cpp"
 
 /**
@@ -36,55 +47,97 @@ public:
                      std::chrono::milliseconds start_time)
         : name_(name), setup_time_(setup_time), warmup_time_(warmup_time), start_time_(start_time) {}
     
-    void setup() override {
+    bool setup(const CancelToken& token) override {
         setup_start_ = std::chrono::steady_clock::now();
         std::cout << "  [" << name_ << "] Setup starting... (expected: " << setup_time_.count() << "ms)\n";
         
-        std::this_thread::sleep_for(setup_time_);
+        if (!token.sleepFor(setup_time_)) {
+            std::cout << "  [" << name_ << "] Setup cancelled\n";
+            return false;
+        }
         is_setup_.store(true);
         
         setup_end_ = std::chrono::steady_clock::now();
         auto actual = std::chrono::duration_cast<std::chrono::milliseconds>(setup_end_ - setup_start_);
         std::cout << "  [" << name_ << "] Setup completed (actual: " << actual.count() << "ms)\n";
+        return true;
     }
     
-    void warmup() override {
+    bool warmup(const CancelToken& token) override {
         warmup_start_ = std::chrono::steady_clock::now();
         std::cout << "  [" << name_ << "] Warmup starting... (expected: " << warmup_time_.count() << "ms)\n";
         
-        std::this_thread::sleep_for(warmup_time_);
+        if (!token.sleepFor(warmup_time_)) {
+            std::cout << "  [" << name_ << "] Warmup cancelled\n";
+            return false;
+        }
         is_warmup_.store(true);
         
         warmup_end_ = std::chrono::steady_clock::now();
         auto actual = std::chrono::duration_cast<std::chrono::milliseconds>(warmup_end_ - warmup_start_);
         std::cout << "  [" << name_ << "] Warmup completed (actual: " << actual.count() << "ms)\n";
+        return true;
     }
     
-    void start() override {
+    bool start(const CancelToken& token) override {
         start_start_ = std::chrono::steady_clock::now();
         std::cout << "  [" << name_ << "] Start starting... (expected: " << start_time_.count() << "ms)\n";
         
-        std::this_thread::sleep_for(start_time_);
+        if (!token.sleepFor(start_time_)) {
+            std::cout << "  [" << name_ << "] Start cancelled\n";
+            return false;
+        }
         is_running_.store(true);
         
         start_end_ = std::chrono::steady_clock::now();
         auto actual = std::chrono::duration_cast<std::chrono::milliseconds>(start_end_ - start_start_);
         std::cout << "  [" << name_ << "] Start completed (actual: " << actual.count() << "ms)\n";
+        return true;
     }
     
-    void stop() override {
+    bool stop(const CancelToken&) override {
         is_running_.store(false);
+        return true;
     }
     
-    void cleanup() override {
+    bool cleanup(const CancelToken&) override {
         is_setup_.store(false);
         is_warmup_.store(false);
         is_running_.store(false);
+        return true;
     }
     
     std::string __name__() const override { return name_; }
 };
 
+/**
+ * Token을 무시하는 Mock Device - start()가 SDK 호출처럼 hang_ 동안 block
+ */
+class HungTestDevice : public BManager {
+private:
+    std::string name_;
+    std::chrono::milliseconds hang_;
+
+public:
+    HungTestDevice(const std::string& name, std::chrono::milliseconds hang) : name_(name), hang_(hang) {}
+
+    bool setup(const CancelToken&) override { is_setup_.store(true); return true; }
+    bool warmup(const CancelToken&) override { is_warmup_.store(true); return true; }
+
+    bool start(const CancelToken&) override {
+        // 포기된 뒤에도 깨어나므로 sleep 이후에는 member에 접근하지 않음
+        std::chrono::milliseconds hang = hang_;
+        std::cout << "  [" << name_ << "] Start hanging for " << hang.count() << "ms (ignores cancellation)\n";
+        std::this_thread::sleep_for(hang);
+        return false;
+    }
+
+    bool stop(const CancelToken&) override { return true; }
+    bool cleanup(const CancelToken&) override { return true; }
+
+    std::string __name__() const override { return name_; }
+};
+
 /**
  * 테스트 결과 출력 헬퍼
  */
@@ -107,7 +160,12 @@ void printPhaseResult(const std::string& phase, int64_t actual_ms, int64_t expec
     std::cout << "  Result:        " << (passed ? "PASS" : "FAIL") << "\n";
 }
 
+// 실패한 테스트 수: main의 exit code
+int failed_tests = 0;
+
 void printTestResult(bool success, const std::string& message = "") {
+    if (!success) ++failed_tests;
+
     std::cout << "\n--- TEST RESULT ---\n";
     std::cout << "Status: " << (success ? "PASSED" : "FAILED") << "\n";
     if (!message.empty()) {
@@ -361,6 +419,496 @@ void testPreciseSynchronization() {
     printTestResult(all_passed, "Precise phase-by-phase synchronization verified");
 }
 
+void testHungDeviceTimeout() {
+    printTestHeader("Hung Device Timeout",
+                   "Verify per-manager deadlines: a late stage call is cancelled on time and cannot stall shutdown");
+
+    std::cout << "SETUP: Three devices, default timeout 5000ms:\n";
+    std::cout << "  Healthy:     setup=50ms, warmup=50ms, start=50ms\n";
+    std::cout << "  Cooperative: start=3000ms, deadline 500ms  (sleeps on its token)\n";
+    std::cout << "  Hung:        start blocks 3000ms, deadline 500ms  (ignores its token)\n";
+    std::cout << "\nEXPECTED BEHAVIOR: Start fails after ~500ms, destruction does not wait for Hung\n";
+
+    auto syncorder = std::make_unique<Syncorder>();
+    syncorder->setTimeout(std::chrono::milliseconds(5000));
+
+    syncorder->addDevice(std::make_unique<TimingTestDevice>(
+        "Healthy", std::chrono::milliseconds(50),
+        std::chrono::milliseconds(50), std::chrono::milliseconds(50)));
+    syncorder->addDevice(std::make_unique<TimingTestDevice>(
+        "Cooperative", std::chrono::milliseconds(50),
+        std::chrono::milliseconds(50), std::chrono::milliseconds(3000)), std::chrono::milliseconds(500));
+    syncorder->addDevice(std::make_unique<HungTestDevice>(
+        "Hung", std::chrono::milliseconds(3000)), std::chrono::milliseconds(500));
+
+    syncorder->executeSetup();
+    syncorder->executeWarmup();
+
+    std::cout << "\nEXECUTING: Start Phase (expecting failure after ~500ms)...\n";
+    auto start_start = std::chrono::steady_clock::now();
+    bool start_ok = syncorder->executeStart();
+    auto start_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_start);
+
+    printPhaseResult("Start", start_duration.count(), 500);
+
+    // Hung은 아직 block 중: stop / cleanup / 소멸이 기다리지 않아야 함
+    std::cout << "\nEXECUTING: Stop, cleanup and shutdown while Hung is still blocked...\n";
+    auto shutdown_start = std::chrono::steady_clock::now();
+    syncorder->executeStop();
+    syncorder->executeCleanup();
+    syncorder.reset();
+    auto shutdown_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - shutdown_start);
+
+    std::cout << "\n--- HUNG DEVICE RESULT ---\n";
+    std::cout << "Start phase:    " << start_duration.count() << "ms (deadline 500ms)\n";
+    std::cout << "Shutdown:       " << shutdown_duration.count() << "ms (Hung blocks until ~3000ms)\n";
+
+    bool passed = !start_ok &&
+                  (start_duration.count() >= 400 && start_duration.count() <= 700) &&
+                  shutdown_duration.count() <= 500;
+    printTestResult(passed, "Late stage calls cancelled at their own deadline, shutdown not stalled");
+}
+
+/**
+ * Overflow policy 테스트: producer / consumer 스레드 1개씩
+ *
+ * producer는 0, 1, 2, ... 순번을 넣고 enqueue가 받아준 순번을 기록한다.
+ * consumer는 일부러 느리게 꺼내서 ring이 넘치게 만든다.
+ */
+struct SeqSample {
+    std::uint64_t seq;
+};
+
+using SeqBuffer = BBuffer<SeqSample, 64>;
+
+struct OverflowRun {
+    std::vector<std::uint64_t> accepted;    // enqueue == true
+    std::vector<std::uint64_t> received;    // dequeue_n 순서 그대로
+};
+
+/**
+ * count개를 넣고 전부 꺼낼 때까지 돌린다. pause_consumer 동안 consumer는 멈춰 있다.
+ */
+void runOverflow(SeqBuffer& buffer, OverflowRun& run, std::uint64_t first, std::uint64_t count, bool pause_consumer) {
+    std::atomic<bool> producing{true};
+    std::atomic<bool> paused{pause_consumer};
+
+    std::thread consumer([&] {
+        SeqSample batch[8];
+        for (;;) {
+            if (paused.load()) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::size_t n = buffer.dequeue_n(batch, 8);
+            for (std::size_t i = 0; i < n; ++i) run.received.push_back(batch[i].seq);
+
+            if (n == 0) {
+                if (!producing.load() && buffer.dequeue_n(batch, 8) == 0) break;
+                std::this_thread::yield();
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    });
+
+    for (std::uint64_t seq = first; seq < first + count; ++seq) {
+        if (buffer.enqueue(SeqSample{seq})) run.accepted.push_back(seq);
+        if (seq % 256 == 0) std::this_thread::yield();
+    }
+    buffer.flushSpill();
+
+    paused.store(false);
+    producing.store(false);
+    consumer.join();
+}
+
+bool strictlyIncreasing(const std::vector<std::uint64_t>& values) {
+    for (std::size_t i = 1; i < values.size(); ++i) {
+        if (values[i] <= values[i - 1]) return false;
+    }
+    return true;
+}
+
+// received가 accepted의 부분열인가 (순서 유지, 중복 없음)
+bool isSubsequence(const std::vector<std::uint64_t>& sub, const std::vector<std::uint64_t>& of) {
+    std::size_t j = 0;
+    for (std::uint64_t value : of) {
+        if (j < sub.size() && sub[j] == value) ++j;
+    }
+    return j == sub.size();
+}
+
+void printOverflowCounters(const SeqBuffer& buffer, const OverflowRun& run, std::uint64_t produced) {
+    std::cout << "  produced:    " << produced << "\n";
+    std::cout << "  accepted:    " << run.accepted.size() << "\n";
+    std::cout << "  received:    " << run.received.size() << "\n";
+    std::cout << "  dropped:     " << buffer.dropped() << "\n";
+    std::cout << "  overwritten: " << buffer.overwritten() << "\n";
+    std::cout << "  spilled:     " << buffer.spilled() << "\n";
+    std::cout << "  FIFO order:  " << (strictlyIncreasing(run.received) ? "yes" : "NO") << "\n";
+}
+
+void testOverflowRejectNewest() {
+    printTestHeader("Overflow: RejectNewest",
+                   "Full ring drops the incoming sample: everything accepted arrives once, in order");
+
+    const std::uint64_t produced = 20000;
+    SeqBuffer buffer;
+    buffer.setOverflowPolicy(OverflowPolicy::RejectNewest);
+    buffer.start();
+
+    OverflowRun run;
+    runOverflow(buffer, run, 0, produced, false);
+    printOverflowCounters(buffer, run, produced);
+
+    bool passed = run.received == run.accepted &&
+                  run.accepted.size() + buffer.dropped() == produced &&
+                  buffer.dropped() > 0 &&
+                  buffer.overwritten() == 0 && buffer.spilled() == 0;
+    printTestResult(passed, "received == accepted, accepted + dropped == produced");
+}
+
+void testOverflowOverwriteOldest() {
+    printTestHeader("Overflow: OverwriteOldest",
+                   "Full ring evicts the oldest unread sample: no duplicates, order kept, every loss counted");
+
+    const std::uint64_t produced = 20000;
+    SeqBuffer buffer;
+    buffer.setOverflowPolicy(OverflowPolicy::OverwriteOldest);
+    buffer.start();
+
+    OverflowRun run;
+    runOverflow(buffer, run, 0, produced, false);
+    printOverflowCounters(buffer, run, produced);
+
+    bool passed = strictlyIncreasing(run.received) &&
+                  isSubsequence(run.received, run.accepted) &&
+                  run.accepted.size() + buffer.dropped() == produced &&
+                  run.received.size() + buffer.overwritten() == run.accepted.size() &&
+                  buffer.overwritten() > 0 && buffer.spilled() == 0;
+    printTestResult(passed, "received + overwritten == accepted, accepted + dropped == produced");
+}
+
+void testOverflowBlock() {
+    printTestHeader("Overflow: Block",
+                   "Full ring makes the producer wait for space: order kept, a timed-out wait is counted as dropped");
+
+    const std::uint64_t produced = 5000;
+    SeqBuffer buffer;
+    buffer.setOverflowPolicy(OverflowPolicy::Block);
+    buffer.setBlockTimeout(std::chrono::microseconds(100000));
+    buffer.start();
+
+    OverflowRun run;
+    runOverflow(buffer, run, 0, produced, false);
+    printOverflowCounters(buffer, run, produced);
+
+    bool passed = run.received == run.accepted &&
+                  run.accepted.size() + buffer.dropped() == produced &&
+                  buffer.overwritten() == 0 && buffer.spilled() == 0;
+    printTestResult(passed, "received == accepted, accepted + dropped == produced");
+}
+
+void testOverflowSpill() {
+    printTestHeader("Overflow: Spill",
+                   "Full ring spills to disk: nothing lost, FIFO across ring and spill, file rewound once drained");
+
+    const std::uint64_t burst = 10000;
+    std::string path = (std::filesystem::temp_directory_path() / "syncorder_test_overflow.spill").string();
+
+    SeqBuffer buffer;
+    bool opened = buffer.setOverflowPolicy(OverflowPolicy::Spill, path);
+    buffer.start();
+
+    // consumer가 멈춘 동안 burst 두 번: 두 번째는 비운 파일을 처음부터 다시 써야 함
+    OverflowRun run;
+    runOverflow(buffer, run, 0, burst, true);
+    std::uint64_t first_spilled = buffer.spilled();
+
+    runOverflow(buffer, run, burst, burst, true);
+    std::uint64_t second_spilled = buffer.spilled() - first_spilled;
+
+    std::uintmax_t file_size = opened ? std::filesystem::file_size(path) : 0;
+    printOverflowCounters(buffer, run, 2 * burst);
+    std::cout << "  spill file:  " << file_size << " bytes (second burst: " << second_spilled * sizeof(SeqSample) << ")\n";
+
+    std::vector<std::uint64_t> expected(2 * burst);
+    for (std::uint64_t i = 0; i < expected.size(); ++i) expected[i] = i;
+
+    bool passed = opened &&
+                  run.received == expected &&
+                  buffer.dropped() == 0 && buffer.overwritten() == 0 &&
+                  first_spilled > 0 && second_spilled > 0 &&
+                  file_size == second_spilled * sizeof(SeqSample);
+    printTestResult(passed, "every sample received once in order, spill file holds only the last backlog");
+}
+
+/**
+ * 출력 동일성 테스트: 빠른 경로가 기준 구현과 byte 단위로 같은지
+ */
+std::string readTestFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream os;
+    os << file.rdbuf();
+    return os.str();
+}
+
+void testCsvWriterMatchesOstream() {
+    printTestHeader("CsvWriter Output",
+                   "to_chars CsvWriter output must match std::ofstream defaults byte for byte");
+
+    const double doubles[] = {0.0, -0.0, 1.0, -1.5, 0.1, 1e-7, 123456.7, 1234567.0, 1e300, -2.5e-300,
+                              std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                              std::numeric_limits<double>::quiet_NaN()};
+    const float floats[] = {0.5f, 0.333333f, 600.0f, -123.456f, 1e-6f, 3.4e38f};
+    const std::int64_t integers[] = {0, -1, 42, std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()};
+    const double fixed_values[] = {0.0, 0.005, 1.005, -2.675, 1700000000000.123, 1e20};
+
+    std::string ofstream_path = (std::filesystem::temp_directory_path() / "syncorder_test_ofstream.csv").string();
+    std::string writer_path = (std::filesystem::temp_directory_path() / "syncorder_test_writer.csv").string();
+
+    {
+        std::ofstream csv(ofstream_path);
+        for (double v : doubles) csv << v << ",";
+        for (float v : floats) csv << v << ",";
+        for (std::int64_t v : integers) csv << v << ",";
+        csv << static_cast<std::uint16_t>(65535) << "," << static_cast<int>(static_cast<std::uint8_t>(200)) << "," << true << "," << false << "\n";
+        csv << std::fixed;
+        for (double v : fixed_values) csv << std::setprecision(2) << v << "," << std::setprecision(0) << v << "," << std::setprecision(6) << v << "\n";
+    }
+    {
+        CsvWriter csv;
+        csv.open(writer_path);
+        for (double v : doubles) csv.floating(v).put(',');
+        for (float v : floats) csv.floating(v).put(',');
+        for (std::int64_t v : integers) csv.integer(v).put(',');
+        csv.integer(static_cast<std::uint16_t>(65535)).put(',').integer(static_cast<std::uint8_t>(200)).put(',').integer(true).put(',').integer(false).put('\n');
+        for (double v : fixed_values) csv.fixed(v, 2).put(',').fixed(v, 0).put(',').fixed(v, 6).put('\n');
+        csv.close();
+    }
+
+    std::string expected = readTestFile(ofstream_path);
+    std::string actual = readTestFile(writer_path);
+    std::remove(ofstream_path.c_str());
+    std::remove(writer_path.c_str());
+
+    bool identical = !expected.empty() && expected == actual;
+    std::cout << "  ofstream:  " << expected.size() << " bytes\n";
+    std::cout << "  CsvWriter: " << actual.size() << " bytes\n";
+    std::cout << "  identical: " << (identical ? "yes" : "NO") << "\n";
+    if (!identical) std::cout << "  expected:\n" << expected << "  actual:\n" << actual;
+
+    printTestResult(identical, "floating / fixed / integer formatting matches operator<<");
+}
+
+void testSimdKernelsMatchScalar() {
+    printTestHeader("SIMD Kernels",
+                   "Depth colorize, DepthAnalysis and ColorAnalysis must equal the scalar result at every SIMD level");
+
+    std::cout << "  CPU SIMD level: " << simdLevelName(simdLevel()) << "\n";
+
+    // 벡터 폭으로 나누어 떨어지지 않는 크기도 포함 (tail 처리)
+    const std::pair<int, int> sizes[] = {{1, 1}, {7, 3}, {67, 13}, {640, 480}};
+    const SimdLevel levels[] = {SimdLevel::SSE2, SimdLevel::SSE41, SimdLevel::AVX2};
+
+    bool all_passed = true;
+    for (const auto& size : sizes) {
+        std::size_t pixels = static_cast<std::size_t>(size.first) * size.second;
+
+        std::mt19937 rng(static_cast<unsigned>(pixels));
+        std::vector<std::uint16_t> depth(pixels);
+        for (auto& v : depth) v = static_cast<std::uint16_t>(rng() % 8 == 0 ? 0 : rng() % 65536);
+        std::vector<std::uint8_t> color(pixels * 3);
+        for (auto& v : color) v = static_cast<std::uint8_t>(rng());
+
+        std::vector<std::uint8_t> rgb_reference(pixels * 3);
+        colorizeDepth(depth.data(), rgb_reference.data(), pixels, SimdLevel::SCALAR);
+        DepthAnalysis depth_reference = analyzeDepth(depth.data(), size.first, size.second, SimdLevel::SCALAR);
+        ColorAnalysis color_reference = analyzeColor(color.data(), size.first, size.second, true, SimdLevel::SCALAR);
+
+        for (SimdLevel level : levels) {
+            if (level > simdLevel()) continue;
+
+            std::vector<std::uint8_t> rgb(pixels * 3);
+            colorizeDepth(depth.data(), rgb.data(), pixels, level);
+            bool colorize_ok = rgb == rgb_reference;
+
+            DepthAnalysis d = analyzeDepth(depth.data(), size.first, size.second, level);
+            bool depth_ok = d.center_depth == depth_reference.center_depth && d.valid_pixel_ratio == depth_reference.valid_pixel_ratio &&
+                            d.min_depth == depth_reference.min_depth && d.max_depth == depth_reference.max_depth &&
+                            d.avg_depth == depth_reference.avg_depth;
+
+            ColorAnalysis c = analyzeColor(color.data(), size.first, size.second, true, level);
+            bool color_ok = c.center_r == color_reference.center_r && c.center_g == color_reference.center_g &&
+                            c.center_b == color_reference.center_b && c.avg_brightness == color_reference.avg_brightness &&
+                            c.mean_r == color_reference.mean_r && c.mean_g == color_reference.mean_g && c.mean_b == color_reference.mean_b &&
+                            c.has_histogram == color_reference.has_histogram &&
+                            std::equal(std::begin(c.histogram), std::end(c.histogram), std::begin(color_reference.histogram)) &&
+                            c.dark_ratio == color_reference.dark_ratio && c.bright_ratio == color_reference.bright_ratio;
+
+            std::cout << "  " << std::left << std::setw(10) << (std::to_string(size.first) + "x" + std::to_string(size.second))
+                      << std::setw(8) << simdLevelName(level)
+                      << "colorize " << (colorize_ok ? "yes" : "NO")
+                      << ", depth " << (depth_ok ? "yes" : "NO")
+                      << ", color " << (color_ok ? "yes" : "NO") << "\n";
+            all_passed &= colorize_ok && depth_ok && color_ok;
+        }
+    }
+
+    printTestResult(all_passed, "every SIMD level identical to scalar (levels above the CPU's are skipped)");
+}
+
+void testRvlRoundTrip() {
+    printTestHeader("RVL Round Trip",
+                   "Lossless depth codec: decode(encode(frame)) == frame for holes, full-range noise and odd sizes");
+
+    struct Case {
+        const char* name;
+        int width;
+        int height;
+        std::function<std::uint16_t(int, int, std::mt19937&)> pixel;
+    };
+
+    const Case cases[] = {
+        {"all zero", 64, 48, [](int, int, std::mt19937&) { return std::uint16_t(0); }},
+        {"no holes", 64, 48, [](int x, int y, std::mt19937&) { return static_cast<std::uint16_t>(1000 + x + y); }},
+        {"full range", 61, 37, [](int, int, std::mt19937& rng) { return static_cast<std::uint16_t>(rng()); }},
+        {"max jumps", 33, 5, [](int x, int, std::mt19937&) { return static_cast<std::uint16_t>(x % 2 ? 65535 : 1); }},
+        {"scene", 640, 480, [](int x, int y, std::mt19937& rng) {
+            bool hole = ((x / 8 + y / 8 * 7) % 10) == 0;
+            int base = y > 240 ? 900 + (480 - y) * 12 : 3200 + x / 4;
+            return hole ? std::uint16_t(0) : static_cast<std::uint16_t>(base + static_cast<int>(rng() % 5) - 2);
+        }},
+        {"single pixel", 1, 1, [](int, int, std::mt19937&) { return std::uint16_t(4321); }},
+    };
+
+    bool all_passed = true;
+    for (const auto& c : cases) {
+        std::mt19937 rng(23);
+        std::vector<std::uint16_t> frame(static_cast<std::size_t>(c.width) * c.height);
+        for (int y = 0; y < c.height; ++y) {
+            for (int x = 0; x < c.width; ++x) frame[static_cast<std::size_t>(y) * c.width + x] = c.pixel(x, y, rng);
+        }
+
+        std::vector<std::uint8_t> encoded;
+        std::size_t size = rvlEncodeFrame(frame.data(), c.width, c.height, 0.001f, encoded);
+
+        RvlHeader header;
+        std::vector<std::uint16_t> decoded;
+        bool decoded_ok = rvlDecodeFrame(encoded.data(), size, header, decoded);
+        bool identical = decoded_ok && decoded == frame && header.width == c.width && header.height == c.height &&
+                         header.depth_units == 0.001f && size <= sizeof(RvlHeader) + rvlBound(frame.size());
+
+        std::cout << "  " << std::left << std::setw(14) << c.name
+                  << std::right << std::setw(10) << frame.size() * 2 << " -> " << std::setw(8) << size << " bytes, "
+                  << "round trip " << (identical ? "identical" : "MISMATCH") << "\n";
+        all_passed &= identical;
+    }
+
+    printTestResult(all_passed, "bit exact round trip, encoded size within rvlBound");
+}
+
+/**
+ * 스키마 호환 테스트: v1 레코드 파일을 v2 reader로 읽기 (뒤에 추가된 필드는 0)
+ */
+#pragma pack(push, 1)
+
+struct TestRecordV1 {
+    static constexpr std::uint16_t VERSION = 1;
+    static constexpr const char* STREAM = "test";
+
+    std::int64_t device_time;
+    float value;
+    std::uint8_t valid;
+
+    static std::vector<RecordField> schema() {
+        return {
+            recordField("device_time", FieldType::I64, offsetof(TestRecordV1, device_time)),
+            recordField("value", FieldType::F32, offsetof(TestRecordV1, value)),
+            recordField("valid", FieldType::BOOL, offsetof(TestRecordV1, valid)),
+        };
+    }
+};
+
+struct TestRecordV2 {
+    static constexpr std::uint16_t VERSION = 2;
+    static constexpr const char* STREAM = "test";
+
+    std::int64_t device_time;
+    float value;
+    std::uint8_t valid;
+    std::int64_t host_time_ns;
+
+    static std::vector<RecordField> schema() {
+        return {
+            recordField("device_time", FieldType::I64, offsetof(TestRecordV2, device_time)),
+            recordField("value", FieldType::F32, offsetof(TestRecordV2, value)),
+            recordField("valid", FieldType::BOOL, offsetof(TestRecordV2, valid)),
+            recordField("host_time_ns", FieldType::I64, offsetof(TestRecordV2, host_time_ns)),
+        };
+    }
+};
+
+#pragma pack(pop)
+
+void testRecordLogReadsOlderSchema() {
+    printTestHeader("Record Log Schema Upgrade",
+                   "A v2 reader decodes v1 files through their field table; fields v1 lacks read as 0");
+
+    const std::size_t count = 5000;
+    std::string v1_path = (std::filesystem::temp_directory_path() / "syncorder_test_v1.rec").string();
+    std::string v2_path = (std::filesystem::temp_directory_path() / "syncorder_test_v2.rec").string();
+
+    {
+        RecordLog<TestRecordV1> log;
+        log.open(v1_path);
+        for (std::size_t i = 0; i < count; ++i) {
+            TestRecordV1 record = {static_cast<std::int64_t>(i) * 1000, 0.5f * i, static_cast<std::uint8_t>(i % 2)};
+            log.append(record);
+        }
+    }
+    {
+        RecordLog<TestRecordV2> log;
+        log.open(v2_path);
+        TestRecordV2 record = {7, 1.5f, 1, 123456789};
+        log.append(record);
+    }
+
+    RecordLogReader<TestRecordV2> reader;
+    std::string v1_error = reader.open(v1_path);
+    std::vector<TestRecordV2> records(count + 1);
+    std::size_t read = 0;
+    while (std::size_t n = reader.read_n(records.data() + read, 1024)) read += n;
+
+    bool v1_ok = v1_error.empty() && read == count && reader.fields().size() == 3;
+    for (std::size_t i = 0; v1_ok && i < count; ++i) {
+        v1_ok = records[i].device_time == static_cast<std::int64_t>(i) * 1000 && records[i].value == 0.5f * i &&
+                records[i].valid == i % 2 && records[i].host_time_ns == 0;
+    }
+
+    std::string v2_error = reader.open(v2_path);
+    TestRecordV2 current = {};
+    bool v2_ok = v2_error.empty() && reader.read_n(&current, 1) == 1 &&
+                 current.device_time == 7 && current.value == 1.5f && current.valid == 1 && current.host_time_ns == 123456789;
+
+    // v1 reader는 v2 파일을 거부해야 함
+    RecordLogReader<TestRecordV1> old_reader;
+    std::string newer_error = old_reader.open(v2_path);
+    reader.close();
+    old_reader.close();
+    std::remove(v1_path.c_str());
+    std::remove(v2_path.c_str());
+
+    std::cout << "  v1 file:    " << (v1_error.empty() ? "opened" : v1_error) << ", " << read << " records decoded\n";
+    std::cout << "  v2 file:    " << (v2_error.empty() ? "opened" : v2_error) << "\n";
+    std::cout << "  v1 reader:  " << (newer_error.empty() ? "accepted v2 file" : newer_error) << "\n";
+
+    printTestResult(v1_ok && v2_ok && !newer_error.empty(), "old files upgrade field by field, newer files are rejected");
+}
+
 /**
  * Main Test Runner
  */
@@ -377,6 +925,15 @@ int main() {
         testExtremeTiming();
         testMultiDeviceConcurrency();
         testPreciseSynchronization();
+        testHungDeviceTimeout();
+        testOverflowRejectNewest();
+        testOverflowOverwriteOldest();
+        testOverflowBlock();
+        testOverflowSpill();
+        testCsvWriterMatchesOstream();
+        testSimdKernelsMatchScalar();
+        testRvlRoundTrip();
+        testRecordLogReadsOlderSchema();
         
         std::cout << "\n===========================================\n";
         std::cout << "TEST SUITE COMPLETED\n";
@@ -385,11 +942,12 @@ int main() {
         std::cout << "            by waiting for the slowest device at each phase\n";
         std::cout << "            before proceeding to the next phase.\n";
         std::cout << "===========================================\n";
+        if (failed_tests) std::cout << "FAILED TESTS: " << failed_tests << "\n";
         
     } catch (const std::exception& e) {
         std::cout << "\nFATAL ERROR: " << e.what() << "\n";
         return -1;
     }
     
-    return 0;
+    return failed_tests == 0 ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// local
+#include <Syncorder/devices/common/container.h>
+
+
+/**
+ * @main container_dump - list the channels / chunks of a session.scap and
+ * print the messages of a time range
+ *
+ * usage: container_dump <session.scap> [--from ns] [--to ns] [--messages]
+ */
+
+int main(int argc, char* argv[]) {
+    std::string input;
+    std::int64_t from = INT64_MIN;
+    std::int64_t to = INT64_MAX;
+    bool messages = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (false) {
+            // ...
+        }
+        else if (arg == "--from" && i + 1 < argc) {
+            from = std::stoll(argv[++i]);
+        }
+        else if (arg == "--to" && i + 1 < argc) {
+            to = std::stoll(argv[++i]);
+        }
+        else if (arg == "--messages") {
+            messages = true;
+        }
+        else if (input.empty()) {
+            input = arg;
+        }
+    }
+
+    if (input.empty()) {
+        std::cout << "Usage: container_dump <session.scap> [--from ns] [--to ns] [--messages]\n";
+        return 1;
+    }
+
+    // open
+    ContainerReader reader;
+    std::string error = reader.open(input);
+    if (!error.empty()) {
+        std::cout << "[Error] " << input << ": " << error << "\n";
+        return 1;
+    }
+
+    // channels
+    std::cout << "[container_dump] " << input << "\n";
+    for (const auto& channel : reader.channels()) {
+        std::cout << "  channel " << channel.info.id << ": " << channel.info.stream
+                  << " v" << channel.info.schema_version
+                  << ", " << channel.info.record_size << " bytes, " << channel.info.field_count << " fields\n";
+    }
+
+    // chunks
+    const auto& chunks = reader.chunks();
+    std::uint64_t total_messages = 0;
+    std::uint64_t stored = 0;
+    std::int64_t last = INT64_MIN;
+    for (const auto& chunk : chunks) {
+        total_messages += chunk.message_count;
+        stored += chunk.length;
+        if (chunk.end_time > last) last = chunk.end_time;
+    }
+    std::cout << "  " << chunks.size() << " chunks, " << total_messages << " messages, " << stored << " bytes";
+    if (!chunks.empty()) std::cout << ", time " << chunks.front().start_time << " .. " << last;
+    std::cout << "\n";
+
+    if (!messages) return 0;
+
+    // messages
+    std::uint64_t printed = 0;
+    std::cout << "time_ns,stream,size\n";
+    bool ok = reader.forEachMessage(from, to, [&](const MessageHeader& message, const char*) {
+        const char* stream = message.channel < reader.channels().size() ? reader.channels()[message.channel].info.stream : "?";
+        std::cout << message.time << "," << stream << "," << message.size << "\n";
+        ++printed;
+    });
+
+    if (!ok) {
+        std::cout << "[Error] corrupt chunk after " << printed << " messages\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,14 @@
+@echo off
+call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvars64.bat"
+
+cl ^
+  /std:c++17 ^
+  /EHsc ^
+  /W3 ^
+  /O2 ^
+  /D_CRT_SECURE_NO_WARNINGS ^
+  /wd4819 ^
+  /I . ^
+  /I "C:\Users\user\Workspace\Intel RealSense SDK 2.0\third-party" ^
+  tools/frame_convert/frame_convert.cpp ^
+  /Fe:bin/frame_convert.exe
\ No newline at end of file
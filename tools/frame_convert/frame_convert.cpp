@@ -0,0 +1,362 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+#include <filesystem>
+
+// local
+#include <Syncorder/devices/realsense/colorize.h>
+#include <Syncorder/devices/realsense/rvl.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+
+/**
+ * @main frame_convert - RealSense raw frames (RGB24 / Z16) to PNG
+ *
+ * Native replacement for scripts/ops/convert.bat: same CSV columns, same
+ * resolution guess from the file size, same depth mapping (200..10000 mm ->
+ * turbo), same PNG compression level - but in-process, SIMD for the depth
+ * colormap and one PNG encoder per worker thread instead of two ffmpeg
+ * launches per frame.
+ *
+ * Depth frames stored as RVL (depth/depth_<frame>.rvl, gonfig.depth_workers)
+ * are decoded in place of a missing .raw; given a directory instead of a CSV,
+ * every .rvl under it is converted to the .png beside it.
+ *
+ * usage: frame_convert <realsense_data.csv | rvl directory> [--threads n] [--fps f]
+ *
+ * Exits non-zero on bad arguments, when any frame fails or when nothing was
+ * converted, like the per-frame ffmpeg errorlevel checks did.
+ */
+
+/**
+ * @helper: resolution / job
+ */
+
+struct Resolution {
+    std::uintmax_t bytes;
+    int width;
+    int height;
+};
+
+// by raw file size, first match wins; anything else is tried as 640x480
+static const Resolution COLOR_SIZES[] = {
+    {2764800, 1280, 720},
+    {6220800, 1920, 1080},
+    {921600, 640, 480},
+};
+
+static const Resolution DEPTH_SIZES[] = {
+    {814080, 848, 480},
+    {1843200, 1280, 720},
+    {614400, 640, 480},
+};
+
+constexpr int DEFAULT_WIDTH = 640;
+constexpr int DEFAULT_HEIGHT = 480;
+
+enum class FrameKind { COLOR, DEPTH };
+
+struct Job {
+    std::string frame;
+    std::string png;       // relative to the session directory, as written in the CSV
+    FrameKind kind;
+};
+
+struct Stats {
+    std::atomic<std::uint64_t> converted{0};
+    std::atomic<std::uint64_t> failed{0};
+};
+
+
+/**
+ * @helper: functions
+ */
+
+static std::mutex console_mutex;
+
+static void report(const std::string& line) {
+    std::lock_guard<std::mutex> lock(console_mutex);
+    std::cout << line << "\n";
+}
+
+static void printUsage() {
+    std::cout << "Usage: frame_convert <realsense_data.csv | rvl directory> [--threads n] [--fps f]\n";
+}
+
+/**
+ * whole-string numbers only; false leaves value untouched
+ */
+static bool parseUnsigned(const char* text, unsigned& value) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long parsed = std::strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || text[0] == '-' || parsed > UINT_MAX) return false;
+    value = static_cast<unsigned>(parsed);
+    return true;
+}
+
+static bool parseDouble(const char* text, double& value) {
+    char* end = nullptr;
+    errno = 0;
+    double parsed = std::strtod(text, &end);
+    if (end == text || *end != '\0' || errno != 0 || !std::isfinite(parsed)) return false;
+    value = parsed;
+    return true;
+}
+
+/**
+ * split on ',' and drop empty fields - what "for /f delims=," did
+ */
+static std::vector<std::string> tokenize(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::size_t start = 0;
+    while (start <= line.size()) {
+        std::size_t comma = line.find(',', start);
+        if (comma == std::string::npos) comma = line.size();
+        if (comma > start) tokens.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return tokens;
+}
+
+static bool isYes(const std::string& value) {
+    if (value.size() != 3) return false;
+    return (value[0] | 0x20) == 'y' && (value[1] | 0x20) == 'e' && (value[2] | 0x20) == 's';
+}
+
+static std::string rawPath(std::string png, const char* extension = ".raw") {
+    for (std::size_t at = png.find(".png"); at != std::string::npos; at = png.find(".png", at + 4)) {
+        png.replace(at, 4, extension);
+    }
+    return png;
+}
+
+static Resolution guess(FrameKind kind, std::uintmax_t bytes) {
+    const Resolution* table = kind == FrameKind::COLOR ? COLOR_SIZES : DEPTH_SIZES;
+    for (int i = 0; i < 3; ++i) {
+        if (table[i].bytes == bytes) return table[i];
+    }
+    return {bytes, DEFAULT_WIDTH, DEFAULT_HEIGHT};
+}
+
+static bool readFile(const std::filesystem::path& path, std::vector<std::uint8_t>& out) {
+    std::FILE* file = std::fopen(path.string().c_str(), "rb");
+    if (!file) return false;
+
+    std::error_code ec;
+    std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        std::fclose(file);
+        return false;
+    }
+
+    out.resize(static_cast<std::size_t>(size));
+    bool ok = std::fread(out.data(), 1, out.size(), file) == out.size();
+    std::fclose(file);
+    return ok;
+}
+
+/**
+ * one frame: read raw (or decode RVL), colorize depth, encode PNG; buffers are per worker
+ */
+static bool convert(const Job& job, const std::filesystem::path& session, std::vector<std::uint8_t>& raw, std::vector<std::uint16_t>& depth, std::vector<std::uint8_t>& rgb) {
+    std::filesystem::path raw_path = session / rawPath(job.png);
+    std::filesystem::path png_path = session / job.png;
+
+    std::error_code ec;
+    bool rvl = false;
+    if (!std::filesystem::exists(raw_path, ec) && job.kind == FrameKind::DEPTH) {
+        std::filesystem::path rvl_path = session / rawPath(job.png, ".rvl");
+        if (std::filesystem::exists(rvl_path, ec)) {
+            raw_path = rvl_path;
+            rvl = true;
+        }
+    }
+    if (!std::filesystem::exists(raw_path, ec)) {
+        report("Warning: Raw file not found: " + raw_path.string());
+        return false;
+    }
+    if (!readFile(raw_path, raw)) {
+        report("Failed to read: " + raw_path.string());
+        return false;
+    }
+
+    Resolution res;
+    const std::uint8_t* image = raw.data();
+
+    if (rvl) {
+        RvlHeader header;
+        if (!rvlDecodeFrame(raw.data(), raw.size(), header, depth)) {
+            report("Failed: " + job.png + " (corrupt RVL frame)");
+            return false;
+        }
+        res = {raw.size(), header.width, header.height};
+    } else {
+        res = guess(job.kind, raw.size());
+        std::size_t needed = static_cast<std::size_t>(res.width) * res.height * (job.kind == FrameKind::COLOR ? 3 : 2);
+        if (raw.size() < needed) {
+            report("Failed: " + job.png + " (" + std::to_string(raw.size()) + " bytes, not a known frame size)");
+            return false;
+        }
+    }
+
+    std::size_t pixels = static_cast<std::size_t>(res.width) * res.height;
+    if (job.kind == FrameKind::DEPTH) {
+        rgb.resize(pixels * 3);
+        colorizeDepth(rvl ? depth.data() : reinterpret_cast<const std::uint16_t*>(raw.data()), rgb.data(), pixels);
+        image = rgb.data();
+    }
+
+    if (png_path.has_parent_path()) std::filesystem::create_directories(png_path.parent_path(), ec);
+    if (!stbi_write_png(png_path.string().c_str(), res.width, res.height, 3, image, res.width * 3)) {
+        report("Failed: " + job.png);
+        return false;
+    }
+
+    return true;
+}
+
+
+int main(int argc, char* argv[]) {
+    std::string input;
+    unsigned threads = std::thread::hardware_concurrency();
+    double fps = 30.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (false) {
+            // ...
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            if (!parseUnsigned(argv[++i], threads)) {
+                std::cout << "[Error] invalid --threads value: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--fps" && i + 1 < argc) {
+            if (!parseDouble(argv[++i], fps)) {
+                std::cout << "[Error] invalid --fps value: " << argv[i] << "\n";
+                printUsage();
+                return 1;
+            }
+        }
+        else if (input.empty()) {
+            input = arg;
+        }
+    }
+
+    if (input.empty()) {
+        printUsage();
+        return 1;
+    }
+    if (threads == 0) threads = 1;
+
+    std::error_code ec;
+    bool directory = std::filesystem::is_directory(input, ec);
+
+    std::ifstream csv;
+    if (!directory) {
+        csv.open(input);
+        if (!csv) {
+            std::cout << "[Error] CSV file not found: " << input << "\n";
+            return 1;
+        }
+    }
+
+    std::filesystem::path session = directory ? std::filesystem::path(input) : std::filesystem::path(input).parent_path();
+    std::cout << "Processing RealSense data from: " << input << "\n";
+    std::cout << "Session directory: " << session.string() << "\n";
+    std::cout << "Workers: " << threads << " (" << simdLevelName(simdLevel()) << ")\n\n";
+
+    // columns 1, 13-16: frame, HasColor, HasDepth, color png, depth png
+    std::vector<Job> jobs;
+    std::uint64_t frames = 0;
+    std::uint64_t color_count = 0;
+    std::uint64_t depth_count = 0;
+
+    // directory: every .rvl, png beside it
+    if (directory) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(session, ec)) {
+            if (!entry.is_regular_file() || entry.path().extension() != ".rvl") continue;
+
+            std::filesystem::path png = std::filesystem::relative(entry.path(), session, ec).replace_extension(".png");
+            jobs.push_back({entry.path().stem().string(), png.generic_string(), FrameKind::DEPTH});
+            ++depth_count;
+            ++frames;
+        }
+    }
+
+    std::string line;
+    if (!directory) std::getline(csv, line);
+    while (!directory && std::getline(csv, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        std::vector<std::string> tokens = tokenize(line);
+        if (tokens.empty()) continue;
+        tokens.resize(tokens.size() < 16 ? 16 : tokens.size());
+
+        bool any = false;
+        if (isYes(tokens[12]) && !tokens[14].empty()) {
+            jobs.push_back({tokens[0], tokens[14], FrameKind::COLOR});
+            ++color_count;
+            any = true;
+        }
+        if (isYes(tokens[13]) && !tokens[15].empty()) {
+            jobs.push_back({tokens[0], tokens[15], FrameKind::DEPTH});
+            ++depth_count;
+            any = true;
+        }
+        if (any) ++frames;
+    }
+
+    // convert
+    stbi_write_png_compression_level = 1;
+
+    Stats stats;
+    std::atomic<std::size_t> next{0};
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < threads; ++w) {
+        workers.emplace_back([&] {
+            std::vector<std::uint8_t> raw;
+            std::vector<std::uint16_t> depth;
+            std::vector<std::uint8_t> rgb;
+
+            for (std::size_t i = next++; i < jobs.size(); i = next++) {
+                if (convert(jobs[i], session, raw, depth, rgb)) ++stats.converted;
+                else ++stats.failed;
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double rate = seconds > 0.0 ? frames / seconds : 0.0;
+
+    std::cout << "\n";
+    std::cout << "===== CONVERSION SUMMARY =====\n";
+    std::cout << "Color frames processed: " << color_count << "\n";
+    std::cout << "Depth frames processed: " << depth_count << "\n";
+    std::cout << "Total converted: " << stats.converted << "\n";
+    std::cout << "Total failed: " << stats.failed << "\n";
+    std::cout << "Elapsed: " << seconds << " s (" << rate << " frames/s, "
+              << (fps > 0.0 ? rate / fps : 0.0) << "x real time at " << fps << " fps)\n";
+    std::cout << "==============================\n";
+    return stats.failed == 0 && stats.converted > 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <filesystem>
+
+// local
+#include <Syncorder/devices/tobii/record.h>
+#include <Syncorder/devices/tobii/csv.h>
+
+
+/**
+ * @main tobii_export - regenerate tobii_data.csv from a binary tobii_data.rec
+ *
+ * usage: tobii_export <tobii_data.rec> [out.csv] [--schema]
+ */
+
+int main(int argc, char* argv[]) {
+    std::string input;
+    std::string output;
+    bool print_schema = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (false) {
+            // ...
+        }
+        else if (arg == "--schema") {
+            print_schema = true;
+        }
+        else if (input.empty()) {
+            input = arg;
+        }
+        else if (output.empty()) {
+            output = arg;
+        }
+    }
+
+    if (input.empty()) {
+        std::cout << "Usage: tobii_export <tobii_data.rec> [out.csv] [--schema]\n";
+        return 1;
+    }
+    if (output.empty()) output = std::filesystem::path(input).replace_extension(".csv").string();
+
+    // open
+    RecordLogReader<TobiiRecord> reader;
+    std::string error = reader.open(input);
+    if (!error.empty()) {
+        std::cout << "[Error] " << input << ": " << error << "\n";
+        return 1;
+    }
+
+    const RecordLogHeader& header = reader.header();
+    std::cout << "[tobii_export] " << input << ": schema v" << header.schema_version
+              << ", " << header.record_count << " records of " << header.record_size << " bytes\n";
+
+    if (print_schema) {
+        for (const auto& field : reader.fields()) {
+            std::cout << "  " << field.offset << "\t" << static_cast<int>(field.type) << "\t" << field.name << "\n";
+        }
+    }
+
+    // export
+    CsvWriter csv;
+    if (!csv.open(output)) {
+        std::cout << "[Error] cannot open " << output << "\n";
+        return 1;
+    }
+    writeTobiiCsvHeader(csv);
+    csv.flush();
+
+    std::vector<TobiiRecord> records(4096);
+    std::uint64_t exported = 0;
+    while (std::size_t count = reader.read_n(records.data(), records.size())) {
+        for (std::size_t i = 0; i < count; ++i) writeTobiiCsvRow(csv, fromTobiiRecord(records[i]));
+        csv.flush();
+        exported += count;
+    }
+
+    std::cout << "[tobii_export] " << exported << " rows -> " << output << "\n";
+    return exported == header.record_count ? 0 : 1;
+}